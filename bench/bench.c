@@ -0,0 +1,299 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#endif
+
+#define BENCH_MAX_BASELINE 1024
+#define BENCH_NAME_MAX     96
+
+volatile uint64_t bench_sink;
+
+typedef struct {
+    char   name[BENCH_NAME_MAX];
+    double ns_per_op;
+} bench_baseline_entry;
+
+struct bench_state {
+    const char *filter;
+    double      target_ns;   /* minimum duration of one sample */
+    int         samples;
+
+    FILE       *out;
+    int         records;
+
+    bench_baseline_entry *baseline;
+    size_t      nbaseline;
+    double      threshold;   /* regression threshold in percent */
+    int         regressions;
+};
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t bench_ticks(void)
+{
+#ifdef BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static const bench_baseline_entry *bench_find_baseline(const bench_state *b,
+                                                       const char *name)
+{
+    for (size_t i = 0; i < b->nbaseline; ++i) {
+        if (strcmp(b->baseline[i].name, name) == 0) {
+            return &b->baseline[i];
+        }
+    }
+    return NULL;
+}
+
+void bench_run(bench_state *b,
+               const char *name,
+               size_t bytes,
+               bench_fn fn,
+               void *arg)
+{
+    double   ns[16];
+    double   ticks_per_op = 0.0;
+    uint64_t iters = 1;
+
+    if (b->filter != NULL && strstr(name, b->filter) == NULL) {
+        return;
+    }
+
+    /* Calibrate (doubles as warm-up). */
+    for (;;) {
+        uint64_t t0 = bench_now_ns();
+        fn(arg, iters);
+        uint64_t elapsed = bench_now_ns() - t0;
+
+        if ((double)elapsed >= b->target_ns) {
+            break;
+        }
+        double scale = elapsed ? 1.2 * b->target_ns / (double)elapsed : 10.0;
+        if (scale > 10.0) {
+            scale = 10.0;
+        }
+        if (scale < 2.0) {
+            scale = 2.0;
+        }
+        iters = (uint64_t)((double)iters * scale);
+    }
+
+    for (int s = 0; s < b->samples; ++s) {
+        uint64_t c0 = bench_ticks();
+        uint64_t t0 = bench_now_ns();
+        fn(arg, iters);
+        uint64_t t1 = bench_now_ns();
+        uint64_t c1 = bench_ticks();
+
+        ns[s] = (double)(t1 - t0) / (double)iters;
+        double tpo = (double)(c1 - c0) / (double)iters;
+        if (s == 0 || tpo < ticks_per_op) {
+            ticks_per_op = tpo;
+        }
+    }
+
+    qsort(ns, (size_t)b->samples, sizeof(ns[0]), bench_cmp_double);
+    double best   = ns[0];
+    double median = ns[b->samples / 2];
+
+    fprintf(b->out, "%s    {\"name\": \"%s\", \"bytes\": %zu, \"iters\": %llu, "
+            "\"ns_per_op\": %.3f, \"ns_per_op_median\": %.3f",
+            b->records ? ",\n" : "", name, bytes,
+            (unsigned long long)iters, best, median);
+
+#ifdef BENCH_HAVE_TSC
+    fprintf(b->out, ", \"cycles_per_op\": %.1f", ticks_per_op);
+    if (bytes) {
+        fprintf(b->out, ", \"cycles_per_byte\": %.3f", ticks_per_op / (double)bytes);
+    }
+#endif
+    if (bytes) {
+        fprintf(b->out, ", \"mb_per_s\": %.1f", (double)bytes * 1e3 / best);
+    }
+
+    fprintf(stderr, "%-40s %12.1f ns/op", name, best);
+    if (bytes) {
+        fprintf(stderr, " %9.1f MB/s", (double)bytes * 1e3 / best);
+    }
+
+    const bench_baseline_entry *base = bench_find_baseline(b, name);
+    if (base != NULL && base->ns_per_op > 0.0) {
+        double delta = (best - base->ns_per_op) * 100.0 / base->ns_per_op;
+        int    regressed = delta > b->threshold;
+
+        fprintf(b->out, ", \"baseline_ns_per_op\": %.3f, \"delta_pct\": %.2f, "
+                "\"regression\": %s", base->ns_per_op, delta,
+                regressed ? "true" : "false");
+        fprintf(stderr, " %+8.1f%%%s", delta, regressed ? "  REGRESSION" : "");
+        b->regressions += regressed;
+    }
+
+    fprintf(b->out, "}");
+    fprintf(stderr, "\n");
+    b->records++;
+}
+
+/*
+ * Load a baseline written by this program. Every record sits on its own
+ * line, so a line-oriented scan is enough; no general JSON parser needed.
+ */
+static int bench_load_baseline(bench_state *b, const char *path)
+{
+    char  line[1024];
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL) {
+        fprintf(stderr, "web3c_bench: cannot open baseline %s\n", path);
+        return -1;
+    }
+
+    b->baseline = calloc(BENCH_MAX_BASELINE, sizeof(*b->baseline));
+    if (b->baseline == NULL) {
+        fclose(f);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL &&
+           b->nbaseline < BENCH_MAX_BASELINE) {
+        const char *name = strstr(line, "\"name\": \"");
+        const char *ns   = strstr(line, "\"ns_per_op\": ");
+        if (name == NULL || ns == NULL) {
+            continue;
+        }
+
+        name += strlen("\"name\": \"");
+        const char *end = strchr(name, '"');
+        if (end == NULL || (size_t)(end - name) >= BENCH_NAME_MAX) {
+            continue;
+        }
+
+        bench_baseline_entry *e = &b->baseline[b->nbaseline++];
+        memcpy(e->name, name, (size_t)(end - name));
+        e->name[end - name] = '\0';
+        e->ns_per_op = strtod(ns + strlen("\"ns_per_op\": "), NULL);
+    }
+
+    fclose(f);
+    return 0;
+}
+
+static void bench_write_header(bench_state *b)
+{
+    fprintf(b->out, "{\n  \"schema\": 1,\n");
+#ifdef __VERSION__
+    fprintf(b->out, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+#ifdef BENCH_HAVE_TSC
+    __builtin_cpu_init();
+    fprintf(b->out, "  \"cpu\": {\"avx2\": %s, \"avx512f\": %s},\n",
+            __builtin_cpu_supports("avx2") ? "true" : "false",
+            __builtin_cpu_supports("avx512f") ? "true" : "false");
+    fprintf(b->out, "  \"cycles\": \"tsc\",\n");
+#endif
+    fprintf(b->out, "  \"sample_ns\": %.0f,\n  \"samples\": %d,\n",
+            b->target_ns, b->samples);
+    fprintf(b->out, "  \"results\": [\n");
+}
+
+static void bench_usage(void)
+{
+    fprintf(stderr,
+            "usage: web3c_bench [--filter SUBSTR] [--quick] [--out FILE]\n"
+            "                   [--baseline FILE] [--threshold PCT]\n");
+}
+
+int main(int argc, char **argv)
+{
+    bench_state b;
+    const char *out_path      = NULL;
+    const char *baseline_path = NULL;
+
+    memset(&b, 0, sizeof(b));
+    b.target_ns = 20e6;
+    b.samples   = 7;
+    b.threshold = 5.0;
+    b.out       = stdout;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            b.target_ns = 1e6;
+            b.samples   = 3;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            b.filter = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            b.threshold = strtod(argv[++i], NULL);
+        } else {
+            bench_usage();
+            return 2;
+        }
+    }
+
+    if (baseline_path != NULL && bench_load_baseline(&b, baseline_path) != 0) {
+        return 2;
+    }
+    if (out_path != NULL) {
+        b.out = fopen(out_path, "w");
+        if (b.out == NULL) {
+            fprintf(stderr, "web3c_bench: cannot write %s\n", out_path);
+            return 2;
+        }
+    }
+
+    bench_write_header(&b);
+
+    bench_keccak(&b);
+    bench_hex(&b);
+    bench_rlp(&b);
+    bench_abi(&b);
+    bench_bloom(&b);
+    bench_storage(&b);
+    bench_address(&b);
+    bench_rpc(&b);
+    bench_secp256k1(&b);
+
+    fprintf(b.out, "\n  ],\n  \"regressions\": %d\n}\n", b.regressions);
+
+    if (b.out != stdout) {
+        fclose(b.out);
+    }
+    free(b.baseline);
+
+    if (b.regressions) {
+        fprintf(stderr, "web3c_bench: %d regression(s) above %.1f%%\n",
+                b.regressions, b.threshold);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef WEB3C_BENCH_H
+#define WEB3C_BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Minimal microbenchmark harness for Web3C.
+ *
+ * A benchmark is a function that runs its operation `iters` times. The
+ * harness calibrates the iteration count so one sample takes at least
+ * the target time, takes several samples and reports the fastest and
+ * the median as one JSON record per benchmark.
+ */
+
+/* Runs the measured operation iters times. */
+typedef void (*bench_fn)(void *arg, uint64_t iters);
+
+typedef struct bench_state bench_state;
+
+/*
+ * Measure one benchmark.
+ *
+ * Parameters:
+ *   b     - harness state.
+ *   name  - unique name, "group/case/size" (used as the baseline key).
+ *   bytes - bytes processed per operation (0 if not meaningful; then
+ *           no cycles/byte figure is reported).
+ *   fn    - operation.
+ *   arg   - passed through to fn.
+ */
+void bench_run(bench_state *b,
+               const char *name,
+               size_t bytes,
+               bench_fn fn,
+               void *arg);
+
+/* Keeps results observable so the compiler cannot drop the work. */
+extern volatile uint64_t bench_sink;
+
+/* Benchmark groups (one per bench_*.c file). */
+void bench_keccak(bench_state *b);
+void bench_hex(bench_state *b);
+void bench_rlp(bench_state *b);
+void bench_abi(bench_state *b);
+void bench_bloom(bench_state *b);
+void bench_storage(bench_state *b);
+void bench_address(bench_state *b);
+void bench_rpc(bench_state *b);
+void bench_secp256k1(bench_state *b);
+
+#endif /* WEB3C_BENCH_H */
@@ -0,0 +1,97 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "web3c/abi.h"
+
+typedef struct {
+    const uint8_t *data;
+    size_t         len;
+    unsigned char  out[2048];
+} bench_abi_arg;
+
+static void run_uint256(void *arg, uint64_t iters)
+{
+    bench_abi_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_abi_encode_uint256(i, a->out);
+        bench_sink += a->out[31];
+    }
+}
+
+static void run_address(void *arg, uint64_t iters)
+{
+    bench_abi_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_abi_encode_address(a->data, a->out);
+        bench_sink += a->out[31];
+    }
+}
+
+static void run_bool(void *arg, uint64_t iters)
+{
+    bench_abi_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_abi_encode_bool((int)(i & 1), a->out);
+        bench_sink += a->out[31];
+    }
+}
+
+static void run_bytes32(void *arg, uint64_t iters)
+{
+    bench_abi_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_abi_encode_bytes32(a->data, a->out);
+        bench_sink += a->out[31];
+    }
+}
+
+static void run_bytes(void *arg, uint64_t iters)
+{
+    bench_abi_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_abi_encode_bytes(a->data, a->len, a->out, sizeof(a->out), &len);
+        bench_sink += len;
+    }
+}
+
+static void run_selector(void *arg, uint64_t iters)
+{
+    bench_abi_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_abi_function_selector("transfer(address,uint256)", a->out);
+        bench_sink += a->out[0];
+    }
+}
+
+void bench_abi(bench_state *b)
+{
+    static uint8_t data[1024];
+    static bench_abi_arg a;
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 11 + 5);
+    }
+    memset(&a, 0, sizeof(a));
+    a.data = data;
+
+    bench_run(b, "abi/uint256", 0, run_uint256, &a);
+    bench_run(b, "abi/address", 0, run_address, &a);
+    bench_run(b, "abi/bool", 0, run_bool, &a);
+    bench_run(b, "abi/bytes32", 0, run_bytes32, &a);
+
+    a.len = 100;
+    bench_run(b, "abi/bytes/100", 100, run_bytes, &a);
+    a.len = 1000;
+    bench_run(b, "abi/bytes/1000", 1000, run_bytes, &a);
+
+    bench_run(b, "abi/function_selector", 0, run_selector, &a);
+}
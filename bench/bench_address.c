@@ -0,0 +1,63 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "web3c/address.h"
+
+#define BENCH_ADDRESS_N 1024
+
+typedef struct {
+    uint8_t addrs[BENCH_ADDRESS_N][20];
+    char    outs[BENCH_ADDRESS_N][WEB3C_ADDRESS_CHECKSUM_SIZE];
+} bench_address_arg;
+
+static void run_single(void *arg, uint64_t iters)
+{
+    bench_address_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        for (size_t k = 0; k < BENCH_ADDRESS_N; ++k) {
+            web3c_address_to_checksum(a->addrs[k], a->outs[k]);
+        }
+        bench_sink += (uint8_t)a->outs[0][2];
+    }
+}
+
+static void run_batch(void *arg, uint64_t iters)
+{
+    bench_address_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_address_to_checksum_batch((const uint8_t (*)[20])a->addrs,
+                                        BENCH_ADDRESS_N, a->outs);
+        bench_sink += (uint8_t)a->outs[0][2];
+    }
+}
+
+static void run_validate(void *arg, uint64_t iters)
+{
+    bench_address_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        bench_sink += (uint64_t)web3c_address_validate_checksum(a->outs[i % BENCH_ADDRESS_N],
+                                                               42, NULL);
+    }
+}
+
+void bench_address(bench_state *b)
+{
+    static bench_address_arg a;
+
+    for (size_t k = 0; k < BENCH_ADDRESS_N; ++k) {
+        for (size_t j = 0; j < 20; ++j) {
+            a.addrs[k][j] = (uint8_t)(k * 31 + j * 7);
+        }
+    }
+    web3c_address_to_checksum_batch((const uint8_t (*)[20])a.addrs,
+                                    BENCH_ADDRESS_N, a.outs);
+
+    bench_run(b, "address/checksum_loop/1024", 0, run_single, &a);
+    bench_run(b, "address/checksum_batch/1024", 0, run_batch, &a);
+    bench_run(b, "address/validate_checksum", 0, run_validate, &a);
+}
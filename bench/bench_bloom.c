@@ -0,0 +1,88 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "web3c/bloom.h"
+
+#define BENCH_BLOOM_ROWS 65536
+
+typedef struct {
+    const uint8_t  *rows;
+    const uint8_t (*masks)[WEB3C_BLOOM_SIZE];
+    size_t          n_masks;
+    uint64_t       *hits;
+} bench_bloom_arg;
+
+static void run_scan(void *arg, uint64_t iters)
+{
+    bench_bloom_arg *a = arg;
+    size_t n_hits = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_bloom_scan(a->rows, BENCH_BLOOM_ROWS, a->masks, a->n_masks,
+                         a->hits, &n_hits);
+        bench_sink += n_hits;
+    }
+}
+
+static void run_add_log(void *arg, uint64_t iters)
+{
+    const uint8_t (*topics)[32] = arg;
+    uint8_t bloom[WEB3C_BLOOM_SIZE];
+
+    memset(bloom, 0, sizeof(bloom));
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_bloom_add_log(bloom, topics[3], topics, 3);
+    }
+    bench_sink += bloom[0];
+}
+
+void bench_bloom(bench_state *b)
+{
+    static const size_t mask_counts[] = { 1, 16 };
+    static uint8_t topics[4][32];
+    char name[96];
+
+    uint8_t  *rows  = calloc(BENCH_BLOOM_ROWS, WEB3C_BLOOM_SIZE);
+    uint8_t (*masks)[WEB3C_BLOOM_SIZE] = calloc(16, WEB3C_BLOOM_SIZE);
+    uint64_t *hits  = calloc(16 * WEB3C_BLOOM_HITS_WORDS(BENCH_BLOOM_ROWS),
+                             sizeof(uint64_t));
+    if (rows == NULL || masks == NULL || hits == NULL) {
+        free(rows);
+        free(masks);
+        free(hits);
+        return;
+    }
+
+    /* Block-like density: a few hundred bits per row. */
+    for (size_t i = 0; i < (size_t)BENCH_BLOOM_ROWS * WEB3C_BLOOM_SIZE; ++i) {
+        uint32_t x = (uint32_t)i * 2654435761u;
+        rows[i] = (uint8_t)((x >> 13) & (x >> 21) & (x >> 7));
+    }
+    for (size_t m = 0; m < 16; ++m) {
+        uint8_t item[32];
+        memset(item, (int)m, sizeof(item));
+        web3c_bloom_add(masks[m], item, sizeof(item));
+    }
+    for (size_t t = 0; t < 4; ++t) {
+        memset(topics[t], (int)(t + 1), 32);
+    }
+
+    for (size_t c = 0; c < sizeof(mask_counts) / sizeof(mask_counts[0]); ++c) {
+        bench_bloom_arg a = { rows, (const uint8_t (*)[WEB3C_BLOOM_SIZE])masks,
+                              mask_counts[c], hits };
+
+        snprintf(name, sizeof(name), "bloom/scan%zu/%d",
+                 mask_counts[c], BENCH_BLOOM_ROWS);
+        bench_run(b, name, (size_t)BENCH_BLOOM_ROWS * WEB3C_BLOOM_SIZE,
+                  run_scan, &a);
+    }
+
+    bench_run(b, "bloom/add_log/3topics", 0, run_add_log, topics);
+
+    free(rows);
+    free(masks);
+    free(hits);
+}
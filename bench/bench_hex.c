@@ -0,0 +1,126 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "web3c/hex.h"
+
+#define BENCH_HEX_MAX 65536
+
+typedef struct {
+    const uint8_t *bin;
+    char          *hex;
+    uint8_t       *out;
+    size_t         len;
+} bench_hex_arg;
+
+static void run_encode(void *arg, uint64_t iters)
+{
+    bench_hex_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_hex_encode(a->bin, a->len, a->hex, 2 * a->len + 1);
+        bench_sink += (uint8_t)a->hex[0];
+    }
+}
+
+static void run_encode_raw(void *arg, uint64_t iters)
+{
+    bench_hex_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_hex_encode_raw(a->bin, a->len, a->hex, 2 * a->len);
+        bench_sink += (uint8_t)a->hex[0];
+    }
+}
+
+static void run_decode(void *arg, uint64_t iters)
+{
+    bench_hex_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        bench_sink += (uint64_t)web3c_hex_decode(a->hex, a->out, a->len);
+    }
+}
+
+static void run_decode_n(void *arg, uint64_t iters)
+{
+    bench_hex_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        bench_sink += (uint64_t)web3c_hex_decode_n(a->hex, 2 * a->len,
+                                                   a->out, a->len, NULL);
+    }
+}
+
+static int sink_bytes(void *user, const uint8_t *bytes, size_t len)
+{
+    (void)user;
+    bench_sink += bytes[len - 1];
+    return 0;
+}
+
+/* Decode the input as a stream of odd-sized (byte-splitting) chunks. */
+static void run_decode_stream(void *arg, uint64_t iters)
+{
+    bench_hex_arg *a = arg;
+    web3c_hex_decode_ctx ctx;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        size_t left = 2 * a->len;
+        const char *p = a->hex;
+
+        web3c_hex_decode_init(&ctx, 0);
+        while (left > 0) {
+            size_t n = left < 4097 ? left : 4097;
+            web3c_hex_decode_update_sink(&ctx, p, n, sink_bytes, NULL);
+            p    += n;
+            left -= n;
+        }
+        bench_sink += (uint64_t)web3c_hex_decode_final(&ctx);
+    }
+}
+
+void bench_hex(bench_state *b)
+{
+    static const size_t sizes[] = { 20, 32, 1024, BENCH_HEX_MAX };
+    char name[96];
+
+    uint8_t *bin = malloc(BENCH_HEX_MAX);
+    uint8_t *out = malloc(BENCH_HEX_MAX);
+    char    *hex = malloc(2 * BENCH_HEX_MAX + 1);
+    if (bin == NULL || out == NULL || hex == NULL) {
+        free(bin);
+        free(out);
+        free(hex);
+        return;
+    }
+    for (size_t i = 0; i < BENCH_HEX_MAX; ++i) {
+        bin[i] = (uint8_t)(i * 29 + 3);
+    }
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        bench_hex_arg a = { bin, hex, out, sizes[s] };
+
+        snprintf(name, sizeof(name), "hex/encode/%zu", sizes[s]);
+        bench_run(b, name, sizes[s], run_encode, &a);
+
+        snprintf(name, sizeof(name), "hex/encode_raw/%zu", sizes[s]);
+        bench_run(b, name, sizes[s], run_encode_raw, &a);
+
+        /* Decode input: the encoding of the same bytes. */
+        web3c_hex_encode(bin, sizes[s], hex, 2 * sizes[s] + 1);
+        snprintf(name, sizeof(name), "hex/decode/%zu", sizes[s]);
+        bench_run(b, name, sizes[s], run_decode, &a);
+
+        snprintf(name, sizeof(name), "hex/decode_n/%zu", sizes[s]);
+        bench_run(b, name, sizes[s], run_decode_n, &a);
+
+        snprintf(name, sizeof(name), "hex/decode_stream/%zu", sizes[s]);
+        bench_run(b, name, sizes[s], run_decode_stream, &a);
+    }
+
+    free(bin);
+    free(out);
+    free(hex);
+}
@@ -0,0 +1,109 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "web3c/keccak.h"
+
+#define BENCH_KECCAK_MAX (1024 * 1024)
+
+typedef struct {
+    const uint8_t *data;
+    size_t         len;
+    size_t         chunk;   /* streaming chunk size */
+} bench_keccak_arg;
+
+static void run_oneshot(void *arg, uint64_t iters)
+{
+    bench_keccak_arg *a = arg;
+    uint8_t digest[32];
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_keccak256(a->data, a->len, digest);
+        bench_sink += digest[0];
+    }
+}
+
+static void run_streaming(void *arg, uint64_t iters)
+{
+    bench_keccak_arg *a = arg;
+    uint8_t digest[32];
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_keccak_ctx ctx;
+
+        web3c_keccak256_init(&ctx);
+        for (size_t off = 0; off < a->len; off += a->chunk) {
+            size_t n = a->len - off < a->chunk ? a->len - off : a->chunk;
+            web3c_keccak_update(&ctx, a->data + off, n);
+        }
+        web3c_keccak_final(&ctx, digest);
+        bench_sink += digest[0];
+    }
+}
+
+#define BENCH_BATCH_N 64
+
+typedef struct {
+    const uint8_t *inputs[BENCH_BATCH_N];
+    size_t         lens[BENCH_BATCH_N];
+    uint8_t        outs[BENCH_BATCH_N][32];
+} bench_batch_arg;
+
+static void run_batch(void *arg, uint64_t iters)
+{
+    bench_batch_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_keccak256_batch(a->inputs, a->lens, a->outs, BENCH_BATCH_N);
+        bench_sink += a->outs[0][0];
+    }
+}
+
+void bench_keccak(bench_state *b)
+{
+    static const size_t sizes[] = {
+        0, 32, 64, 136, 256, 1024, 4096, 16384, 65536, BENCH_KECCAK_MAX
+    };
+    static const size_t chunks[] = { 1, 32, 136, 4096, 65536 };
+    static const size_t batch_sizes[] = { 32, 85, 256 };
+    char name[96];
+
+    uint8_t *data = malloc(BENCH_KECCAK_MAX);
+    if (data == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < BENCH_KECCAK_MAX; ++i) {
+        data[i] = (uint8_t)(i * 131 + 7);
+    }
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        bench_keccak_arg a = { data, sizes[s], 0 };
+
+        snprintf(name, sizeof(name), "keccak256/oneshot/%zu", sizes[s]);
+        bench_run(b, name, sizes[s], run_oneshot, &a);
+    }
+
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); ++c) {
+        bench_keccak_arg a = { data, BENCH_KECCAK_MAX, chunks[c] };
+
+        snprintf(name, sizeof(name), "keccak256/stream_chunk%zu/%zu",
+                 chunks[c], (size_t)BENCH_KECCAK_MAX);
+        bench_run(b, name, BENCH_KECCAK_MAX, run_streaming, &a);
+    }
+
+    /* Throughput of many independent short messages (hashes/s = 64e9 / ns). */
+    for (size_t s = 0; s < sizeof(batch_sizes) / sizeof(batch_sizes[0]); ++s) {
+        bench_batch_arg a;
+
+        for (size_t i = 0; i < BENCH_BATCH_N; ++i) {
+            a.inputs[i] = data + i;
+            a.lens[i]   = batch_sizes[s];
+        }
+        snprintf(name, sizeof(name), "keccak256/batch%d/%zu",
+                 BENCH_BATCH_N, batch_sizes[s]);
+        bench_run(b, name, BENCH_BATCH_N * batch_sizes[s], run_batch, &a);
+    }
+
+    free(data);
+}
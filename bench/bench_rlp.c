@@ -0,0 +1,527 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "web3c/keccak.h"
+#include "web3c/rlp.h"
+#include "web3c/tx.h"
+
+typedef struct {
+    uint64_t       value;
+    const uint8_t *data;
+    size_t         len;
+    uint8_t        out[2048];
+} bench_rlp_arg;
+
+static void run_uint64(void *arg, uint64_t iters)
+{
+    bench_rlp_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rlp_encode_uint64(a->value, a->out, sizeof(a->out), &len);
+        bench_sink += len;
+    }
+}
+
+static void run_uint256(void *arg, uint64_t iters)
+{
+    bench_rlp_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rlp_encode_uint256(a->data, a->out, sizeof(a->out), &len);
+        bench_sink += len;
+    }
+}
+
+static void run_bytes(void *arg, uint64_t iters)
+{
+    bench_rlp_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rlp_encode_bytes(a->data, a->len, a->out, sizeof(a->out), &len);
+        bench_sink += len;
+    }
+}
+
+static void run_list_header(void *arg, uint64_t iters)
+{
+    bench_rlp_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rlp_encode_list_header(a->len, a->out, sizeof(a->out), &len);
+        bench_sink += len;
+    }
+}
+
+typedef struct {
+    web3c_tx_legacy tx;
+    uint8_t         out[512];
+} bench_tx_arg;
+
+static void run_tx_size(void *arg, uint64_t iters)
+{
+    bench_tx_arg *a = arg;
+    size_t size = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_tx_legacy_rlp_size(&a->tx, &size);
+        bench_sink += size;
+    }
+}
+
+static void run_tx_encode(void *arg, uint64_t iters)
+{
+    bench_tx_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_tx_legacy_rlp_encode(&a->tx, a->out, sizeof(a->out), &len);
+        bench_sink += len;
+    }
+}
+
+typedef struct {
+    web3c_tx_1559 tx;
+    uint8_t       out[8192];
+} bench_tx_1559_arg;
+
+/* Fee bumping: new tip every iteration, then the signing hash. */
+static void run_tx_1559_hash(void *arg, uint64_t iters)
+{
+    bench_tx_1559_arg *a = arg;
+    uint8_t hash[32];
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        a->tx.max_priority_fee_per_gas = 1000000000ULL + (i & 0xffff) * 1000;
+        web3c_tx_1559_signing_hash(&a->tx, hash);
+        bench_sink += hash[0];
+    }
+}
+
+/* Baseline: materialize the preimage, then hash it. */
+static void run_tx_1559_encode_hash(void *arg, uint64_t iters)
+{
+    bench_tx_1559_arg *a = arg;
+    uint8_t hash[32];
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        a->tx.max_priority_fee_per_gas = 1000000000ULL + (i & 0xffff) * 1000;
+        web3c_tx_1559_rlp_encode(&a->tx, a->out, sizeof(a->out), &len);
+        web3c_keccak256(a->out, len, hash);
+        bench_sink += hash[0];
+    }
+}
+
+/* Access list: 8 addresses x 40 storage keys. */
+enum { BENCH_AL_ADDRS = 8, BENCH_AL_KEYS = 40 };
+
+typedef struct {
+    web3c_access_list al;
+    uint8_t           out[16384];
+} bench_access_list_arg;
+
+static void run_access_list_soa(void *arg, uint64_t iters)
+{
+    bench_access_list_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_access_list_rlp_encode(&a->al, a->out, sizeof(a->out), &len);
+        bench_sink += len + a->out[len - 1];
+    }
+}
+
+/* Baseline: size pass, then one web3c_rlp_encode_* call per element. */
+static void run_access_list_per_element(void *arg, uint64_t iters)
+{
+    bench_access_list_arg *a = arg;
+    const web3c_access_list *al = &a->al;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        size_t total = 0;
+
+        for (size_t j = 0; j < al->n_addresses; ++j) {
+            size_t keys = 0;
+            for (size_t k = 0; k < al->key_counts[j]; ++k) {
+                keys += web3c_rlp_bytes_size(al->keys[j * BENCH_AL_KEYS + k], 32);
+            }
+            total += web3c_rlp_list_size(web3c_rlp_bytes_size(al->addresses[j], 20) +
+                                         web3c_rlp_list_size(keys));
+        }
+
+        uint8_t *p   = a->out;
+        uint8_t *end = a->out + sizeof(a->out);
+        size_t   n   = 0;
+
+        web3c_rlp_encode_list_header(total, p, (size_t)(end - p), &n); p += n;
+        for (size_t j = 0; j < al->n_addresses; ++j) {
+            size_t keys = 33 * al->key_counts[j];
+
+            web3c_rlp_encode_list_header(21 + web3c_rlp_list_size(keys), p,
+                                         (size_t)(end - p), &n); p += n;
+            web3c_rlp_encode_bytes(al->addresses[j], 20, p, (size_t)(end - p), &n); p += n;
+            web3c_rlp_encode_list_header(keys, p, (size_t)(end - p), &n); p += n;
+            for (size_t k = 0; k < al->key_counts[j]; ++k) {
+                web3c_rlp_encode_bytes(al->keys[j * BENCH_AL_KEYS + k], 32, p,
+                                       (size_t)(end - p), &n);
+                p += n;
+            }
+        }
+        bench_sink += (size_t)(p - a->out) + p[-1];
+    }
+}
+
+/* Contract deployment with a large init code. */
+typedef struct {
+    web3c_tx_legacy tx;
+    uint8_t        *out;
+    size_t          out_size;
+} bench_deploy_arg;
+
+static void run_deploy_encode(void *arg, uint64_t iters)
+{
+    bench_deploy_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_tx_legacy_rlp_encode(&a->tx, a->out, a->out_size, &len);
+        bench_sink += len;
+    }
+}
+
+static void run_deploy_encode_iov(void *arg, uint64_t iters)
+{
+    bench_deploy_arg *a = arg;
+    uint8_t scratch[WEB3C_TX_IOV_SCRATCH];
+    web3c_rlp_iovec iov[WEB3C_TX_IOV_MAX];
+    size_t count = 0, len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_tx_legacy_rlp_encode_iov(&a->tx, scratch, iov, &count, &len);
+        bench_sink += len + iov[0].base[0];
+    }
+}
+
+typedef struct {
+    const uint8_t *in;
+    size_t         len;
+} bench_decode_arg;
+
+/* Pull the `to` field (index 3) of an encoded transaction. */
+static void run_decode_field(void *arg, uint64_t iters)
+{
+    bench_decode_arg *a = arg;
+    web3c_rlp_item list, field;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rlp_decode(a->in, a->len, &list);
+        web3c_rlp_list_get(&list, 3, &field);
+        bench_sink += field.len;
+    }
+}
+
+/* Walk every field, reading integers. */
+static void run_decode_walk(void *arg, uint64_t iters)
+{
+    bench_decode_arg *a = arg;
+    web3c_rlp_item list, field;
+    web3c_rlp_iter it;
+    uint64_t v = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rlp_decode(a->in, a->len, &list);
+        web3c_rlp_iter_init(&it, &list);
+        while (web3c_rlp_iter_next(&it, &field) == 1) {
+            if (web3c_rlp_item_uint64(&field, &v) == 0) {
+                bench_sink += v;
+            }
+        }
+    }
+}
+
+static void run_validate(void *arg, uint64_t iters)
+{
+    bench_decode_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        bench_sink += (uint64_t)web3c_rlp_validate(a->in, a->len, 16, NULL);
+    }
+}
+
+/* A receipt: [status, cumulative_gas, bloom, [[address, [topics], data], ...]]. */
+enum { BENCH_LOGS = 20, BENCH_TOPICS = 3 };
+
+typedef struct {
+    uint8_t data[256];
+    uint8_t arena[16384];
+} bench_receipt_arg;
+
+static void run_receipt_builder(void *arg, uint64_t iters)
+{
+    bench_receipt_arg *a = arg;
+    web3c_rlp_builder rb;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rlp_builder_init(&rb, a->arena, sizeof(a->arena));
+        web3c_rlp_builder_begin_list(&rb);
+        web3c_rlp_builder_append_uint64(&rb, 1);
+        web3c_rlp_builder_append_uint64(&rb, 21000 + i);
+        web3c_rlp_builder_append_bytes(&rb, a->data, 256);
+        web3c_rlp_builder_begin_list(&rb);
+        for (int l = 0; l < BENCH_LOGS; ++l) {
+            web3c_rlp_builder_begin_list(&rb);
+            web3c_rlp_builder_append_bytes(&rb, a->data, 20);
+            web3c_rlp_builder_begin_list(&rb);
+            for (int t = 0; t < BENCH_TOPICS; ++t) {
+                web3c_rlp_builder_append_bytes(&rb, a->data + 32 * t, 32);
+            }
+            web3c_rlp_builder_end_list(&rb);
+            web3c_rlp_builder_append_bytes(&rb, a->data, 64);
+            web3c_rlp_builder_end_list(&rb);
+        }
+        web3c_rlp_builder_end_list(&rb);
+        web3c_rlp_builder_end_list(&rb);
+        web3c_rlp_builder_finish(&rb, &len);
+        bench_sink += len + a->arena[len - 1];
+    }
+}
+
+/* Baseline: size every nested list bottom-up, then encode in order. */
+static void run_receipt_two_pass(void *arg, uint64_t iters)
+{
+    bench_receipt_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        size_t topics  = BENCH_TOPICS * web3c_rlp_bytes_size(a->data, 32);
+        size_t log     = web3c_rlp_bytes_size(a->data, 20) +
+                         web3c_rlp_list_size(topics) +
+                         web3c_rlp_bytes_size(a->data, 64);
+        size_t logs    = BENCH_LOGS * web3c_rlp_list_size(log);
+        size_t receipt = web3c_rlp_uint64_size(1) +
+                         web3c_rlp_uint64_size(21000 + i) +
+                         web3c_rlp_bytes_size(a->data, 256) +
+                         web3c_rlp_list_size(logs);
+        uint8_t *p   = a->arena;
+        uint8_t *end = a->arena + sizeof(a->arena);
+        size_t   n   = 0;
+
+        web3c_rlp_encode_list_header(receipt, p, (size_t)(end - p), &n); p += n;
+        web3c_rlp_encode_uint64(1, p, (size_t)(end - p), &n); p += n;
+        web3c_rlp_encode_uint64(21000 + i, p, (size_t)(end - p), &n); p += n;
+        web3c_rlp_encode_bytes(a->data, 256, p, (size_t)(end - p), &n); p += n;
+        web3c_rlp_encode_list_header(logs, p, (size_t)(end - p), &n); p += n;
+        for (int l = 0; l < BENCH_LOGS; ++l) {
+            web3c_rlp_encode_list_header(log, p, (size_t)(end - p), &n); p += n;
+            web3c_rlp_encode_bytes(a->data, 20, p, (size_t)(end - p), &n); p += n;
+            web3c_rlp_encode_list_header(topics, p, (size_t)(end - p), &n); p += n;
+            for (int t = 0; t < BENCH_TOPICS; ++t) {
+                web3c_rlp_encode_bytes(a->data + 32 * t, 32, p, (size_t)(end - p), &n);
+                p += n;
+            }
+            web3c_rlp_encode_bytes(a->data, 64, p, (size_t)(end - p), &n); p += n;
+        }
+        bench_sink += (size_t)(p - a->arena) + p[-1];
+    }
+}
+
+void bench_rlp(bench_state *b)
+{
+    static const uint64_t values[] = { 0x7f, 0x1234, 0xffffffffffffffffULL };
+    static const size_t   lens[]   = { 20, 32, 1024 };
+    static uint8_t        data[1024];
+    char name[96];
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 17 + 1);
+    }
+
+    for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); ++v) {
+        bench_rlp_arg a;
+
+        memset(&a, 0, sizeof(a));
+        a.value = values[v];
+        snprintf(name, sizeof(name), "rlp/uint64/0x%llx",
+                 (unsigned long long)values[v]);
+        bench_run(b, name, 0, run_uint64, &a);
+    }
+
+    /* 256-bit: 1 ether in wei, and a full word. */
+    {
+        static uint8_t words[2][32];
+        static const char *const names[] = { "rlp/uint256/1e18", "rlp/uint256/max" };
+
+        memset(words[0], 0, 32);
+        for (int k = 0; k < 8; ++k) {
+            words[0][31 - k] = (uint8_t)(1000000000000000000ULL >> (8 * k));
+        }
+        memset(words[1], 0xff, 32);
+
+        for (size_t w = 0; w < 2; ++w) {
+            bench_rlp_arg a;
+
+            memset(&a, 0, sizeof(a));
+            a.data = words[w];
+            bench_run(b, names[w], 0, run_uint256, &a);
+        }
+    }
+
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+        bench_rlp_arg a;
+
+        memset(&a, 0, sizeof(a));
+        a.data = data;
+        a.len  = lens[l];
+        snprintf(name, sizeof(name), "rlp/bytes/%zu", lens[l]);
+        bench_run(b, name, lens[l], run_bytes, &a);
+    }
+
+    {
+        bench_rlp_arg a;
+
+        memset(&a, 0, sizeof(a));
+        a.len = 1024;
+        bench_run(b, "rlp/list_header/1024", 0, run_list_header, &a);
+    }
+
+    /* ERC-20 transfer: 68 bytes of calldata. */
+    {
+        static bench_tx_arg a;
+
+        web3c_tx_legacy_init(&a.tx);
+        a.tx.nonce     = 9;
+        a.tx.gas_price = 20000000000ULL;
+        a.tx.gas_limit = 60000;
+        a.tx.value     = 0;
+        a.tx.chain_id  = 1;
+        web3c_tx_legacy_set_to(&a.tx, data);
+        web3c_tx_legacy_set_data(&a.tx, data, 68);
+
+        bench_run(b, "tx_legacy/rlp_size/erc20", 0, run_tx_size, &a);
+        bench_run(b, "tx_legacy/rlp_encode/erc20", 0, run_tx_encode, &a);
+
+        size_t len = 0;
+        web3c_tx_legacy_rlp_encode(&a.tx, a.out, sizeof(a.out), &len);
+
+        bench_decode_arg d = { a.out, len };
+        bench_run(b, "rlp/decode_field/erc20", len, run_decode_field, &d);
+        bench_run(b, "rlp/decode_walk/erc20", len, run_decode_walk, &d);
+    }
+
+    /* Access list with 320 storage keys. */
+    {
+        static bench_access_list_arg a;
+        static uint8_t addrs[BENCH_AL_ADDRS][20];
+        static uint8_t keys[BENCH_AL_ADDRS * BENCH_AL_KEYS][32];
+        static size_t  counts[BENCH_AL_ADDRS];
+
+        memset(addrs, 0x11, sizeof(addrs));
+        memset(keys, 0x22, sizeof(keys));
+        for (size_t j = 0; j < BENCH_AL_ADDRS; ++j) {
+            counts[j] = BENCH_AL_KEYS;
+        }
+        a.al.addresses   = (const uint8_t (*)[20])addrs;
+        a.al.key_counts  = counts;
+        a.al.n_addresses = BENCH_AL_ADDRS;
+        a.al.keys        = (const uint8_t (*)[32])keys;
+        a.al.n_keys      = BENCH_AL_ADDRS * BENCH_AL_KEYS;
+
+        bench_run(b, "access_list/rlp_encode/8x40", sizeof(keys),
+                  run_access_list_soa, &a);
+        bench_run(b, "access_list/per_element/8x40", sizeof(keys),
+                  run_access_list_per_element, &a);
+    }
+
+    /* EIP-1559 signing hash with 68 bytes and 4 KiB of calldata. */
+    {
+        static bench_tx_1559_arg a;
+        static const size_t sizes[] = { 68, 4096 };
+        static const char *const hash_names[] = {
+            "tx_1559/signing_hash/erc20", "tx_1559/signing_hash/4k"
+        };
+        static const char *const base_names[] = {
+            "tx_1559/encode+keccak/erc20", "tx_1559/encode+keccak/4k"
+        };
+        static uint8_t calldata[4096];
+
+        for (size_t k = 0; k < 2; ++k) {
+            web3c_tx_1559_init(&a.tx);
+            a.tx.chain_id        = 1;
+            a.tx.nonce           = 9;
+            a.tx.max_fee_per_gas = 200000000000ULL;
+            a.tx.gas_limit       = 60000;
+            web3c_tx_1559_set_to(&a.tx, data);
+            web3c_tx_1559_set_data(&a.tx, calldata, sizes[k]);
+
+            bench_run(b, hash_names[k], sizes[k], run_tx_1559_hash, &a);
+            bench_run(b, base_names[k], sizes[k], run_tx_1559_encode_hash, &a);
+        }
+    }
+
+    /* A block body's worth of transactions: [tx, tx, ...] with 500 txs. */
+    {
+        enum { N_TX = 500 };
+        static uint8_t block[N_TX * 256];
+        static bench_tx_arg a;
+        size_t tx_len = 0, hdr = 0;
+
+        web3c_tx_legacy_init(&a.tx);
+        a.tx.nonce     = 77;
+        a.tx.gas_price = 30000000000ULL;
+        a.tx.gas_limit = 120000;
+        a.tx.chain_id  = 1;
+        web3c_tx_legacy_set_to(&a.tx, data);
+        web3c_tx_legacy_set_data(&a.tx, data, 132);
+        web3c_tx_legacy_rlp_encode(&a.tx, a.out, sizeof(a.out), &tx_len);
+
+        web3c_rlp_encode_list_header(N_TX * tx_len, block, sizeof(block), &hdr);
+        for (size_t t = 0; t < N_TX; ++t) {
+            memcpy(block + hdr + t * tx_len, a.out, tx_len);
+        }
+
+        bench_decode_arg d = { block, hdr + N_TX * tx_len };
+        bench_run(b, "rlp/validate/500tx", d.len, run_validate, &d);
+    }
+
+    /* Receipt with 20 logs, 4 levels of nesting. */
+    {
+        static bench_receipt_arg a;
+
+        memset(a.data, 0xab, sizeof(a.data));
+        bench_run(b, "rlp/builder/receipt_20logs", 0, run_receipt_builder, &a);
+        bench_run(b, "rlp/two_pass/receipt_20logs", 0, run_receipt_two_pass, &a);
+    }
+
+    /* Deployment with 256 KiB of init code. */
+    {
+        enum { INIT_CODE = 256 * 1024 };
+        static bench_deploy_arg a;
+        uint8_t *code = malloc(INIT_CODE);
+
+        a.out_size = INIT_CODE + 128;
+        a.out      = malloc(a.out_size);
+        if (code != NULL && a.out != NULL) {
+            memset(code, 0x60, INIT_CODE);
+            web3c_tx_legacy_init(&a.tx);
+            a.tx.nonce     = 1;
+            a.tx.gas_price = 20000000000ULL;
+            a.tx.gas_limit = 8000000;
+            a.tx.chain_id  = 1;
+            web3c_tx_legacy_set_data(&a.tx, code, INIT_CODE);
+
+            bench_run(b, "tx_legacy/rlp_encode/deploy_256k", INIT_CODE,
+                      run_deploy_encode, &a);
+            bench_run(b, "tx_legacy/rlp_encode_iov/deploy_256k", INIT_CODE,
+                      run_deploy_encode_iov, &a);
+        }
+        free(code);
+        free(a.out);
+    }
+}
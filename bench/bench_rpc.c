@@ -0,0 +1,114 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "web3c/hex.h"
+#include "web3c/rpc.h"
+
+#define BENCH_RPC_N 1024
+
+typedef struct {
+    uint64_t values[BENCH_RPC_N];
+    uint8_t  words[BENCH_RPC_N][32];
+    uint8_t  raw_tx[512];
+    char     out[BENCH_RPC_N * 72];
+} bench_rpc_arg;
+
+/* The pre-rpc.h way: hex-encode the big-endian bytes, then strip zeros. */
+static void run_quantity_trim(void *arg, uint64_t iters)
+{
+    bench_rpc_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        char  *p = a->out;
+        *p++ = '[';
+        for (size_t k = 0; k < BENCH_RPC_N; ++k) {
+            uint8_t be[8];
+            char    hex[17];
+            size_t  z = 0;
+
+            for (int j = 0; j < 8; ++j) {
+                be[j] = (uint8_t)(a->values[k] >> (56 - 8 * j));
+            }
+            web3c_hex_encode(be, 8, hex, sizeof(hex));
+            while (z < 15 && hex[z] == '0') {
+                ++z;
+            }
+            if (k > 0) {
+                *p++ = ',';
+            }
+            memcpy(p, "\"0x", 3);
+            memcpy(p + 3, hex + z, 16 - z);
+            p += 3 + 16 - z;
+            *p++ = '"';
+        }
+        *p = ']';
+        bench_sink += (uint8_t)a->out[5];
+    }
+}
+
+static void run_quantity_array(void *arg, uint64_t iters)
+{
+    bench_rpc_arg *a = arg;
+    web3c_rpc_buf b;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rpc_buf_init(&b, a->out, sizeof(a->out));
+        web3c_rpc_put_quantity_u64_array(&b, a->values, BENCH_RPC_N);
+        bench_sink += b.len;
+    }
+}
+
+static void run_quantity_u256_array(void *arg, uint64_t iters)
+{
+    bench_rpc_arg *a = arg;
+    web3c_rpc_buf b;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rpc_buf_init(&b, a->out, sizeof(a->out));
+        web3c_rpc_put_quantity_u256_array(&b, (const uint8_t (*)[32])a->words,
+                                          BENCH_RPC_N);
+        bench_sink += b.len;
+    }
+}
+
+static void run_send_raw(void *arg, uint64_t iters)
+{
+    static const char head[] =
+        "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"eth_sendRawTransaction\",\"params\":[";
+    bench_rpc_arg *a = arg;
+    web3c_rpc_buf b;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_rpc_buf_init(&b, a->out, sizeof(a->out));
+        web3c_rpc_put_raw(&b, head, sizeof(head) - 1);
+        web3c_rpc_put_data(&b, a->raw_tx, sizeof(a->raw_tx));
+        web3c_rpc_put_raw(&b, "]}", 2);
+        bench_sink += b.len;
+    }
+}
+
+void bench_rpc(bench_state *b)
+{
+    static bench_rpc_arg a;
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+
+    /* Mixed magnitudes: nonces, gas, balances. */
+    for (size_t k = 0; k < BENCH_RPC_N; ++k) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        a.values[k] = x >> (k % 64);
+        memset(a.words[k], 0, 32);
+        memcpy(a.words[k] + 32 - 8 - k % 24, &x, 8);
+    }
+    for (size_t k = 0; k < sizeof(a.raw_tx); ++k) {
+        a.raw_tx[k] = (uint8_t)(k * 13 + 7);
+    }
+
+    bench_run(b, "rpc/quantity_u64_trim/1024", 0, run_quantity_trim, &a);
+    bench_run(b, "rpc/quantity_u64_array/1024", 0, run_quantity_array, &a);
+    bench_run(b, "rpc/quantity_u256_array/1024", 0, run_quantity_u256_array, &a);
+    bench_run(b, "rpc/send_raw_transaction/512", sizeof(a.raw_tx), run_send_raw, &a);
+}
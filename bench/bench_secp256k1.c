@@ -0,0 +1,148 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "web3c/secp256k1.h"
+#include "web3c/tx.h"
+
+/* Signatures / transactions per recovery batch. */
+#define BENCH_RECOVER_N 64
+
+typedef struct {
+    web3c_secp256k1_ctx ctx;
+    uint8_t             key[32];
+    uint8_t             hash[32];
+    web3c_tx_legacy     tx;
+    uint8_t             out[256];
+
+    /* Recovery inputs. */
+    uint8_t             hashes[BENCH_RECOVER_N][32];
+    uint8_t             sigs[BENCH_RECOVER_N][64];
+    unsigned            recids[BENCH_RECOVER_N];
+    uint8_t             raw[BENCH_RECOVER_N][160];
+    const uint8_t      *raw_ptrs[BENCH_RECOVER_N];
+    size_t              raw_lens[BENCH_RECOVER_N];
+    uint8_t             senders[BENCH_RECOVER_N][20];
+} bench_secp256k1_arg;
+
+static void run_ctx_init(void *arg, uint64_t iters)
+{
+    bench_secp256k1_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_secp256k1_ctx_init(&a->ctx);
+        bench_sink += a->ctx.table[0][0][0];
+    }
+}
+
+static void run_pubkey(void *arg, uint64_t iters)
+{
+    bench_secp256k1_arg *a = arg;
+    uint8_t pub[64];
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        a->key[31] = (uint8_t)(i | 1);
+        web3c_secp256k1_pubkey(&a->ctx, a->key, pub);
+        bench_sink += pub[0];
+    }
+}
+
+static void run_sign(void *arg, uint64_t iters)
+{
+    bench_secp256k1_arg *a = arg;
+    uint8_t r[32], s[32];
+    unsigned recid = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        a->hash[0] = (uint8_t)i;
+        web3c_secp256k1_sign(&a->ctx, a->hash, a->key, r, s, &recid);
+        bench_sink += r[0] + recid;
+    }
+}
+
+static void run_tx_sign(void *arg, uint64_t iters)
+{
+    bench_secp256k1_arg *a = arg;
+    size_t len = 0;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        a->tx.nonce = i;
+        web3c_tx_legacy_sign(&a->ctx, &a->tx, a->key, a->out, sizeof(a->out), &len);
+        bench_sink += len + a->out[len - 1];
+    }
+}
+
+static void run_recover(void *arg, uint64_t iters)
+{
+    bench_secp256k1_arg *a = arg;
+    uint8_t pub[64];
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        size_t j = i % BENCH_RECOVER_N;
+
+        web3c_secp256k1_recover(&a->ctx, a->hashes[j], a->sigs[j], a->sigs[j] + 32,
+                                a->recids[j], pub);
+        bench_sink += pub[0];
+    }
+}
+
+static void run_recover_batch(void *arg, uint64_t iters)
+{
+    bench_secp256k1_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_secp256k1_recover_batch(&a->ctx, (const uint8_t (*)[32])a->hashes,
+                                      (const uint8_t (*)[64])a->sigs, a->recids,
+                                      BENCH_RECOVER_N, a->senders, NULL);
+        bench_sink += a->senders[0][0];
+    }
+}
+
+static void run_recover_senders(void *arg, uint64_t iters)
+{
+    bench_secp256k1_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_recover_senders(&a->ctx, a->raw_ptrs, a->raw_lens, BENCH_RECOVER_N,
+                              a->senders, NULL);
+        bench_sink += a->senders[0][0];
+    }
+}
+
+void bench_secp256k1(bench_state *b)
+{
+    static bench_secp256k1_arg a;
+    static uint8_t data[68];
+
+    memset(a.key, 0x46, sizeof(a.key));
+    memset(a.hash, 0xab, sizeof(a.hash));
+    memset(data, 0x11, sizeof(data));
+
+    web3c_tx_legacy_init(&a.tx);
+    a.tx.gas_price = 20000000000ULL;
+    a.tx.gas_limit = 60000;
+    a.tx.chain_id  = 1;
+    web3c_tx_legacy_set_to(&a.tx, data);
+    web3c_tx_legacy_set_data(&a.tx, data, sizeof(data));
+
+    web3c_secp256k1_ctx_init(&a.ctx);
+    for (size_t i = 0; i < BENCH_RECOVER_N; ++i) {
+        memset(a.hashes[i], (int)i, 32);
+        web3c_secp256k1_sign(&a.ctx, a.hashes[i], a.key, a.sigs[i], a.sigs[i] + 32,
+                             &a.recids[i]);
+
+        a.tx.nonce = i;
+        web3c_tx_legacy_sign(&a.ctx, &a.tx, a.key, a.raw[i], sizeof(a.raw[i]),
+                             &a.raw_lens[i]);
+        a.raw_ptrs[i] = a.raw[i];
+    }
+
+    bench_run(b, "secp256k1/ctx_init", 0, run_ctx_init, &a);
+    bench_run(b, "secp256k1/pubkey", 0, run_pubkey, &a);
+    bench_run(b, "secp256k1/sign", 0, run_sign, &a);
+    bench_run(b, "tx_legacy/sign/erc20", 0, run_tx_sign, &a);
+    bench_run(b, "secp256k1/recover", 0, run_recover, &a);
+    bench_run(b, "secp256k1/recover_batch/64", 0, run_recover_batch, &a);
+    bench_run(b, "tx/recover_senders/64", 0, run_recover_senders, &a);
+}
@@ -0,0 +1,50 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "web3c/storage.h"
+
+#define BENCH_STORAGE_N 1024
+
+typedef struct {
+    uint8_t addrs[BENCH_STORAGE_N][20];
+    uint8_t slot[32];
+    uint8_t outs[BENCH_STORAGE_N][32];
+} bench_storage_arg;
+
+static void run_single(void *arg, uint64_t iters)
+{
+    bench_storage_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        for (size_t k = 0; k < BENCH_STORAGE_N; ++k) {
+            web3c_storage_mapping_slot_address(a->addrs[k], a->slot, a->outs[k]);
+        }
+        bench_sink += a->outs[0][0];
+    }
+}
+
+static void run_batch(void *arg, uint64_t iters)
+{
+    bench_storage_arg *a = arg;
+
+    for (uint64_t i = 0; i < iters; ++i) {
+        web3c_storage_mapping_slots_address((const uint8_t (*)[20])a->addrs,
+                                            BENCH_STORAGE_N, a->slot, a->outs);
+        bench_sink += a->outs[0][0];
+    }
+}
+
+void bench_storage(bench_state *b)
+{
+    static bench_storage_arg a;
+
+    for (size_t k = 0; k < BENCH_STORAGE_N; ++k) {
+        memset(a.addrs[k], (int)k, 20);
+    }
+    memset(a.slot, 0, sizeof(a.slot));
+
+    bench_run(b, "storage/mapping_address_loop/1024", 0, run_single, &a);
+    bench_run(b, "storage/mapping_address_batch/1024", 0, run_batch, &a);
+}
@@ -0,0 +1,73 @@
+#ifndef WEB3C_ADDRESS_H
+#define WEB3C_ADDRESS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * EIP-55 mixed-case checksum addresses.
+ *
+ * The checksum hashes the 40 lowercase hex digits of the address with
+ * Keccak-256; digit i is uppercased when it is a letter and nibble i of
+ * the hash is >= 8.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* "0x" + 40 hex digits + null terminator. */
+#define WEB3C_ADDRESS_CHECKSUM_SIZE 43
+
+/*
+ * Format a 20-byte address as an EIP-55 checksummed string.
+ *
+ * Parameters:
+ *   address - 20-byte address.
+ *   out     - receives "0x" + 40 mixed-case digits + null terminator.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_address_to_checksum(const uint8_t address[20],
+                              char out[WEB3C_ADDRESS_CHECKSUM_SIZE]);
+
+/*
+ * Validate an EIP-55 checksummed address string.
+ *
+ * The string must be 40 hex digits, optionally prefixed with "0x", and
+ * the case of every letter must match the checksum. Addresses written
+ * entirely in one case carry no checksum and are rejected unless they
+ * happen to be valid (e.g. contain no letters).
+ *
+ * Parameters:
+ *   str     - address characters (not necessarily null-terminated).
+ *   len     - number of characters (40 or 42).
+ *   address - if non-NULL, receives the decoded 20 bytes when valid.
+ *
+ * Returns:
+ *   0 if the address is valid, non-zero otherwise.
+ */
+int web3c_address_validate_checksum(const char *str,
+                                    size_t len,
+                                    uint8_t address[20]);
+
+/*
+ * Checksum n addresses at once.
+ *
+ * Equivalent to calling web3c_address_to_checksum() on each address,
+ * but the hex encoding, hashing (web3c_keccak256_batch()) and case
+ * mixing each run as one loop over a block of addresses.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_address_to_checksum_batch(const uint8_t (*addresses)[20],
+                                    size_t n,
+                                    char (*outs)[WEB3C_ADDRESS_CHECKSUM_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEB3C_ADDRESS_H */
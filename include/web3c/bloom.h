@@ -0,0 +1,107 @@
+#ifndef WEB3C_BLOOM_H
+#define WEB3C_BLOOM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Ethereum 2048-bit logs bloom.
+ *
+ * An item (log address or topic) sets three bits: for i in {0, 2, 4},
+ * bit = ((h[i] << 8) | h[i + 1]) & 2047 with h = keccak256(item), stored
+ * big-endian, i.e. byte 255 - bit / 8, bit bit % 8.
+ *
+ * A query is itself a bloom ("mask") holding the bits of the items that
+ * must all be present; a row may contain them when (row & mask) == mask.
+ * web3c_bloom_scan() tests many masks against a contiguous column of
+ * 256-byte rows (e.g. an mmap'd file of block blooms) with AVX2 or
+ * AVX-512 when the CPU has them.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size of a bloom in bytes. */
+#define WEB3C_BLOOM_SIZE 256
+
+/* Number of uint64_t words in one hit bitmap for n_rows rows. */
+#define WEB3C_BLOOM_HITS_WORDS(n_rows) (((n_rows) + 63) / 64)
+
+/*
+ * Add one item (a 20-byte address or a 32-byte topic) to a bloom.
+ *
+ * The same call builds query masks: add the items to a zeroed bloom.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_bloom_add(uint8_t bloom[WEB3C_BLOOM_SIZE],
+                    const uint8_t *data,
+                    size_t len);
+
+/*
+ * Add a log entry (its address and all of its topics) to a bloom.
+ *
+ * Parameters:
+ *   bloom    - bloom to update.
+ *   address  - 20-byte address of the emitting contract.
+ *   topics   - n_topics 32-byte topics (can be NULL if n_topics == 0).
+ *   n_topics - number of topics.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_bloom_add_log(uint8_t bloom[WEB3C_BLOOM_SIZE],
+                        const uint8_t address[20],
+                        const uint8_t (*topics)[32],
+                        size_t n_topics);
+
+/*
+ * dst |= src (e.g. to combine receipt blooms into a block bloom).
+ */
+void web3c_bloom_or(uint8_t dst[WEB3C_BLOOM_SIZE],
+                    const uint8_t src[WEB3C_BLOOM_SIZE]);
+
+/*
+ * Returns 1 if every bit of mask is set in bloom, 0 otherwise.
+ */
+int web3c_bloom_match(const uint8_t bloom[WEB3C_BLOOM_SIZE],
+                      const uint8_t mask[WEB3C_BLOOM_SIZE]);
+
+/*
+ * Returns 1 if the bloom may contain the item, 0 if it certainly does
+ * not, -1 on error.
+ */
+int web3c_bloom_contains(const uint8_t bloom[WEB3C_BLOOM_SIZE],
+                         const uint8_t *data,
+                         size_t len);
+
+/*
+ * Test n_masks query masks against n_rows contiguous blooms.
+ *
+ * Parameters:
+ *   rows    - n_rows * 256 bytes; no alignment requirement.
+ *   n_rows  - number of blooms.
+ *   masks   - n_masks query masks.
+ *   n_masks - number of masks.
+ *   hits    - n_masks bitmaps of WEB3C_BLOOM_HITS_WORDS(n_rows) words
+ *             each; bit r of bitmap m is set when row r matches mask m.
+ *             Overwritten entirely.
+ *   n_hits  - if non-NULL, receives the total number of set bits.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_bloom_scan(const uint8_t *rows,
+                     size_t n_rows,
+                     const uint8_t (*masks)[WEB3C_BLOOM_SIZE],
+                     size_t n_masks,
+                     uint64_t *hits,
+                     size_t *n_hits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEB3C_BLOOM_H */
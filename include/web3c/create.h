@@ -0,0 +1,274 @@
+#ifndef WEB3C_CREATE_H
+#define WEB3C_CREATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Contract address derivation for CREATE and CREATE2.
+ *
+ *   CREATE:  keccak256(rlp([sender, nonce]))[12:]
+ *   CREATE2: keccak256(0xff ++ deployer ++ salt ++ init_code_hash)[12:]
+ *
+ * Besides single-address helpers, this module provides a multithreaded
+ * engine for large salt ranges: vanity searches with early exit and bulk
+ * precomputation of deterministic addresses into a sorted table. The
+ * engine uses POSIX threads; all buffers are owned by the caller.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Compute the address of a contract created with CREATE.
+ *
+ * Parameters:
+ *   sender - 20-byte address of the creating account.
+ *   nonce  - account nonce at creation time.
+ *   out    - receives the 20-byte contract address.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_create_address(const uint8_t sender[20],
+                         uint64_t nonce,
+                         uint8_t out[20]);
+
+/*
+ * Compute CREATE addresses for the nonces first_nonce .. first_nonce + n - 1.
+ *
+ * Hashes run through web3c_keccak256_batch().
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_create_address_range(const uint8_t sender[20],
+                               uint64_t first_nonce,
+                               size_t n,
+                               uint8_t (*outs)[20]);
+
+/*
+ * Compute the address of a contract created with CREATE2.
+ *
+ * Parameters:
+ *   deployer       - 20-byte address of the deploying contract.
+ *   salt           - 32-byte salt.
+ *   init_code_hash - keccak256 of the init code.
+ *   out            - receives the 20-byte contract address.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_create2_address(const uint8_t deployer[20],
+                          const uint8_t salt[32],
+                          const uint8_t init_code_hash[32],
+                          uint8_t out[20]);
+
+/*
+ * Compute CREATE2 addresses for n salts with one deployer and init code.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_create2_address_batch(const uint8_t deployer[20],
+                                const uint8_t init_code_hash[32],
+                                const uint8_t (*salts)[32],
+                                size_t n,
+                                uint8_t (*outs)[20]);
+
+/*
+ * Address predicate: an address matches when
+ * (address[i] & mask[i]) == pattern[i] for all 20 bytes.
+ */
+typedef struct {
+    uint8_t pattern[20];
+    uint8_t mask[20];
+} web3c_address_pattern;
+
+/*
+ * Build a prefix/suffix pattern from hex nibbles.
+ *
+ * Parameters:
+ *   p          - pattern to fill.
+ *   prefix_hex - leading hex digits the address must start with, with an
+ *                optional "0x" (may be NULL or empty).
+ *   suffix_hex - trailing hex digits the address must end with (may be
+ *                NULL or empty).
+ *
+ * Matching is case-insensitive and works at nibble granularity.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (invalid digits, too many digits).
+ */
+int web3c_address_pattern_set(web3c_address_pattern *p,
+                              const char *prefix_hex,
+                              const char *suffix_hex);
+
+/*
+ * Returns 1 if addr matches the pattern, 0 otherwise.
+ */
+int web3c_address_pattern_match(const web3c_address_pattern *p,
+                                const uint8_t addr[20]);
+
+/* Salts per work item when web3c_create2_search.chunk is zero. */
+#define WEB3C_CREATE2_DEFAULT_CHUNK 4096
+
+/* Upper bound on worker threads for the engine. */
+#define WEB3C_CREATE2_MAX_THREADS 256
+
+/*
+ * CREATE2 vanity search over a salt counter range.
+ *
+ * The salt for counter c is salt_base with its last 8 bytes replaced by
+ * c in big-endian order, so the first 24 bytes (e.g. a deployer-bound
+ * prefix) stay fixed. Counters first .. first + count - 1 are split into
+ * chunks that worker threads claim from a shared atomic cursor, so fast
+ * threads keep taking work until the range is exhausted or a match is
+ * found.
+ *
+ * Fill the input fields, then call web3c_create2_search_run(). The
+ * progress fields can be read from another thread while it runs via
+ * web3c_create2_search_progress(). A stop request is only cleared by
+ * web3c_create2_search_init() or web3c_create2_search_reset(), so a
+ * stop issued before run starts is not lost; a match ends the run
+ * without touching it.
+ *
+ * After a run, exactly one of these holds:
+ *   found == 1                  - a match was found
+ *   found == 0 && stopped == 1  - ended by web3c_create2_search_stop()
+ *   found == 0 && stopped == 0  - range exhausted, no match
+ */
+typedef struct {
+    /* Inputs */
+    uint8_t  deployer[20];
+    uint8_t  init_code_hash[32];
+    uint8_t  salt_base[32];
+    uint64_t first;          /* first salt counter */
+    uint64_t count;          /* number of counters to try */
+    web3c_address_pattern pattern;
+    unsigned threads;        /* worker threads; 0 = one per online CPU */
+    uint64_t chunk;          /* counters per work item; 0 = default */
+
+    /* Progress (updated atomically while running) */
+    uint64_t hashes;         /* addresses derived so far */
+    uint64_t start_ns;       /* monotonic start time */
+
+    /* Result */
+    int      found;          /* 1 if a matching salt was found */
+    int      stopped;        /* 1 if a stop request ended the run */
+    uint8_t  salt[32];       /* matching salt */
+    uint8_t  address[20];    /* matching address */
+
+    /* Internal */
+    uint64_t next;           /* next unclaimed counter offset */
+    int      stop;           /* external stop request */
+    int      done;           /* set by a worker on a match or error */
+} web3c_create2_search;
+
+/*
+ * Initialize a search with safe defaults (all zero, match-anything
+ * pattern, automatic thread count).
+ */
+void web3c_create2_search_init(web3c_create2_search *s);
+
+/*
+ * Clear a pending stop request, progress and result; the inputs are
+ * kept. Must not be called while the search runs.
+ */
+void web3c_create2_search_reset(web3c_create2_search *s);
+
+/*
+ * Run the search until a match is found, the range is exhausted or
+ * web3c_create2_search_stop() is called. Blocks the calling thread.
+ * Can be called again after a match or an exhausted range (e.g. with a
+ * new range); a pending stop request makes it return at once with
+ * stopped == 1 until web3c_create2_search_reset() clears it.
+ *
+ * Returns:
+ *   0 when the search completed (check s->found), non-zero on error
+ *   (NULL pointer, thread creation failure).
+ */
+int web3c_create2_search_run(web3c_create2_search *s);
+
+/*
+ * Ask a running search to stop early. Safe to call from another thread.
+ */
+void web3c_create2_search_stop(web3c_create2_search *s);
+
+/*
+ * Read live progress of a running (or finished) search.
+ *
+ * Parameters:
+ *   s               - search.
+ *   hashes          - if non-NULL, receives the number of addresses derived.
+ *   hashes_per_sec  - if non-NULL, receives the average rate since start.
+ */
+void web3c_create2_search_progress(const web3c_create2_search *s,
+                                   uint64_t *hashes,
+                                   double *hashes_per_sec);
+
+/* One precomputed CREATE2 address and the index of its salt. */
+typedef struct {
+    uint8_t  address[20];
+    uint64_t index;
+} web3c_create2_entry;
+
+/*
+ * Live counters of a web3c_create2_precompute() call, updated
+ * atomically while it runs. Read them from another thread with
+ * web3c_create2_progress_read().
+ */
+typedef struct {
+    uint64_t hashes;         /* addresses derived so far */
+    uint64_t start_ns;       /* monotonic start time (0 = not started) */
+} web3c_create2_progress;
+
+/*
+ * Read live progress of a running (or finished) precomputation, as
+ * web3c_create2_search_progress().
+ */
+void web3c_create2_progress_read(const web3c_create2_progress *p,
+                                 uint64_t *hashes,
+                                 double *hashes_per_sec);
+
+/*
+ * Precompute CREATE2 addresses for n salts (e.g. pair or proxy salts)
+ * across worker threads and sort the table by address.
+ *
+ * Parameters:
+ *   deployer       - 20-byte deployer address.
+ *   init_code_hash - keccak256 of the init code.
+ *   salts          - n salts; table[k].index refers into this array.
+ *   n              - number of salts.
+ *   table          - output table of n entries, sorted by address.
+ *   threads        - worker threads; 0 = one per online CPU.
+ *   progress       - if non-NULL, reset on entry and updated as the
+ *                    workers hash (the final sort is not counted).
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_create2_precompute(const uint8_t deployer[20],
+                             const uint8_t init_code_hash[32],
+                             const uint8_t (*salts)[32],
+                             size_t n,
+                             web3c_create2_entry *table,
+                             unsigned threads,
+                             web3c_create2_progress *progress);
+
+/*
+ * Binary-search a table built by web3c_create2_precompute().
+ *
+ * Returns:
+ *   pointer to the matching entry, or NULL if the address is absent.
+ */
+const web3c_create2_entry *web3c_create2_lookup(const web3c_create2_entry *table,
+                                                size_t n,
+                                                const uint8_t address[20]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEB3C_CREATE_H */
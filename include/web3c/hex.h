@@ -32,6 +32,25 @@ extern "C" {
  */
 int web3c_hex_encode(const uint8_t *in, size_t in_len, char *out, size_t out_size);
 
+/*
+ * Same as web3c_hex_encode(), but writes exactly in_len * 2 characters
+ * and no null terminator, for splicing hex into a larger output (JSON,
+ * CSV) in place.
+ *
+ * Parameters:
+ *   in       - pointer to input bytes (can be NULL if in_len == 0)
+ *   in_len   - number of input bytes
+ *   out      - pointer to output buffer for hex chars
+ *   out_size - size of the output buffer; must be >= in_len * 2
+ *
+ * Both functions use SIMD (AVX2 / SSSE3 on x86 selected at runtime,
+ * NEON on AArch64) for large inputs.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. buffer too small).
+ */
+int web3c_hex_encode_raw(const uint8_t *in, size_t in_len, char *out, size_t out_size);
+
 /*
  * Decode a hex string into binary.
  *
@@ -46,6 +65,118 @@ int web3c_hex_encode(const uint8_t *in, size_t in_len, char *out, size_t out_siz
  */
 int web3c_hex_decode(const char *hex, uint8_t *out, size_t out_size);
 
+/*
+ * Decode a length-delimited hex string into binary.
+ *
+ * Unlike web3c_hex_decode(), the input need not be null-terminated and
+ * may start with "0x" or "0X". Characters are validated and decoded 16
+ * or 32 at a time with SIMD where available.
+ *
+ * Parameters:
+ *   hex        - hex characters (not necessarily null-terminated)
+ *   hex_len    - number of characters, including any "0x" prefix
+ *   out        - pointer to output buffer for bytes
+ *   out_size   - size of the output buffer in bytes
+ *   err_offset - if non-NULL, receives on error the offset into hex of
+ *                the first invalid character; only if every character
+ *                is valid: hex_len if the number of digits is odd, or
+ *                else the first character whose byte does not fit into
+ *                out_size
+ *
+ * Returns:
+ *   number of bytes written on success,
+ *   -1 on error (output contents are then unspecified).
+ */
+int web3c_hex_decode_n(const char *hex,
+                       size_t hex_len,
+                       uint8_t *out,
+                       size_t out_size,
+                       size_t *err_offset);
+
+/*
+ * Resumable hex decoding for input that arrives in chunks (pipes,
+ * sockets, files read piecewise).
+ *
+ * Chunks may split anywhere, including between the two digits of a
+ * byte; a dangling digit is carried over in the context. Memory use is
+ * constant, so decoding one chunk can overlap with reading the next.
+ */
+
+/* Accept an optional "0x" / "0X" at the very start of the stream. */
+#define WEB3C_HEX_DECODE_PREFIX 1u
+
+typedef struct {
+    uint64_t offset;      /* characters consumed so far */
+    uint64_t err_offset;  /* stream offset of the error, once error is set */
+    int      nibble;      /* pending high nibble, or -1 */
+    unsigned flags;       /* WEB3C_HEX_DECODE_* */
+    int      error;       /* sticky: all further calls fail */
+} web3c_hex_decode_ctx;
+
+/*
+ * Callback receiving decoded bytes; return non-zero to stop decoding.
+ */
+typedef int (*web3c_hex_sink)(void *user, const uint8_t *bytes, size_t len);
+
+/*
+ * Initialize a decoding context.
+ *
+ * Parameters:
+ *   ctx   - context to initialize
+ *   flags - 0 or WEB3C_HEX_DECODE_PREFIX
+ */
+void web3c_hex_decode_init(web3c_hex_decode_ctx *ctx, unsigned flags);
+
+/*
+ * Decode the next chunk into a caller buffer.
+ *
+ * Decoding stops early when out is full; *consumed then tells how much
+ * of the chunk to pass again once the caller has drained out.
+ *
+ * Parameters:
+ *   ctx      - decoding context
+ *   hex      - next hex characters (not null-terminated)
+ *   hex_len  - number of characters in this chunk
+ *   out      - pointer to output buffer for bytes
+ *   out_size - size of the output buffer in bytes
+ *   consumed - if non-NULL, receives the number of characters consumed
+ *
+ * Returns:
+ *   number of bytes written on success,
+ *   -1 on error (invalid character: see ctx->err_offset).
+ */
+int web3c_hex_decode_update(web3c_hex_decode_ctx *ctx,
+                            const char *hex,
+                            size_t hex_len,
+                            uint8_t *out,
+                            size_t out_size,
+                            size_t *consumed);
+
+/*
+ * Decode the next chunk and pass the bytes to sink in blocks of up to
+ * a few KiB. The whole chunk is consumed unless an error occurs.
+ *
+ * Returns:
+ *   0 on success,
+ *   -1 on an invalid character or when sink returns non-zero (in which
+ *   case ctx->err_offset is the offset reached when sink stopped).
+ */
+int web3c_hex_decode_update_sink(web3c_hex_decode_ctx *ctx,
+                                 const char *hex,
+                                 size_t hex_len,
+                                 web3c_hex_sink sink,
+                                 void *user);
+
+/*
+ * Finish a stream.
+ *
+ * Returns:
+ *   0 if every digit was paired and no error occurred,
+ *   -1 otherwise (for an odd digit count, ctx->err_offset is the total
+ *   number of characters, as in web3c_hex_decode_n()).
+ */
+int web3c_hex_decode_final(web3c_hex_decode_ctx *ctx);
+
 #ifdef __cplusplus
 }
 #endif
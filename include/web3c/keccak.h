@@ -13,13 +13,15 @@ extern "C" {
  *
  * This context implements the Ethereum-style Keccak-256 hash function,
  * sometimes referred to as "Ethereum-SHA3".
+ *
+ * Input is XOR'd directly into the state, so there is no separate input
+ * buffer: the context is 208 bytes with plain 8-byte alignment, so it
+ * can live in malloc'd memory and be copied by value.
  */
 typedef struct {
-    uint64_t state[25];   /* 1600-bit internal state */
-    uint8_t  buffer[200]; /* temporary buffer for absorbing */
-    size_t   rate;        /* rate in bytes (1088 bits => 136 bytes) */
-    size_t   buffer_pos;  /* number of bytes currently in buffer */
-    int      finalized;   /* flag to prevent further writes after final */
+    uint64_t state[25];  /* 1600-bit internal state */
+    uint32_t pos;        /* bytes absorbed into the current block (< 136) */
+    uint32_t finalized;  /* flag to prevent further writes after final */
 } web3c_keccak_ctx;
 
 /**
@@ -48,9 +50,60 @@ void web3c_keccak_update(web3c_keccak_ctx *ctx,
  */
 void web3c_keccak_final(web3c_keccak_ctx *ctx, uint8_t out[32]);
 
+/**
+ * @brief Size in bytes of a serialized Keccak-256 midstate.
+ *
+ * Layout: the 200-byte sponge state in Keccak byte order (lane i is
+ * stored little-endian at offset 8 * i), followed by one byte holding
+ * the position inside the current 136-byte block. Bytes of a partial
+ * block are already XOR'd into the state, so the state also carries the
+ * buffered tail.
+ */
+#define WEB3C_KECCAK_MIDSTATE_SIZE 201
+
+/**
+ * @brief Copy a streaming context, including any partially absorbed block.
+ *
+ * Typical use: absorb a shared prefix (e.g. "\x19Ethereum Signed
+ * Message:\n", a storage-slot base or a domain separator) once, then
+ * clone the context for every suffix instead of re-hashing the prefix.
+ *
+ * @param dst  Destination context.
+ * @param src  Initialized source context (not finalized).
+ */
+void web3c_keccak_clone(web3c_keccak_ctx *dst, const web3c_keccak_ctx *src);
+
+/**
+ * @brief Serialize the midstate of a streaming context.
+ *
+ * @param ctx  Initialized, not yet finalized context.
+ * @param out  Buffer of WEB3C_KECCAK_MIDSTATE_SIZE bytes.
+ * @return 0 on success, non-zero on error (NULL pointers, finalized ctx).
+ */
+int web3c_keccak_export(const web3c_keccak_ctx *ctx,
+                        uint8_t out[WEB3C_KECCAK_MIDSTATE_SIZE]);
+
+/**
+ * @brief Restore a streaming context from a serialized midstate.
+ *
+ * The restored context continues exactly where the exported one was;
+ * it can be updated and finalized as usual.
+ *
+ * @param ctx  Context to overwrite.
+ * @param in   Buffer of WEB3C_KECCAK_MIDSTATE_SIZE bytes produced by
+ *             web3c_keccak_export().
+ * @return 0 on success, non-zero on error (NULL pointers, invalid
+ *         block position).
+ */
+int web3c_keccak_import(web3c_keccak_ctx *ctx,
+                        const uint8_t in[WEB3C_KECCAK_MIDSTATE_SIZE]);
+
 /**
  * @brief Convenience one-shot Keccak-256 helper.
  *
+ * Like the streaming API, uses the AVX-512 single-state permutation on
+ * CPUs that support it and the portable scalar one elsewhere.
+ *
  * @param data  Pointer to input bytes.
  * @param len   Number of bytes in @p data.
  * @param out   Pointer to a 32-byte output buffer.
@@ -58,6 +111,29 @@ void web3c_keccak_final(web3c_keccak_ctx *ctx, uint8_t out[32]);
  */
 int web3c_keccak256(const uint8_t *data, size_t len, uint8_t out[32]);
 
+/**
+ * @brief Hash many independent messages with Keccak-256.
+ *
+ * Produces exactly the same digests as calling web3c_keccak256() on each
+ * message, but runs several sponges through a single vectorized
+ * permutation: 8 at a time on CPUs with AVX-512F, otherwise 4 at a time
+ * with AVX2. Messages may have arbitrary, mixed lengths; a lane that
+ * finishes is refilled with the next pending message. A single message,
+ * or a CPU with neither extension, takes the one-shot path (which itself
+ * uses the AVX-512 single-state permutation where available).
+ *
+ * @param inputs  Array of @p n message pointers (an entry may be NULL
+ *                if its length is zero).
+ * @param lens    Array of @p n message lengths in bytes.
+ * @param outs    Array of @p n 32-byte digest buffers.
+ * @param n       Number of messages.
+ * @return 0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_keccak256_batch(const uint8_t *const *inputs,
+                          const size_t *lens,
+                          uint8_t (*outs)[32],
+                          size_t n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,12 +5,17 @@
 #include <stddef.h>
 
 /*
- * Minimal RLP encoder for uint64, byte strings, and list headers.
+ * Minimal RLP encoder for uint64, byte strings, and list headers, and a
+ * zero-copy decoder.
  *
- * All functions support "size-only" mode:
+ * All encode functions support "size-only" mode:
  *   - If out == NULL, no bytes are written, but out_len (if non-NULL)
  *     receives the required size.
  *   - If out != NULL, out_size must be >= required size.
+ *
+ * The decoder returns views into the input buffer and only accepts
+ * canonical encodings (minimal length prefixes, single bytes below 0x80
+ * encoded as themselves).
  */
 
 #ifdef __cplusplus
@@ -38,6 +43,31 @@ int web3c_rlp_encode_uint64(uint64_t value,
                             size_t out_size,
                             size_t *out_len);
 
+/*
+ * Encode a 256-bit unsigned integer (wei amounts, difficulty, ...) as an
+ * RLP string: minimal big-endian bytes, with the same special cases as
+ * web3c_rlp_encode_uint64().
+ *
+ * Parameters:
+ *   value    - 32-byte big-endian integer (ABI word layout).
+ *   limbs    - the integer as four 64-bit limbs, least significant first.
+ *   out      - output buffer (can be NULL for size-only mode).
+ *   out_size - size of the output buffer in bytes.
+ *   out_len  - if non-NULL, receives the number of bytes written.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_rlp_encode_uint256(const uint8_t value[32],
+                             uint8_t *out,
+                             size_t out_size,
+                             size_t *out_len);
+
+int web3c_rlp_encode_uint256_limbs(const uint64_t limbs[4],
+                                   uint8_t *out,
+                                   size_t out_size,
+                                   size_t *out_len);
+
 /*
  * Encode an arbitrary byte string as RLP.
  *
@@ -80,6 +110,245 @@ int web3c_rlp_encode_list_header(size_t payload_len,
                                  size_t out_size,
                                  size_t *out_len);
 
+/*
+ * Encode only the header of a byte string, for callers that emit the
+ * bytes themselves (e.g. by reference in a web3c_rlp_iovec).
+ *
+ * A single byte <= 0x7f is its own encoding and has no header: out_len
+ * is then 0. Otherwise header + data is exactly what
+ * web3c_rlp_encode_bytes() writes.
+ *
+ * Parameters:
+ *   data     - pointer to bytes (read only when len == 1; can be NULL if
+ *              len == 0).
+ *   len      - number of bytes.
+ *   out      - output buffer (can be NULL for size-only mode).
+ *   out_size - size of the output buffer in bytes.
+ *   out_len  - if non-NULL, receives the header length.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_rlp_encode_bytes_header(const uint8_t *data,
+                                  size_t len,
+                                  uint8_t *out,
+                                  size_t out_size,
+                                  size_t *out_len);
+
+/*
+ * One segment of a scatter/gather encoding. Same members, in the same
+ * order, as POSIX struct iovec, so an array can be handed to writev() /
+ * sendmsg() after a cast, or hashed segment by segment with
+ * web3c_keccak_update().
+ */
+typedef struct {
+    const uint8_t *base;
+    size_t         len;
+} web3c_rlp_iovec;
+
+/*
+ * Encoded sizes, computed arithmetically without writing anything.
+ * They match the out_len of the corresponding encoder, so a caller
+ * can size a whole structure before encoding each field exactly once.
+ *
+ * web3c_rlp_bytes_size() reads data[0] only when len == 1;
+ * web3c_rlp_list_size() includes the payload itself.
+ */
+size_t web3c_rlp_uint64_size(uint64_t value);
+size_t web3c_rlp_uint256_size(const uint8_t value[32]);
+size_t web3c_rlp_bytes_size(const uint8_t *data, size_t len);
+size_t web3c_rlp_list_size(size_t payload_len);
+
+/*
+ * Builder for nested RLP structures (block headers, receipts with logs,
+ * access lists) in a caller-supplied arena, without sizing passes.
+ *
+ * begin_list reserves the largest possible list header (9 bytes) and
+ * end_list writes the real header into the end of that slot, leaving a
+ * gap in front of it. finish closes all gaps in one forward pass, so the
+ * encoding is produced in O(n) with no allocation.
+ *
+ * Arena use while building: the final encoding, plus 8 bytes of header
+ * slack and sizeof(size_t) bytes of gap log (kept at the arena's end)
+ * per list.
+ */
+
+/* Deepest list nesting a builder can hold open. */
+#define WEB3C_RLP_BUILDER_DEPTH 32
+
+typedef struct {
+    uint8_t *buf;
+    size_t   size;
+    size_t   pos;       /* end of the data written so far */
+    size_t   limit;     /* start of the gap log; data must stay below */
+    size_t   n_lists;   /* lists begun (entries in the gap log) */
+    size_t   depth;     /* lists currently open */
+    struct {
+        size_t start;   /* offset of the reserved header slot */
+        size_t gaps;    /* gap bytes inside the list's payload */
+    } open[WEB3C_RLP_BUILDER_DEPTH];
+    int      error;     /* sticky: set by the first failing call */
+} web3c_rlp_builder;
+
+/*
+ * Start building into buf[0 .. size).
+ */
+void web3c_rlp_builder_init(web3c_rlp_builder *b, uint8_t *buf, size_t size);
+
+/*
+ * Open / close a list. Lists nest up to WEB3C_RLP_BUILDER_DEPTH deep.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (arena full, too deep, no open list).
+ */
+int web3c_rlp_builder_begin_list(web3c_rlp_builder *b);
+int web3c_rlp_builder_end_list(web3c_rlp_builder *b);
+
+/*
+ * Append one item to the innermost open list (or the top level).
+ * append_raw copies bytes that are already RLP-encoded items.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. arena full).
+ */
+int web3c_rlp_builder_append_uint64(web3c_rlp_builder *b, uint64_t value);
+int web3c_rlp_builder_append_uint256(web3c_rlp_builder *b, const uint8_t value[32]);
+int web3c_rlp_builder_append_bytes(web3c_rlp_builder *b,
+                                   const uint8_t *data,
+                                   size_t len);
+int web3c_rlp_builder_append_raw(web3c_rlp_builder *b,
+                                 const uint8_t *encoded,
+                                 size_t len);
+
+/*
+ * Finish: close the header gaps so the encoding occupies buf[0 .. *out_len).
+ *
+ * Returns:
+ *   0 on success, non-zero if any earlier call failed or a list is still
+ *   open.
+ */
+int web3c_rlp_builder_finish(web3c_rlp_builder *b, size_t *out_len);
+
+/* Kind of a decoded RLP item. */
+typedef enum {
+    WEB3C_RLP_STRING = 0,
+    WEB3C_RLP_LIST   = 1
+} web3c_rlp_type;
+
+/*
+ * View of one RLP item inside a caller buffer. Nothing is copied: the
+ * item is valid as long as the buffer is.
+ */
+typedef struct {
+    web3c_rlp_type type;
+    const uint8_t *data;  /* payload: string bytes, or encoded list elements */
+    size_t         len;   /* payload length in bytes */
+    const uint8_t *raw;   /* start of the encoding (header included) */
+    size_t         size;  /* length of the whole encoding */
+} web3c_rlp_item;
+
+/* Cursor over the elements of a list item. */
+typedef struct {
+    const uint8_t *pos;
+    const uint8_t *end;
+} web3c_rlp_iter;
+
+/*
+ * Decode the item at the start of a buffer.
+ *
+ * Only the header is parsed; list payloads are not descended into, so
+ * decoding is O(1) regardless of the item size. Trailing bytes after the
+ * item are allowed: compare item->size with in_len to reject them.
+ *
+ * Parameters:
+ *   in     - encoded bytes.
+ *   in_len - number of bytes available.
+ *   item   - receives the view.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (truncated input or non-canonical
+ *   header).
+ */
+int web3c_rlp_decode(const uint8_t *in, size_t in_len, web3c_rlp_item *item);
+
+/* Deepest list nesting web3c_rlp_validate() can check. */
+#define WEB3C_RLP_MAX_DEPTH 256
+
+/*
+ * Structurally validate an untrusted RLP blob before decoding it.
+ *
+ * Checks that in is exactly one item, that every nested length fits its
+ * enclosing list, that every header is canonical (as in
+ * web3c_rlp_decode()) and that lists nest at most max_depth deep (a flat
+ * list has depth 1). Uses a fixed explicit stack, no recursion and no
+ * allocation; string payloads are skipped by length, so the cost depends
+ * on the number of items, not the number of bytes.
+ *
+ * Parameters:
+ *   in         - encoded bytes.
+ *   in_len     - number of bytes.
+ *   max_depth  - nesting limit; values above WEB3C_RLP_MAX_DEPTH are
+ *                clamped to it.
+ *   err_offset - if non-NULL, receives on error the offset of the
+ *                offending header (or of the first trailing byte).
+ *
+ * Returns:
+ *   0 if the blob is valid, non-zero otherwise.
+ */
+int web3c_rlp_validate(const uint8_t *in,
+                       size_t in_len,
+                       size_t max_depth,
+                       size_t *err_offset);
+
+/*
+ * Start iterating over the elements of a list item.
+ *
+ * Returns:
+ *   0 on success, non-zero if list is not a list.
+ */
+int web3c_rlp_iter_init(web3c_rlp_iter *it, const web3c_rlp_item *list);
+
+/*
+ * Decode the next element of a list.
+ *
+ * Returns:
+ *   1 if an element was stored in item,
+ *   0 at the end of the list,
+ *   -1 on malformed input.
+ */
+int web3c_rlp_iter_next(web3c_rlp_iter *it, web3c_rlp_item *item);
+
+/*
+ * Fetch element `index` of a list, skipping over the elements before it
+ * by their headers only (e.g. field 3 of a transaction is its `to`).
+ *
+ * Returns:
+ *   0 on success, non-zero if list is not a list, is malformed, or has
+ *   no such element.
+ */
+int web3c_rlp_list_get(const web3c_rlp_item *list,
+                       size_t index,
+                       web3c_rlp_item *item);
+
+/*
+ * Count the elements of a list.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_rlp_list_count(const web3c_rlp_item *list, size_t *count);
+
+/*
+ * Read a string item as an integer (nonce, gas, chain id, ...).
+ *
+ * The string must be at most 8 bytes with no leading zero byte; the
+ * empty string is 0.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_rlp_item_uint64(const web3c_rlp_item *item, uint64_t *value);
+
 #ifdef __cplusplus
 }
 #endif
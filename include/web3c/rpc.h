@@ -0,0 +1,106 @@
+#ifndef WEB3C_RPC_H
+#define WEB3C_RPC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * JSON-RPC value formatting.
+ *
+ *   QUANTITY - "0x" + minimal lowercase hex digits ("0x0" for zero)
+ *   DATA     - "0x" + two hex digits per byte ("0x" for empty data)
+ *
+ * Values are written as quoted JSON strings straight into a caller
+ * buffer through a web3c_rpc_buf cursor; digit counts come from a
+ * count-leading-zeros, so nothing is encoded and then trimmed.
+ *
+ * The cursor works like snprintf: len always advances by the size a
+ * write needs, but bytes are only stored while they fit. Building a
+ * request with buf = NULL, size = 0 therefore measures it, and one check
+ * of len <= size at the end tells whether the whole body was written.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    char  *buf;   /* output buffer (may be NULL when size == 0) */
+    size_t size;  /* capacity of buf in bytes */
+    size_t len;   /* bytes needed so far; written only while <= size */
+} web3c_rpc_buf;
+
+/*
+ * Initialize a cursor over buf[0 .. size).
+ */
+void web3c_rpc_buf_init(web3c_rpc_buf *b, char *buf, size_t size);
+
+/*
+ * Append raw JSON text (punctuation, keys, literals) as is.
+ *
+ * Returns:
+ *   0 if the text fit, non-zero otherwise (len still advances).
+ */
+int web3c_rpc_put_raw(web3c_rpc_buf *b, const char *text, size_t text_len);
+
+/*
+ * Number of characters of a QUANTITY, including "0x" but not quotes.
+ */
+size_t web3c_rpc_quantity_u64_len(uint64_t value);
+size_t web3c_rpc_quantity_u256_len(const uint8_t word[32]);
+
+/*
+ * Append a QUANTITY as a quoted JSON string, e.g. "0x1a".
+ *
+ * Parameters:
+ *   b     - output cursor.
+ *   value - integer to format.
+ *   word  - 256-bit big-endian integer (e.g. wei amounts), in the layout
+ *           of web3c_abi_encode_uint256().
+ *
+ * Returns:
+ *   0 if the value fit, non-zero otherwise.
+ */
+int web3c_rpc_put_quantity_u64(web3c_rpc_buf *b, uint64_t value);
+int web3c_rpc_put_quantity_u256(web3c_rpc_buf *b, const uint8_t word[32]);
+
+/*
+ * Append DATA as a quoted JSON string, e.g. "0xa9059cbb...". Suited to
+ * eth_sendRawTransaction payloads and eth_call input.
+ *
+ * Parameters:
+ *   b    - output cursor.
+ *   data - bytes to format (can be NULL if len == 0).
+ *   len  - number of bytes.
+ *
+ * Returns:
+ *   0 if the value fit, non-zero otherwise.
+ */
+int web3c_rpc_put_data(web3c_rpc_buf *b, const uint8_t *data, size_t len);
+
+/*
+ * Append a JSON array of values, e.g. ["0x1","0x2a"], sizing the whole
+ * array before writing it.
+ *
+ * web3c_rpc_put_data_array() takes n pointers and lengths, as
+ * web3c_keccak256_batch() does.
+ *
+ * Returns:
+ *   0 if the array fit, non-zero otherwise.
+ */
+int web3c_rpc_put_quantity_u64_array(web3c_rpc_buf *b,
+                                     const uint64_t *values,
+                                     size_t n);
+int web3c_rpc_put_quantity_u256_array(web3c_rpc_buf *b,
+                                      const uint8_t (*words)[32],
+                                      size_t n);
+int web3c_rpc_put_data_array(web3c_rpc_buf *b,
+                             const uint8_t *const *items,
+                             const size_t *lens,
+                             size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEB3C_RPC_H */
@@ -0,0 +1,184 @@
+#ifndef WEB3C_SECP256K1_H
+#define WEB3C_SECP256K1_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * secp256k1 ECDSA signing and sender recovery for Ethereum transactions.
+ *
+ * Self-contained: no allocation, no global state. Nonces are
+ * deterministic (RFC 6979, HMAC-SHA256) and signatures are low-s with a
+ * recovery id, as Ethereum requires.
+ *
+ * k*G is computed from a fixed-base window table held in a caller-owned
+ * context: 64 windows of 4 bits, 15 precomputed multiples each. Signing
+ * then costs 64 point additions and no doublings. Table lookups scan
+ * every entry of a window and the additions use complete formulas
+ * (Renes-Costello-Batina), so the sequence of operations does not
+ * depend on the secret scalar.
+ *
+ * Sender recovery is batched: web3c_secp256k1_recover_batch() shares
+ * its field and scalar inversions across a block of signatures
+ * (Montgomery's trick), computes u1*G + u2*R with one interleaved
+ * doubling chain (Straus, wNAF digits) and hashes the public keys with
+ * web3c_keccak256_batch(). Recovery only handles public data and is
+ * not constant time.
+ *
+ * The context holds no pointers: build it once at startup with
+ * web3c_secp256k1_ctx_init(), share it read-only between threads, or
+ * dump its bytes once and embed them as a const initializer.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 4-bit windows over a 256-bit scalar. */
+#define WEB3C_SECP256K1_WINDOWS 64
+
+/* Non-zero multiples stored per window. */
+#define WEB3C_SECP256K1_WINDOW_POINTS 15
+
+/* Odd multiples of G used by recovery (1G, 3G, ..., 127G: 8-bit wNAF). */
+#define WEB3C_SECP256K1_GEN_ODD 64
+
+/*
+ * Generator tables, affine coordinates (x then y, 4 little-endian
+ * 64-bit limbs each, fully reduced mod p):
+ *
+ *   table[i][j] - (j + 1) * 16^i * G, for signing
+ *   odd[j]      - (2j + 1) * G, for recovery
+ *
+ * About 64 KiB; treat as opaque.
+ */
+typedef struct {
+    uint64_t table[WEB3C_SECP256K1_WINDOWS][WEB3C_SECP256K1_WINDOW_POINTS][8];
+    uint64_t odd[WEB3C_SECP256K1_GEN_ODD][8];
+} web3c_secp256k1_ctx;
+
+/*
+ * Build the generator tables (a few milliseconds).
+ */
+void web3c_secp256k1_ctx_init(web3c_secp256k1_ctx *ctx);
+
+/*
+ * Check that a private key is a valid scalar (0 < key < n).
+ *
+ * Returns:
+ *   0 if valid, non-zero otherwise.
+ */
+int web3c_secp256k1_seckey_verify(const uint8_t seckey[32]);
+
+/*
+ * Derive the uncompressed public key (x || y, 64 bytes big-endian).
+ *
+ * Parameters:
+ *   ctx     - initialized context.
+ *   seckey  - 32-byte private key.
+ *   pubkey  - receives x || y.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. invalid key).
+ */
+int web3c_secp256k1_pubkey(const web3c_secp256k1_ctx *ctx,
+                           const uint8_t seckey[32],
+                           uint8_t pubkey[64]);
+
+/*
+ * Derive the Ethereum address: last 20 bytes of keccak256(x || y).
+ *
+ * Parameters:
+ *   ctx     - initialized context.
+ *   seckey  - 32-byte private key.
+ *   address - receives the 20-byte address.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. invalid key).
+ */
+int web3c_secp256k1_address(const web3c_secp256k1_ctx *ctx,
+                            const uint8_t seckey[32],
+                            uint8_t address[20]);
+
+/*
+ * Sign a 32-byte message hash.
+ *
+ * Parameters:
+ *   ctx    - initialized context.
+ *   hash   - message hash (e.g. a transaction signing hash).
+ *   seckey - 32-byte private key.
+ *   r, s   - receive the signature, 32 bytes big-endian each; s is
+ *            normalized to the lower half of the curve order.
+ *   recid  - if non-NULL, receives the recovery id (0 or 1): the parity
+ *            of R.y, adjusted for the s normalization. This is yParity
+ *            for typed transactions; legacy EIP-155 v = recid + 35 +
+ *            2 * chainId.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. invalid key).
+ */
+int web3c_secp256k1_sign(const web3c_secp256k1_ctx *ctx,
+                         const uint8_t hash[32],
+                         const uint8_t seckey[32],
+                         uint8_t r[32],
+                         uint8_t s[32],
+                         unsigned *recid);
+
+/*
+ * Recover the public key (x || y, 64 bytes big-endian) that produced a
+ * signature over a 32-byte hash.
+ *
+ * Parameters:
+ *   ctx    - initialized context.
+ *   hash   - message hash that was signed.
+ *   r, s   - signature, 32 bytes big-endian each (any s in [1, n-1];
+ *            low-s rules are left to the caller).
+ *   recid  - recovery id as returned by web3c_secp256k1_sign(), 0..3.
+ *   pubkey - receives x || y.
+ *
+ * Returns:
+ *   0 on success, non-zero if the signature is invalid.
+ */
+int web3c_secp256k1_recover(const web3c_secp256k1_ctx *ctx,
+                            const uint8_t hash[32],
+                            const uint8_t r[32],
+                            const uint8_t s[32],
+                            unsigned recid,
+                            uint8_t pubkey[64]);
+
+/*
+ * Recover the signer addresses of n signatures at once.
+ *
+ * Equivalent to web3c_secp256k1_recover() plus keccak256 on each
+ * signature, but blocks of signatures share one scalar inversion (for
+ * r^-1) and two field inversions (table and result normalization), and
+ * the public keys are hashed with web3c_keccak256_batch().
+ *
+ * Parameters:
+ *   ctx       - initialized context.
+ *   hashes    - n message hashes.
+ *   sigs      - n signatures, r || s (64 bytes big-endian).
+ *   recids    - n recovery ids, 0..3.
+ *   n         - number of signatures.
+ *   addresses - receive the n signer addresses; all zero for invalid
+ *               signatures.
+ *   status    - if non-NULL, status[i] is 0 when signature i was
+ *               recovered and non-zero when it is invalid.
+ *
+ * Returns:
+ *   0 if every signature was recovered, non-zero otherwise (including
+ *   NULL arguments, in which case nothing is written).
+ */
+int web3c_secp256k1_recover_batch(const web3c_secp256k1_ctx *ctx,
+                                  const uint8_t (*hashes)[32],
+                                  const uint8_t (*sigs)[64],
+                                  const unsigned *recids,
+                                  size_t n,
+                                  uint8_t (*addresses)[20],
+                                  int *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEB3C_SECP256K1_H */
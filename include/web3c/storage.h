@@ -0,0 +1,128 @@
+#ifndef WEB3C_STORAGE_H
+#define WEB3C_STORAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Solidity storage-slot derivation.
+ *
+ *   mapping(K => V) at slot p:  value of key k lives at
+ *                               keccak256(pad32(k) ++ p)
+ *   T[] at slot p:              element i lives at keccak256(p) + i
+ *   nested mappings:            apply the mapping rule once per key,
+ *                               outermost key first
+ *
+ * Keys and slots are 32-byte big-endian words in the same layout as
+ * web3c_abi_encode_uint256() / web3c_abi_encode_address() produce. The
+ * batch forms hash through web3c_keccak256_batch() and never allocate.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Slot of mapping[key] for a mapping declared at `slot`.
+ *
+ * Parameters:
+ *   key  - 32-byte key word (e.g. from web3c_abi_encode_uint256()).
+ *   slot - 32-byte slot of the mapping.
+ *   out  - receives the 32-byte storage slot.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_storage_mapping_slot(const uint8_t key[32],
+                               const uint8_t slot[32],
+                               uint8_t out[32]);
+
+/*
+ * Slot of mapping[address] (e.g. ERC-20 balances) for a mapping at `slot`.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_storage_mapping_slot_address(const uint8_t address[20],
+                                       const uint8_t slot[32],
+                                       uint8_t out[32]);
+
+/*
+ * Slot of element `index` of a dynamic array declared at `slot`:
+ * keccak256(slot) + index (mod 2^256). For elements wider than one
+ * word, pass index * words_per_element.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_storage_array_slot(const uint8_t slot[32],
+                             uint64_t index,
+                             uint8_t out[32]);
+
+/*
+ * Slot of mapping[keys[0]][keys[1]]...[keys[depth - 1]] for a nested
+ * mapping declared at `slot` (e.g. ERC-20 allowances with depth 2).
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. depth == 0).
+ */
+int web3c_storage_nested_slot(const uint8_t (*keys)[32],
+                              size_t depth,
+                              const uint8_t slot[32],
+                              uint8_t out[32]);
+
+/*
+ * Batch form of web3c_storage_mapping_slot(): outs[i] is the slot of
+ * mapping[keys[i]] for one mapping at `slot`.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_storage_mapping_slots(const uint8_t (*keys)[32],
+                                size_t n,
+                                const uint8_t slot[32],
+                                uint8_t (*outs)[32]);
+
+/*
+ * Batch form of web3c_storage_mapping_slot_address(): outs[i] is the
+ * slot of mapping[addresses[i]], e.g. the balances of many holders.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_storage_mapping_slots_address(const uint8_t (*addresses)[20],
+                                        size_t n,
+                                        const uint8_t slot[32],
+                                        uint8_t (*outs)[32]);
+
+/*
+ * Batch form of web3c_storage_array_slot() for indexes
+ * first_index .. first_index + n - 1 (one hash in total).
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_storage_array_slots(const uint8_t slot[32],
+                              uint64_t first_index,
+                              size_t n,
+                              uint8_t (*outs)[32]);
+
+/*
+ * Batch form of web3c_storage_nested_slot() for n key chains of equal
+ * depth. keys holds n * depth words, chain by chain: key d of chain i is
+ * keys[i * depth + d]. Chains are hashed level by level in batches.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_storage_nested_slots(const uint8_t (*keys)[32],
+                               size_t depth,
+                               size_t n,
+                               const uint8_t slot[32],
+                               uint8_t (*outs)[32]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEB3C_STORAGE_H */
@@ -0,0 +1,51 @@
+#ifndef WEB3C_TRIE_H
+#define WEB3C_TRIE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Merkle Patricia trie roots for ordered lists (transactionsRoot,
+ * receiptsRoot, withdrawalsRoot).
+ *
+ * The trie maps rlp(i) -> items[i]. Because the keys are known up front
+ * the root is computed by a streaming builder that walks the keys in
+ * sorted order and keeps only the open path on the stack; the trie is
+ * never materialized. Node hashes are deferred and flushed in batches
+ * through web3c_keccak256_batch().
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Root of the empty trie: keccak256(rlp("")).
+ * 56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421
+ */
+extern const uint8_t web3c_trie_empty_root[32];
+
+/*
+ * Compute the ordered-trie root of n RLP-encoded items.
+ *
+ * Parameters:
+ *   items - array of n item pointers, e.g. outputs of
+ *           web3c_tx_legacy_rlp_encode() (an entry may be NULL if its
+ *           length is zero).
+ *   lens  - array of n item lengths in bytes.
+ *   n     - number of items (0 yields web3c_trie_empty_root).
+ *   root  - receives the 32-byte root hash.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL pointers).
+ */
+int web3c_trie_ordered_root(const uint8_t *const *items,
+                            const size_t *lens,
+                            size_t n,
+                            uint8_t root[32]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEB3C_TRIE_H */
@@ -4,12 +4,16 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "rlp.h"
+#include "secp256k1.h"
+
 /*
  * Transaction primitives for Ethereum-like (EVM) chains.
  *
- * This module currently focuses on a legacy (pre-EIP-1559) transaction
- * representation, without any RLP encoding. The goal is to provide a
- * small, explicit struct that tooling can work with and validate.
+ * This module provides a legacy (pre-EIP-1559) transaction and an
+ * EIP-1559 (type-2) transaction, with their RLP encodings and signing
+ * preimages. The goal is to provide small, explicit structs that tooling
+ * can work with and validate.
  */
 
 #ifdef __cplusplus
@@ -129,6 +133,311 @@ int web3c_tx_legacy_rlp_encode(const web3c_tx_legacy *tx,
                                size_t out_size,
                                size_t *out_len);
 
+/* Segments produced by web3c_tx_legacy_rlp_encode_iov(). */
+#define WEB3C_TX_IOV_MAX 3
+
+/* Scratch bytes needed by web3c_tx_legacy_rlp_encode_iov(). */
+#define WEB3C_TX_IOV_SCRATCH 128
+
+/* Calldata up to this many bytes is copied into scratch, not referenced. */
+#define WEB3C_TX_IOV_INLINE 32
+
+/*
+ * Encode the same list as web3c_tx_legacy_rlp_encode(), but as a
+ * scatter/gather list: headers and scalar fields go into scratch, and
+ * calldata longer than WEB3C_TX_IOV_INLINE is referenced in place rather
+ * than copied. Concatenating iov[0 .. *iov_count) gives the encoding.
+ *
+ * The segments point into scratch and tx->data; both must outlive them.
+ *
+ * Parameters:
+ *   tx        - transaction to encode (must be valid).
+ *   scratch   - caller buffer for headers and scalar fields.
+ *   iov       - receives up to WEB3C_TX_IOV_MAX segments.
+ *   iov_count - receives the number of segments used (1 or 3).
+ *   out_len   - if non-NULL, receives the total encoded length.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_tx_legacy_rlp_encode_iov(const web3c_tx_legacy *tx,
+                                   uint8_t scratch[WEB3C_TX_IOV_SCRATCH],
+                                   web3c_rlp_iovec iov[WEB3C_TX_IOV_MAX],
+                                   size_t *iov_count,
+                                   size_t *out_len);
+
+/*
+ * Signing hash of a legacy transaction: keccak256 of the unsigned EIP-155
+ * preimage, hashed from the scatter/gather segments of
+ * web3c_tx_legacy_rlp_encode_iov() so large calldata is not copied.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. invalid tx).
+ */
+int web3c_tx_legacy_signing_hash(const web3c_tx_legacy *tx, uint8_t out[32]);
+
+/*
+ * Size / encoding of a signed legacy transaction:
+ *
+ *   [nonce, gasPrice, gasLimit, to, value, data, v, r, s]
+ *
+ * Parameters:
+ *   tx   - transaction (must be valid).
+ *   v    - recovery value, recid + 35 + 2 * chainId (EIP-155).
+ *   r, s - signature values, 256-bit big-endian.
+ *   out, out_size, out_len - as for web3c_tx_legacy_rlp_encode().
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_tx_legacy_signed_rlp_size(const web3c_tx_legacy *tx,
+                                    uint64_t v,
+                                    const uint8_t r[32],
+                                    const uint8_t s[32],
+                                    size_t *out_size);
+int web3c_tx_legacy_signed_rlp_encode(const web3c_tx_legacy *tx,
+                                      uint64_t v,
+                                      const uint8_t r[32],
+                                      const uint8_t s[32],
+                                      uint8_t *out,
+                                      size_t out_size,
+                                      size_t *out_len);
+
+/*
+ * Sign a legacy transaction (EIP-155) and encode it, ready for
+ * eth_sendRawTransaction: signing hash, deterministic ECDSA signature
+ * (web3c_secp256k1_sign()) and signed encoding in one call.
+ *
+ * The signed encoding is at most 67 bytes longer than
+ * web3c_tx_legacy_rlp_size() reports for the unsigned preimage.
+ *
+ * Parameters:
+ *   ctx    - initialized secp256k1 context.
+ *   tx     - transaction (must be valid).
+ *   seckey - 32-byte private key.
+ *   out, out_size, out_len - as for web3c_tx_legacy_rlp_encode().
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_tx_legacy_sign(const web3c_secp256k1_ctx *ctx,
+                         const web3c_tx_legacy *tx,
+                         const uint8_t seckey[32],
+                         uint8_t *out,
+                         size_t out_size,
+                         size_t *out_len);
+
+/*
+ * EIP-2930 access list in structure-of-arrays form:
+ *
+ *   [[address, [key, key, ...]], ...]
+ *
+ * Addresses and storage keys each live in one contiguous array; address
+ * i owns key_counts[i] keys starting at keys[key_offsets[i]]. With
+ * key_offsets == NULL the keys of each address follow those of the
+ * previous one (offsets are the running sum of the counts).
+ *
+ * All arrays are owned by the caller.
+ */
+typedef struct {
+    const uint8_t (*addresses)[20]; /* n_addresses addresses */
+    const size_t   *key_offsets;    /* per address, or NULL */
+    const size_t   *key_counts;     /* per address */
+    size_t          n_addresses;
+
+    const uint8_t (*keys)[32];      /* n_keys storage keys */
+    size_t          n_keys;
+} web3c_access_list;
+
+/*
+ * Size / RLP encoding of an access list.
+ *
+ * Every item is fixed-size (addresses 21 bytes, keys 33 bytes encoded),
+ * so the nested list sizes come from one arithmetic sweep over the
+ * counts; encoding then writes each header and item once, without a
+ * per-element encoder call.
+ *
+ * The encoding is what web3c_tx_1559_set_access_list() takes. It does
+ * not depend on fees, so a fee-bumping loop encodes it once.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (NULL arrays with non-zero counts,
+ *   key ranges outside keys[0 .. n_keys), buffer too small).
+ */
+int web3c_access_list_rlp_size(const web3c_access_list *al, size_t *out_size);
+int web3c_access_list_rlp_encode(const web3c_access_list *al,
+                                 uint8_t *out,
+                                 size_t out_size,
+                                 size_t *out_len);
+
+/* EIP-2718 type byte of EIP-1559 transactions. */
+#define WEB3C_TX_TYPE_1559 0x02
+
+/*
+ * EIP-1559 (type-2) transaction.
+ *
+ * Gas and fee fields are uint64_t (2^64 wei per gas is far above any
+ * real fee); value is a 256-bit big-endian word, as wei amounts routinely
+ * exceed 64 bits.
+ *
+ * The access list is given already RLP-encoded, as one complete list
+ * item; NULL / 0 means the empty list.
+ */
+typedef struct {
+    uint64_t chain_id;
+    uint64_t nonce;
+    uint64_t max_priority_fee_per_gas;
+    uint64_t max_fee_per_gas;
+    uint64_t gas_limit;
+
+    int      has_to;     /* 0 = contract creation, 1 = call to address. */
+    uint8_t  to[20];     /* Recipient address (ignored if has_to == 0). */
+
+    uint8_t  value[32];  /* Amount in wei, 256-bit big-endian. */
+
+    const uint8_t *data; /* Call data (owned by caller). */
+    size_t        data_len;
+
+    const uint8_t *access_list; /* Encoded access list (owned by caller). */
+    size_t        access_list_len;
+} web3c_tx_1559;
+
+/*
+ * Initialize an EIP-1559 transaction: all fields zero, no recipient, no
+ * data, empty access list.
+ */
+void web3c_tx_1559_init(web3c_tx_1559 *tx);
+
+/*
+ * Set the recipient / call data / encoded access list. No copies are
+ * made; the caller keeps the buffers alive.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. NULL tx, NULL data with
+ *   len > 0, or an access list that is not exactly one RLP list).
+ */
+int web3c_tx_1559_set_to(web3c_tx_1559 *tx, const uint8_t to[20]);
+int web3c_tx_1559_set_data(web3c_tx_1559 *tx, const uint8_t *data, size_t len);
+int web3c_tx_1559_set_access_list(web3c_tx_1559 *tx,
+                                  const uint8_t *encoded,
+                                  size_t len);
+
+/*
+ * Validate an EIP-1559 transaction for basic sanity:
+ *
+ *   - chain_id and gas_limit must be non-zero.
+ *   - max_priority_fee_per_gas must not exceed max_fee_per_gas.
+ *   - data / access_list pointers must be consistent with their lengths.
+ *
+ * Returns:
+ *   0 if the transaction looks valid, non-zero otherwise.
+ */
+int web3c_tx_1559_validate(const web3c_tx_1559 *tx);
+
+/*
+ * Size / encoding of the unsigned typed envelope, which is the signing
+ * preimage:
+ *
+ *   0x02 || rlp([chainId, nonce, maxPriorityFeePerGas, maxFeePerGas,
+ *                gasLimit, to, value, data, accessList])
+ *
+ * Sizes are computed arithmetically and every field is written once.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (invalid tx, buffer too small).
+ */
+int web3c_tx_1559_rlp_size(const web3c_tx_1559 *tx, size_t *out_size);
+int web3c_tx_1559_rlp_encode(const web3c_tx_1559 *tx,
+                             uint8_t *out,
+                             size_t out_size,
+                             size_t *out_len);
+
+/*
+ * Signing hash: keccak256 of the unsigned envelope.
+ *
+ * The envelope is never materialized: the scalar fields are encoded into
+ * a small stack buffer and absorbed, then data and the access list are
+ * absorbed in place. No allocation, one pass over the calldata, so it
+ * can be re-run cheaply after changing a fee field.
+ *
+ * Returns:
+ *   0 on success, non-zero on error (e.g. invalid tx).
+ */
+int web3c_tx_1559_signing_hash(const web3c_tx_1559 *tx, uint8_t out[32]);
+
+/*
+ * Size / encoding of the signed envelope, ready for
+ * eth_sendRawTransaction:
+ *
+ *   0x02 || rlp([chainId, ..., accessList, yParity, r, s])
+ *
+ * Parameters:
+ *   tx       - transaction (must be valid).
+ *   y_parity - signature recovery bit (0 or 1).
+ *   r, s     - signature values, 256-bit big-endian.
+ *   out, out_size, out_len - as for web3c_tx_1559_rlp_encode().
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_tx_1559_signed_rlp_size(const web3c_tx_1559 *tx,
+                                  const uint8_t r[32],
+                                  const uint8_t s[32],
+                                  size_t *out_size);
+int web3c_tx_1559_signed_rlp_encode(const web3c_tx_1559 *tx,
+                                    unsigned y_parity,
+                                    const uint8_t r[32],
+                                    const uint8_t s[32],
+                                    uint8_t *out,
+                                    size_t out_size,
+                                    size_t *out_len);
+
+/*
+ * Sign an EIP-1559 transaction and encode the signed envelope:
+ * web3c_tx_1559_signing_hash(), web3c_secp256k1_sign() and
+ * web3c_tx_1559_signed_rlp_encode() in one call.
+ *
+ * Returns:
+ *   0 on success, non-zero on error.
+ */
+int web3c_tx_1559_sign(const web3c_secp256k1_ctx *ctx,
+                       const web3c_tx_1559 *tx,
+                       const uint8_t seckey[32],
+                       uint8_t *out,
+                       size_t out_size,
+                       size_t *out_len);
+
+/*
+ * Recover the senders of n raw signed transactions, as they appear in a
+ * block body or eth_sendRawTransaction: legacy (pre-EIP-155 v = 27/28
+ * or EIP-155), EIP-2930 (0x01 || rlp) and EIP-1559 (0x02 || rlp).
+ *
+ * Signing hashes are streamed from the raw bytes (the unsigned fields
+ * are a contiguous span of the signed encoding, so nothing is
+ * re-encoded), then web3c_secp256k1_recover_batch() recovers the whole
+ * batch. s must be in the lower half of the curve order (EIP-2).
+ *
+ * Parameters:
+ *   ctx     - initialized secp256k1 context.
+ *   raw_txs - n pointers to encoded transactions.
+ *   lens    - their lengths; each encoding must be exactly one item.
+ *   n       - number of transactions.
+ *   senders - receive the n sender addresses; all zero for transactions
+ *             that are malformed or carry an invalid signature.
+ *   status  - if non-NULL, status[i] is 0 when sender i was recovered
+ *             and non-zero otherwise.
+ *
+ * Returns:
+ *   0 if every sender was recovered, non-zero otherwise (including NULL
+ *   arguments, in which case nothing is written).
+ */
+int web3c_recover_senders(const web3c_secp256k1_ctx *ctx,
+                          const uint8_t *const *raw_txs,
+                          const size_t *lens,
+                          size_t n,
+                          uint8_t (*senders)[20],
+                          int *status);
+
 #ifdef __cplusplus
 }
 #endif
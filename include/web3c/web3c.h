@@ -13,5 +13,12 @@
 #include "keccak.h"
 #include "tx.h"
 #include "rlp.h"
+#include "create.h"
+#include "trie.h"
+#include "bloom.h"
+#include "storage.h"
+#include "address.h"
+#include "rpc.h"
+#include "secp256k1.h"
 
 #endif /* WEB3C_WEB3C_H */
\ No newline at end of file
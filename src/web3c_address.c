@@ -0,0 +1,121 @@
+#include "web3c/address.h"
+#include "web3c/hex.h"
+#include "web3c/keccak.h"
+
+#include <string.h>
+
+/* Addresses per web3c_keccak256_batch() call. */
+#define WEB3C_ADDRESS_BATCH 64
+
+/*
+ * Uppercase the letters of 40 lowercase hex digits whose hash nibble is
+ * >= 8. Branch-free so the compiler can vectorize it.
+ */
+static void web3c_address_mix_case(char digits[40], const uint8_t hash[32])
+{
+    for (size_t i = 0; i < 40; ++i) {
+        uint8_t nib    = (i % 2 == 0) ? (uint8_t)(hash[i / 2] >> 4)
+                                      : (uint8_t)(hash[i / 2] & 0x0F);
+        uint8_t letter = (uint8_t)(digits[i] >= 'a');
+        uint8_t upper  = (uint8_t)(nib >> 3);
+
+        digits[i] = (char)(digits[i] ^ ((letter & upper) << 5));
+    }
+}
+
+int web3c_address_to_checksum(const uint8_t address[20],
+                              char out[WEB3C_ADDRESS_CHECKSUM_SIZE])
+{
+    uint8_t hash[32];
+
+    if (address == NULL || out == NULL) {
+        return -1;
+    }
+
+    out[0] = '0';
+    out[1] = 'x';
+    if (web3c_hex_encode(address, 20, out + 2, WEB3C_ADDRESS_CHECKSUM_SIZE - 2) != 0 ||
+        web3c_keccak256((const uint8_t *)out + 2, 40, hash) != 0) {
+        return -1;
+    }
+
+    web3c_address_mix_case(out + 2, hash);
+    return 0;
+}
+
+int web3c_address_validate_checksum(const char *str,
+                                    size_t len,
+                                    uint8_t address[20])
+{
+    uint8_t bytes[20];
+    char    expected[WEB3C_ADDRESS_CHECKSUM_SIZE];
+
+    if (str == NULL) {
+        return -1;
+    }
+
+    if (len == 42) {
+        if (str[0] != '0' || (str[1] != 'x' && str[1] != 'X')) {
+            return -1;
+        }
+        str += 2;
+        len -= 2;
+    }
+    if (len != 40) {
+        return -1;
+    }
+
+    if (web3c_hex_decode_n(str, 40, bytes, sizeof(bytes), NULL) != 20 ||
+        web3c_address_to_checksum(bytes, expected) != 0) {
+        return -1;
+    }
+
+    if (memcmp(str, expected + 2, 40) != 0) {
+        return -1;
+    }
+
+    if (address) {
+        memcpy(address, bytes, 20);
+    }
+    return 0;
+}
+
+int web3c_address_to_checksum_batch(const uint8_t (*addresses)[20],
+                                    size_t n,
+                                    char (*outs)[WEB3C_ADDRESS_CHECKSUM_SIZE])
+{
+    const uint8_t *in[WEB3C_ADDRESS_BATCH];
+    size_t         lens[WEB3C_ADDRESS_BATCH];
+    uint8_t        hash[WEB3C_ADDRESS_BATCH][32];
+
+    if (n > 0 && (addresses == NULL || outs == NULL)) {
+        return -1;
+    }
+
+    for (size_t done = 0; done < n; ) {
+        size_t m = n - done < WEB3C_ADDRESS_BATCH ? n - done : WEB3C_ADDRESS_BATCH;
+
+        /* Lowercase digits go straight into the outputs and are hashed there. */
+        for (size_t j = 0; j < m; ++j) {
+            char *out = outs[done + j];
+
+            out[0] = '0';
+            out[1] = 'x';
+            web3c_hex_encode(addresses[done + j], 20, out + 2,
+                             WEB3C_ADDRESS_CHECKSUM_SIZE - 2);
+            in[j]   = (const uint8_t *)out + 2;
+            lens[j] = 40;
+        }
+
+        if (web3c_keccak256_batch(in, lens, hash, m) != 0) {
+            return -1;
+        }
+
+        for (size_t j = 0; j < m; ++j) {
+            web3c_address_mix_case(outs[done + j] + 2, hash[j]);
+        }
+        done += m;
+    }
+
+    return 0;
+}
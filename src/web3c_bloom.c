@@ -0,0 +1,259 @@
+#include "web3c/bloom.h"
+#include "web3c/keccak.h"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define WEB3C_BLOOM_X86 1
+#include <immintrin.h>
+#endif
+
+#define WEB3C_BLOOM_WORDS (WEB3C_BLOOM_SIZE / 8)
+
+int web3c_bloom_add(uint8_t bloom[WEB3C_BLOOM_SIZE],
+                    const uint8_t *data,
+                    size_t len)
+{
+    uint8_t h[32];
+
+    if (bloom == NULL || (data == NULL && len != 0)) {
+        return -1;
+    }
+
+    if (web3c_keccak256(data, len, h) != 0) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < 6; i += 2) {
+        unsigned bit = (((unsigned)h[i] << 8) | h[i + 1]) & 2047u;
+        bloom[WEB3C_BLOOM_SIZE - 1 - bit / 8] |= (uint8_t)(1u << (bit % 8));
+    }
+
+    return 0;
+}
+
+int web3c_bloom_add_log(uint8_t bloom[WEB3C_BLOOM_SIZE],
+                        const uint8_t address[20],
+                        const uint8_t (*topics)[32],
+                        size_t n_topics)
+{
+    if (bloom == NULL || address == NULL || (n_topics > 0 && topics == NULL)) {
+        return -1;
+    }
+
+    if (web3c_bloom_add(bloom, address, 20) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < n_topics; ++i) {
+        if (web3c_bloom_add(bloom, topics[i], 32) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void web3c_bloom_or(uint8_t dst[WEB3C_BLOOM_SIZE],
+                    const uint8_t src[WEB3C_BLOOM_SIZE])
+{
+    if (dst == NULL || src == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < WEB3C_BLOOM_SIZE; ++i) {
+        dst[i] |= src[i];
+    }
+}
+
+/* Portable subset test on 64-bit words: (mask & ~row) == 0. */
+static int web3c_bloom_match_words(const uint8_t *row, const uint8_t *mask)
+{
+    uint64_t miss = 0;
+
+    for (size_t i = 0; i < WEB3C_BLOOM_WORDS; ++i) {
+        uint64_t r;
+        uint64_t m;
+        memcpy(&r, row + 8 * i, 8);
+        memcpy(&m, mask + 8 * i, 8);
+        miss |= m & ~r;
+    }
+
+    return miss == 0;
+}
+
+int web3c_bloom_match(const uint8_t bloom[WEB3C_BLOOM_SIZE],
+                      const uint8_t mask[WEB3C_BLOOM_SIZE])
+{
+    if (bloom == NULL || mask == NULL) {
+        return 0;
+    }
+
+    return web3c_bloom_match_words(bloom, mask);
+}
+
+int web3c_bloom_contains(const uint8_t bloom[WEB3C_BLOOM_SIZE],
+                         const uint8_t *data,
+                         size_t len)
+{
+    uint8_t mask[WEB3C_BLOOM_SIZE];
+
+    if (bloom == NULL) {
+        return -1;
+    }
+
+    memset(mask, 0, sizeof(mask));
+    if (web3c_bloom_add(mask, data, len) != 0) {
+        return -1;
+    }
+
+    return web3c_bloom_match_words(bloom, mask);
+}
+
+/* ---- Scan kernels: each row is loaded once and tested against all masks. */
+
+static size_t web3c_bloom_scan_scalar(const uint8_t *rows,
+                                      size_t n_rows,
+                                      const uint8_t (*masks)[WEB3C_BLOOM_SIZE],
+                                      size_t n_masks,
+                                      uint64_t *hits,
+                                      size_t words)
+{
+    size_t total = 0;
+
+    for (size_t r = 0; r < n_rows; ++r) {
+        const uint8_t *row = rows + r * WEB3C_BLOOM_SIZE;
+
+        for (size_t m = 0; m < n_masks; ++m) {
+            if (web3c_bloom_match_words(row, masks[m])) {
+                hits[m * words + r / 64] |= (uint64_t)1 << (r % 64);
+                ++total;
+            }
+        }
+    }
+
+    return total;
+}
+
+#ifdef WEB3C_BLOOM_X86
+
+__attribute__((target("avx2")))
+static size_t web3c_bloom_scan_avx2(const uint8_t *rows,
+                                    size_t n_rows,
+                                    const uint8_t (*masks)[WEB3C_BLOOM_SIZE],
+                                    size_t n_masks,
+                                    uint64_t *hits,
+                                    size_t words)
+{
+    size_t total = 0;
+
+    for (size_t r = 0; r < n_rows; ++r) {
+        const __m256i *row = (const __m256i *)(rows + r * WEB3C_BLOOM_SIZE);
+        __m256i r0 = _mm256_loadu_si256(row + 0);
+        __m256i r1 = _mm256_loadu_si256(row + 1);
+        __m256i r2 = _mm256_loadu_si256(row + 2);
+        __m256i r3 = _mm256_loadu_si256(row + 3);
+        __m256i r4 = _mm256_loadu_si256(row + 4);
+        __m256i r5 = _mm256_loadu_si256(row + 5);
+        __m256i r6 = _mm256_loadu_si256(row + 6);
+        __m256i r7 = _mm256_loadu_si256(row + 7);
+
+        for (size_t m = 0; m < n_masks; ++m) {
+            const __m256i *mk = (const __m256i *)masks[m];
+
+            /* Bits wanted by the mask but missing from the row. */
+            __m256i miss = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_or_si256(_mm256_andnot_si256(r0, _mm256_loadu_si256(mk + 0)),
+                                    _mm256_andnot_si256(r1, _mm256_loadu_si256(mk + 1))),
+                    _mm256_or_si256(_mm256_andnot_si256(r2, _mm256_loadu_si256(mk + 2)),
+                                    _mm256_andnot_si256(r3, _mm256_loadu_si256(mk + 3)))),
+                _mm256_or_si256(
+                    _mm256_or_si256(_mm256_andnot_si256(r4, _mm256_loadu_si256(mk + 4)),
+                                    _mm256_andnot_si256(r5, _mm256_loadu_si256(mk + 5))),
+                    _mm256_or_si256(_mm256_andnot_si256(r6, _mm256_loadu_si256(mk + 6)),
+                                    _mm256_andnot_si256(r7, _mm256_loadu_si256(mk + 7)))));
+
+            if (_mm256_testz_si256(miss, miss)) {
+                hits[m * words + r / 64] |= (uint64_t)1 << (r % 64);
+                ++total;
+            }
+        }
+    }
+
+    return total;
+}
+
+__attribute__((target("avx512f")))
+static size_t web3c_bloom_scan_avx512(const uint8_t *rows,
+                                      size_t n_rows,
+                                      const uint8_t (*masks)[WEB3C_BLOOM_SIZE],
+                                      size_t n_masks,
+                                      uint64_t *hits,
+                                      size_t words)
+{
+    size_t total = 0;
+
+    for (size_t r = 0; r < n_rows; ++r) {
+        const uint8_t *row = rows + r * WEB3C_BLOOM_SIZE;
+        __m512i r0 = _mm512_loadu_si512(row + 0);
+        __m512i r1 = _mm512_loadu_si512(row + 64);
+        __m512i r2 = _mm512_loadu_si512(row + 128);
+        __m512i r3 = _mm512_loadu_si512(row + 192);
+
+        for (size_t m = 0; m < n_masks; ++m) {
+            const uint8_t *mk = masks[m];
+
+            /* miss |= mask & ~row, one vpternlogq (0xF2) per vector. */
+            __m512i miss = _mm512_andnot_si512(r0, _mm512_loadu_si512(mk + 0));
+            miss = _mm512_ternarylogic_epi64(miss, r1, _mm512_loadu_si512(mk + 64), 0xF2);
+            miss = _mm512_ternarylogic_epi64(miss, r2, _mm512_loadu_si512(mk + 128), 0xF2);
+            miss = _mm512_ternarylogic_epi64(miss, r3, _mm512_loadu_si512(mk + 192), 0xF2);
+
+            if (_mm512_test_epi64_mask(miss, miss) == 0) {
+                hits[m * words + r / 64] |= (uint64_t)1 << (r % 64);
+                ++total;
+            }
+        }
+    }
+
+    return total;
+}
+
+#endif /* WEB3C_BLOOM_X86 */
+
+int web3c_bloom_scan(const uint8_t *rows,
+                     size_t n_rows,
+                     const uint8_t (*masks)[WEB3C_BLOOM_SIZE],
+                     size_t n_masks,
+                     uint64_t *hits,
+                     size_t *n_hits)
+{
+    size_t words = WEB3C_BLOOM_HITS_WORDS(n_rows);
+    size_t total;
+
+    if ((n_rows > 0 && rows == NULL) ||
+        (n_masks > 0 && (masks == NULL || (words > 0 && hits == NULL)))) {
+        return -1;
+    }
+
+    if (n_masks > 0 && words > 0) {
+        memset(hits, 0, n_masks * words * sizeof(uint64_t));
+    }
+
+#ifdef WEB3C_BLOOM_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        total = web3c_bloom_scan_avx512(rows, n_rows, masks, n_masks, hits, words);
+    } else if (__builtin_cpu_supports("avx2")) {
+        total = web3c_bloom_scan_avx2(rows, n_rows, masks, n_masks, hits, words);
+    } else
+#endif
+    {
+        total = web3c_bloom_scan_scalar(rows, n_rows, masks, n_masks, hits, words);
+    }
+
+    if (n_hits) {
+        *n_hits = total;
+    }
+    return 0;
+}
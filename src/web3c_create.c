@@ -0,0 +1,628 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "web3c/create.h"
+#include "web3c/keccak.h"
+#include "web3c/rlp.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Size of the CREATE2 preimage: 0xff ++ deployer ++ salt ++ hash. */
+#define WEB3C_CREATE2_PREIMAGE 85
+
+/* Addresses hashed per web3c_keccak256_batch() call inside workers. */
+#define WEB3C_CREATE_BATCH 64
+
+/* Offset of the salt counter (last 8 salt bytes) inside the preimage. */
+#define WEB3C_CREATE2_COUNTER_OFF (1 + 20 + 24)
+
+static void web3c_create2_preimage(uint8_t pre[WEB3C_CREATE2_PREIMAGE],
+                                   const uint8_t deployer[20],
+                                   const uint8_t salt[32],
+                                   const uint8_t init_code_hash[32])
+{
+    pre[0] = 0xff;
+    memcpy(pre + 1, deployer, 20);
+    memcpy(pre + 21, salt, 32);
+    memcpy(pre + 53, init_code_hash, 32);
+}
+
+static void web3c_store64_be(uint8_t *dst, uint64_t v)
+{
+    for (int i = 7; i >= 0; --i) {
+        dst[i] = (uint8_t)(v & 0xFF);
+        v >>= 8;
+    }
+}
+
+/* Encode rlp([sender, nonce]) into out (at most 31 bytes). */
+static int web3c_create_preimage(const uint8_t sender[20],
+                                 uint64_t nonce,
+                                 uint8_t out[32],
+                                 size_t *out_len)
+{
+    uint8_t payload[32];
+    size_t  len_sender = 0;
+    size_t  len_nonce  = 0;
+    size_t  len_header = 0;
+
+    if (web3c_rlp_encode_bytes(sender, 20, payload, sizeof(payload),
+                               &len_sender) != 0 ||
+        web3c_rlp_encode_uint64(nonce, payload + len_sender,
+                                sizeof(payload) - len_sender, &len_nonce) != 0) {
+        return -1;
+    }
+
+    if (web3c_rlp_encode_list_header(len_sender + len_nonce,
+                                     out, 32, &len_header) != 0) {
+        return -1;
+    }
+    if (len_header + len_sender + len_nonce > 32) {
+        return -1;
+    }
+
+    memcpy(out + len_header, payload, len_sender + len_nonce);
+    *out_len = len_header + len_sender + len_nonce;
+    return 0;
+}
+
+int web3c_create_address(const uint8_t sender[20],
+                         uint64_t nonce,
+                         uint8_t out[20])
+{
+    uint8_t pre[32];
+    uint8_t hash[32];
+    size_t  pre_len = 0;
+
+    if (sender == NULL || out == NULL) {
+        return -1;
+    }
+
+    if (web3c_create_preimage(sender, nonce, pre, &pre_len) != 0 ||
+        web3c_keccak256(pre, pre_len, hash) != 0) {
+        return -1;
+    }
+
+    memcpy(out, hash + 12, 20);
+    return 0;
+}
+
+int web3c_create_address_range(const uint8_t sender[20],
+                               uint64_t first_nonce,
+                               size_t n,
+                               uint8_t (*outs)[20])
+{
+    uint8_t        pre[WEB3C_CREATE_BATCH][32];
+    const uint8_t *in[WEB3C_CREATE_BATCH];
+    size_t         lens[WEB3C_CREATE_BATCH];
+    uint8_t        hash[WEB3C_CREATE_BATCH][32];
+
+    if (sender == NULL || (n > 0 && outs == NULL)) {
+        return -1;
+    }
+
+    for (size_t done = 0; done < n; ) {
+        size_t m = n - done < WEB3C_CREATE_BATCH ? n - done : WEB3C_CREATE_BATCH;
+
+        for (size_t j = 0; j < m; ++j) {
+            if (web3c_create_preimage(sender, first_nonce + done + j,
+                                      pre[j], &lens[j]) != 0) {
+                return -1;
+            }
+            in[j] = pre[j];
+        }
+
+        if (web3c_keccak256_batch(in, lens, hash, m) != 0) {
+            return -1;
+        }
+        for (size_t j = 0; j < m; ++j) {
+            memcpy(outs[done + j], hash[j] + 12, 20);
+        }
+        done += m;
+    }
+
+    return 0;
+}
+
+int web3c_create2_address(const uint8_t deployer[20],
+                          const uint8_t salt[32],
+                          const uint8_t init_code_hash[32],
+                          uint8_t out[20])
+{
+    uint8_t pre[WEB3C_CREATE2_PREIMAGE];
+    uint8_t hash[32];
+
+    if (deployer == NULL || salt == NULL || init_code_hash == NULL || out == NULL) {
+        return -1;
+    }
+
+    web3c_create2_preimage(pre, deployer, salt, init_code_hash);
+    if (web3c_keccak256(pre, sizeof(pre), hash) != 0) {
+        return -1;
+    }
+
+    memcpy(out, hash + 12, 20);
+    return 0;
+}
+
+int web3c_create2_address_batch(const uint8_t deployer[20],
+                                const uint8_t init_code_hash[32],
+                                const uint8_t (*salts)[32],
+                                size_t n,
+                                uint8_t (*outs)[20])
+{
+    uint8_t        pre[WEB3C_CREATE_BATCH][WEB3C_CREATE2_PREIMAGE];
+    const uint8_t *in[WEB3C_CREATE_BATCH];
+    size_t         lens[WEB3C_CREATE_BATCH];
+    uint8_t        hash[WEB3C_CREATE_BATCH][32];
+    static const uint8_t zero_salt[32] = { 0 };
+
+    if (deployer == NULL || init_code_hash == NULL ||
+        (n > 0 && (salts == NULL || outs == NULL))) {
+        return -1;
+    }
+
+    /* Only the salt changes between preimages. */
+    for (size_t j = 0; j < WEB3C_CREATE_BATCH; ++j) {
+        web3c_create2_preimage(pre[j], deployer, zero_salt, init_code_hash);
+        in[j]   = pre[j];
+        lens[j] = WEB3C_CREATE2_PREIMAGE;
+    }
+
+    for (size_t done = 0; done < n; ) {
+        size_t m = n - done < WEB3C_CREATE_BATCH ? n - done : WEB3C_CREATE_BATCH;
+
+        for (size_t j = 0; j < m; ++j) {
+            memcpy(pre[j] + 21, salts[done + j], 32);
+        }
+        if (web3c_keccak256_batch(in, lens, hash, m) != 0) {
+            return -1;
+        }
+        for (size_t j = 0; j < m; ++j) {
+            memcpy(outs[done + j], hash[j] + 12, 20);
+        }
+        done += m;
+    }
+
+    return 0;
+}
+
+/* ---- Address patterns ---- */
+
+static int web3c_hex_nibble(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return 10 + (c - 'a');
+    if (c >= 'A' && c <= 'F') return 10 + (c - 'A');
+    return -1;
+}
+
+/* Constrain nibble `pos` (0 = high nibble of byte 0) to `value`. */
+static void web3c_pattern_set_nibble(web3c_address_pattern *p,
+                                     size_t pos,
+                                     int value)
+{
+    uint8_t shift = (pos % 2 == 0) ? 4 : 0;
+
+    p->mask[pos / 2]    |= (uint8_t)(0x0F << shift);
+    p->pattern[pos / 2] |= (uint8_t)(value << shift);
+}
+
+int web3c_address_pattern_set(web3c_address_pattern *p,
+                              const char *prefix_hex,
+                              const char *suffix_hex)
+{
+    size_t plen = 0;
+    size_t slen = 0;
+
+    if (p == NULL) {
+        return -1;
+    }
+
+    memset(p, 0, sizeof(*p));
+
+    if (prefix_hex != NULL) {
+        if (prefix_hex[0] == '0' && (prefix_hex[1] == 'x' || prefix_hex[1] == 'X')) {
+            prefix_hex += 2;
+        }
+        plen = strlen(prefix_hex);
+    }
+    if (suffix_hex != NULL) {
+        slen = strlen(suffix_hex);
+    }
+
+    if (plen + slen > 40) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < plen; ++i) {
+        int v = web3c_hex_nibble(prefix_hex[i]);
+        if (v < 0) {
+            return -1;
+        }
+        web3c_pattern_set_nibble(p, i, v);
+    }
+
+    for (size_t i = 0; i < slen; ++i) {
+        int v = web3c_hex_nibble(suffix_hex[i]);
+        if (v < 0) {
+            return -1;
+        }
+        web3c_pattern_set_nibble(p, 40 - slen + i, v);
+    }
+
+    return 0;
+}
+
+int web3c_address_pattern_match(const web3c_address_pattern *p,
+                                const uint8_t addr[20])
+{
+    uint8_t diff = 0;
+
+    for (size_t i = 0; i < 20; ++i) {
+        diff |= (uint8_t)((addr[i] & p->mask[i]) ^ p->pattern[i]);
+    }
+
+    return diff == 0;
+}
+
+/* ---- Threading helpers ---- */
+
+static uint64_t web3c_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static unsigned web3c_thread_count(unsigned requested)
+{
+    if (requested == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        requested = online > 0 ? (unsigned)online : 1;
+    }
+    if (requested > WEB3C_CREATE2_MAX_THREADS) {
+        requested = WEB3C_CREATE2_MAX_THREADS;
+    }
+    return requested;
+}
+
+/*
+ * Run `fn(arg)` on `threads` worker threads and wait for all of them.
+ * If a thread cannot be created, `*stop` is raised so the running
+ * workers wind down, and -1 is returned after joining them.
+ */
+static int web3c_run_workers(unsigned threads,
+                             void *(*fn)(void *),
+                             void *arg,
+                             int *stop)
+{
+    pthread_t tid[WEB3C_CREATE2_MAX_THREADS];
+    unsigned  started = 0;
+    int       rc = 0;
+
+    for (; started < threads; ++started) {
+        if (pthread_create(&tid[started], NULL, fn, arg) != 0) {
+            __atomic_store_n(stop, 1, __ATOMIC_RELAXED);
+            rc = -1;
+            break;
+        }
+    }
+
+    for (unsigned i = 0; i < started; ++i) {
+        pthread_join(tid[i], NULL);
+    }
+
+    return rc;
+}
+
+/* ---- Vanity search ---- */
+
+/* A match (or error) in this run, or a stop request from outside. */
+static int web3c_create2_search_halted(web3c_create2_search *s)
+{
+    return __atomic_load_n(&s->done, __ATOMIC_RELAXED) ||
+           __atomic_load_n(&s->stop, __ATOMIC_RELAXED);
+}
+
+static void *web3c_create2_search_worker(void *arg)
+{
+    web3c_create2_search *s = (web3c_create2_search *)arg;
+
+    uint8_t        pre[WEB3C_CREATE_BATCH][WEB3C_CREATE2_PREIMAGE];
+    const uint8_t *in[WEB3C_CREATE_BATCH];
+    size_t         lens[WEB3C_CREATE_BATCH];
+    uint8_t        hash[WEB3C_CREATE_BATCH][32];
+
+    for (size_t j = 0; j < WEB3C_CREATE_BATCH; ++j) {
+        web3c_create2_preimage(pre[j], s->deployer, s->salt_base,
+                               s->init_code_hash);
+        in[j]   = pre[j];
+        lens[j] = WEB3C_CREATE2_PREIMAGE;
+    }
+
+    while (!web3c_create2_search_halted(s)) {
+        uint64_t begin = __atomic_fetch_add(&s->next, s->chunk, __ATOMIC_RELAXED);
+        if (begin >= s->count) {
+            break;
+        }
+        uint64_t end = (s->count - begin < s->chunk) ? s->count : begin + s->chunk;
+
+        for (uint64_t c = begin; c < end; ) {
+            size_t m = (end - c < WEB3C_CREATE_BATCH) ? (size_t)(end - c)
+                                                      : WEB3C_CREATE_BATCH;
+
+            for (size_t j = 0; j < m; ++j) {
+                web3c_store64_be(pre[j] + WEB3C_CREATE2_COUNTER_OFF,
+                                 s->first + c + j);
+            }
+            web3c_keccak256_batch(in, lens, hash, m);
+            __atomic_fetch_add(&s->hashes, (uint64_t)m, __ATOMIC_RELAXED);
+
+            for (size_t j = 0; j < m; ++j) {
+                if (!web3c_address_pattern_match(&s->pattern, hash[j] + 12)) {
+                    continue;
+                }
+
+                /* First finder wins; everybody else stops. */
+                int expected = 0;
+                if (__atomic_compare_exchange_n(&s->found, &expected, 1, 0,
+                                                __ATOMIC_ACQ_REL,
+                                                __ATOMIC_RELAXED)) {
+                    memcpy(s->salt, pre[j] + 21, 32);
+                    memcpy(s->address, hash[j] + 12, 20);
+                }
+                __atomic_store_n(&s->done, 1, __ATOMIC_RELEASE);
+                return NULL;
+            }
+
+            c += m;
+            if (web3c_create2_search_halted(s)) {
+                return NULL;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void web3c_create2_search_init(web3c_create2_search *s)
+{
+    if (s == NULL) {
+        return;
+    }
+
+    memset(s, 0, sizeof(*s));
+}
+
+void web3c_create2_search_reset(web3c_create2_search *s)
+{
+    if (s == NULL) {
+        return;
+    }
+
+    __atomic_store_n(&s->hashes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->start_ns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->found, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->stop, 0, __ATOMIC_RELAXED);
+    s->stopped = 0;
+    s->done    = 0;
+    s->next    = 0;
+}
+
+int web3c_create2_search_run(web3c_create2_search *s)
+{
+    if (s == NULL) {
+        return -1;
+    }
+
+    if (s->chunk == 0) {
+        s->chunk = WEB3C_CREATE2_DEFAULT_CHUNK;
+    }
+
+    /*
+     * stop is left alone: a web3c_create2_search_stop() from another
+     * thread may already have landed. Matches end the run through done
+     * instead, so they leave no stale request behind. The progress
+     * fields are read concurrently by web3c_create2_search_progress().
+     */
+    __atomic_store_n(&s->hashes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->start_ns, web3c_now_ns(), __ATOMIC_RELAXED);
+    __atomic_store_n(&s->found, 0, __ATOMIC_RELAXED);
+    s->stopped = 0;
+    s->done    = 0;
+    s->next    = 0;
+
+    int rc = web3c_run_workers(web3c_thread_count(s->threads),
+                               web3c_create2_search_worker, s, &s->done);
+
+    s->stopped = !s->found && __atomic_load_n(&s->stop, __ATOMIC_ACQUIRE);
+    return rc;
+}
+
+void web3c_create2_search_stop(web3c_create2_search *s)
+{
+    if (s == NULL) {
+        return;
+    }
+
+    __atomic_store_n(&s->stop, 1, __ATOMIC_RELAXED);
+}
+
+/* Snapshot of a (hashes, start_ns) pair written by running workers. */
+static void web3c_progress_snapshot(const uint64_t *hashes_field,
+                                    const uint64_t *start_field,
+                                    uint64_t *hashes,
+                                    double *hashes_per_sec)
+{
+    uint64_t done = __atomic_load_n(hashes_field, __ATOMIC_RELAXED);
+
+    if (hashes) {
+        *hashes = done;
+    }
+    if (hashes_per_sec) {
+        uint64_t start   = __atomic_load_n(start_field, __ATOMIC_RELAXED);
+        uint64_t elapsed = start ? web3c_now_ns() - start : 0;
+        *hashes_per_sec = elapsed ? (double)done * 1e9 / (double)elapsed : 0.0;
+    }
+}
+
+void web3c_create2_search_progress(const web3c_create2_search *s,
+                                   uint64_t *hashes,
+                                   double *hashes_per_sec)
+{
+    if (s == NULL) {
+        return;
+    }
+
+    web3c_progress_snapshot(&s->hashes, &s->start_ns, hashes, hashes_per_sec);
+}
+
+void web3c_create2_progress_read(const web3c_create2_progress *p,
+                                 uint64_t *hashes,
+                                 double *hashes_per_sec)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    web3c_progress_snapshot(&p->hashes, &p->start_ns, hashes, hashes_per_sec);
+}
+
+/* ---- Bulk precomputation ---- */
+
+typedef struct {
+    const uint8_t       *deployer;
+    const uint8_t       *init_code_hash;
+    const uint8_t      (*salts)[32];
+    size_t               n;
+    web3c_create2_entry *table;
+    size_t               next;
+    int                  stop;
+    web3c_create2_progress *progress;   /* may be NULL */
+} web3c_create2_precompute_job;
+
+static void *web3c_create2_precompute_worker(void *arg)
+{
+    web3c_create2_precompute_job *job = (web3c_create2_precompute_job *)arg;
+    uint8_t outs[WEB3C_CREATE_BATCH][20];
+
+    while (!__atomic_load_n(&job->stop, __ATOMIC_RELAXED)) {
+        size_t begin = __atomic_fetch_add(&job->next, WEB3C_CREATE2_DEFAULT_CHUNK,
+                                          __ATOMIC_RELAXED);
+        if (begin >= job->n) {
+            break;
+        }
+        size_t end = (job->n - begin < WEB3C_CREATE2_DEFAULT_CHUNK)
+                         ? job->n : begin + WEB3C_CREATE2_DEFAULT_CHUNK;
+
+        for (size_t i = begin; i < end; i += WEB3C_CREATE_BATCH) {
+            size_t m = (end - i < WEB3C_CREATE_BATCH) ? end - i : WEB3C_CREATE_BATCH;
+
+            web3c_create2_address_batch(job->deployer, job->init_code_hash,
+                                        job->salts + i, m, outs);
+            for (size_t j = 0; j < m; ++j) {
+                memcpy(job->table[i + j].address, outs[j], 20);
+                job->table[i + j].index = i + j;
+            }
+        }
+        if (job->progress) {
+            __atomic_fetch_add(&job->progress->hashes, (uint64_t)(end - begin),
+                               __ATOMIC_RELAXED);
+        }
+    }
+
+    return NULL;
+}
+
+static int web3c_create2_entry_cmp(const void *a, const void *b)
+{
+    const web3c_create2_entry *ea = (const web3c_create2_entry *)a;
+    const web3c_create2_entry *eb = (const web3c_create2_entry *)b;
+
+    int c = memcmp(ea->address, eb->address, 20);
+    if (c != 0) {
+        return c;
+    }
+    return (ea->index > eb->index) - (ea->index < eb->index);
+}
+
+int web3c_create2_precompute(const uint8_t deployer[20],
+                             const uint8_t init_code_hash[32],
+                             const uint8_t (*salts)[32],
+                             size_t n,
+                             web3c_create2_entry *table,
+                             unsigned threads,
+                             web3c_create2_progress *progress)
+{
+    web3c_create2_precompute_job job;
+
+    if (deployer == NULL || init_code_hash == NULL ||
+        (n > 0 && (salts == NULL || table == NULL))) {
+        return -1;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    job.deployer       = deployer;
+    job.init_code_hash = init_code_hash;
+    job.salts          = salts;
+    job.n              = n;
+    job.table          = table;
+    job.next           = 0;
+    job.stop           = 0;
+    job.progress       = progress;
+
+    if (progress) {
+        __atomic_store_n(&progress->hashes, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&progress->start_ns, web3c_now_ns(), __ATOMIC_RELAXED);
+    }
+
+    /* No point in more threads than chunks. */
+    unsigned nthreads = web3c_thread_count(threads);
+    size_t   chunks   = (n + WEB3C_CREATE2_DEFAULT_CHUNK - 1) / WEB3C_CREATE2_DEFAULT_CHUNK;
+    if (chunks < nthreads) {
+        nthreads = (unsigned)chunks;
+    }
+
+    if (web3c_run_workers(nthreads, web3c_create2_precompute_worker,
+                          &job, &job.stop) != 0) {
+        return -1;
+    }
+
+    qsort(table, n, sizeof(*table), web3c_create2_entry_cmp);
+    return 0;
+}
+
+const web3c_create2_entry *web3c_create2_lookup(const web3c_create2_entry *table,
+                                                size_t n,
+                                                const uint8_t address[20])
+{
+    size_t lo = 0;
+    size_t hi = n;
+
+    if (table == NULL || address == NULL) {
+        return NULL;
+    }
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = memcmp(table[mid].address, address, 20);
+
+        if (c == 0) {
+            return &table[mid];
+        }
+        if (c < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return NULL;
+}
@@ -1,5 +1,17 @@
 #include "web3c/hex.h"
 
+#include <limits.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define HEX_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define HEX_NEON 1
+#include <arm_neon.h>
+#endif
+
 static int hex_value(char c) {
     if (c >= '0' && c <= '9') return c - '0';
     if (c >= 'a' && c <= 'f') return 10 + (c - 'a');
@@ -7,9 +19,111 @@ static int hex_value(char c) {
     return -1;
 }
 
-int web3c_hex_encode(const uint8_t *in, size_t in_len, char *out, size_t out_size) {
-    static const char *hex_chars = "0123456789abcdef";
+static const char hex_chars[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+};
+
+static void hex_encode_scalar(const uint8_t *in, size_t in_len, char *out) {
+    for (size_t i = 0; i < in_len; ++i) {
+        uint8_t byte = in[i];
+        out[2 * i]     = hex_chars[(byte >> 4) & 0x0F];
+        out[2 * i + 1] = hex_chars[byte & 0x0F];
+    }
+}
+
+/*
+ * Vector encoders: split each byte into its high and low nibble, map
+ * both through a 16-entry shuffle table holding "0123456789abcdef" and
+ * interleave the results. Each returns the number of input bytes done;
+ * the caller finishes the tail with the scalar loop.
+ */
+
+#ifdef HEX_X86
+
+__attribute__((target("ssse3")))
+static size_t hex_encode_ssse3(const uint8_t *in, size_t in_len, char *out) {
+    const __m128i lut  = _mm_loadu_si128((const __m128i *)hex_chars);
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= in_len; i += 16) {
+        __m128i x  = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(x, mask));
+
+        _mm_storeu_si128((__m128i *)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t hex_encode_avx2(const uint8_t *in, size_t in_len, char *out) {
+    const __m256i lut  = _mm256_broadcastsi128_si256(
+                             _mm_loadu_si128((const __m128i *)hex_chars));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 32 <= in_len; i += 32) {
+        __m256i x  = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, mask));
+
+        /* Unpacks work per 128-bit lane; put the lanes back in order. */
+        __m256i a = _mm256_unpacklo_epi8(hi, lo); /* bytes 0-7, 16-23 */
+        __m256i b = _mm256_unpackhi_epi8(hi, lo); /* bytes 8-15, 24-31 */
+
+        _mm256_storeu_si256((__m256i *)(out + 2 * i),
+                            _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 2 * i + 32),
+                            _mm256_permute2x128_si256(a, b, 0x31));
+    }
 
+    return i;
+}
+
+#endif /* HEX_X86 */
+
+#ifdef HEX_NEON
+
+static size_t hex_encode_neon(const uint8_t *in, size_t in_len, char *out) {
+    const uint8x16_t lut  = vld1q_u8((const uint8_t *)hex_chars);
+    const uint8x16_t mask = vdupq_n_u8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= in_len; i += 16) {
+        uint8x16_t  x = vld1q_u8(in + i);
+        uint8x16x2_t pair;
+
+        pair.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(x, 4));
+        pair.val[1] = vqtbl1q_u8(lut, vandq_u8(x, mask));
+        vst2q_u8((uint8_t *)out + 2 * i, pair); /* interleaving store */
+    }
+
+    return i;
+}
+
+#endif /* HEX_NEON */
+
+static void hex_encode_chars(const uint8_t *in, size_t in_len, char *out) {
+    size_t done = 0;
+
+#ifdef HEX_X86
+    if (in_len >= 32 && __builtin_cpu_supports("avx2")) {
+        done = hex_encode_avx2(in, in_len, out);
+    } else if (in_len >= 16 && __builtin_cpu_supports("ssse3")) {
+        done = hex_encode_ssse3(in, in_len, out);
+    }
+#elif defined(HEX_NEON)
+    done = hex_encode_neon(in, in_len, out);
+#endif
+
+    hex_encode_scalar(in + done, in_len - done, out + 2 * done);
+}
+
+int web3c_hex_encode(const uint8_t *in, size_t in_len, char *out, size_t out_size) {
     if (in == NULL || out == NULL) {
         return -1;
     }
@@ -18,25 +132,182 @@ int web3c_hex_encode(const uint8_t *in, size_t in_len, char *out, size_t out_siz
         return -1;
     }
 
-    for (size_t i = 0; i < in_len; ++i) {
-        uint8_t byte = in[i];
-        out[2 * i]     = hex_chars[(byte >> 4) & 0x0F];
-        out[2 * i + 1] = hex_chars[byte & 0x0F];
-    }
+    hex_encode_chars(in, in_len, out);
 
     out[in_len * 2] = '\0';
     return 0;
 }
 
+int web3c_hex_encode_raw(const uint8_t *in, size_t in_len, char *out, size_t out_size) {
+    if ((in == NULL && in_len != 0) || out == NULL) {
+        return -1;
+    }
+
+    if (out_size < in_len * 2) {
+        return -1;
+    }
+
+    hex_encode_chars(in, in_len, out);
+    return 0;
+}
+
+/*
+ * Scalar decoder for n output bytes. Returns 0, or -1 with *bad set to
+ * the index of the first invalid character.
+ */
+static int hex_decode_scalar(const char *hex, size_t n, uint8_t *out, size_t *bad) {
+    for (size_t i = 0; i < n; ++i) {
+        int hi = hex_value(hex[2 * i]);
+        int lo = hex_value(hex[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            *bad = 2 * i + (hi < 0 ? 0 : 1);
+            return -1;
+        }
+        out[i] = (uint8_t)((hi << 4) | lo);
+    }
+    return 0;
+}
+
+/*
+ * Vector decoders: per character, d = c - '0' is a digit if d <= 9 and
+ * a = (c | 0x20) - 'a' is a letter if a <= 5; the nibble is d or a + 10.
+ * Pairs of nibbles are combined as hi * 16 + lo. Each returns the number
+ * of output bytes done; on an invalid character it stops before that
+ * block so the scalar decoder can report the exact offset.
+ */
+
+#ifdef HEX_X86
+
+__attribute__((target("ssse3")))
+static size_t hex_decode_ssse3(const char *hex, size_t n, uint8_t *out) {
+    const __m128i c0    = _mm_set1_epi8('0');
+    const __m128i ca    = _mm_set1_epi8('a');
+    const __m128i c20   = _mm_set1_epi8(0x20);
+    const __m128i nine  = _mm_set1_epi8(9);
+    const __m128i five  = _mm_set1_epi8(5);
+    const __m128i ten   = _mm_set1_epi8(10);
+    const __m128i weights = _mm_set1_epi16(0x0110); /* hi * 16 + lo * 1 */
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i c = _mm_loadu_si128((const __m128i *)(hex + 2 * i));
+        __m128i d = _mm_sub_epi8(c, c0);
+        __m128i a = _mm_sub_epi8(_mm_or_si128(c, c20), ca);
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+        __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(a, five), a);
+
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF) {
+            break;
+        }
+
+        __m128i v = _mm_or_si128(_mm_and_si128(is_digit, d),
+                                 _mm_andnot_si128(is_digit, _mm_add_epi8(a, ten)));
+        __m128i w = _mm_maddubs_epi16(v, weights);
+        _mm_storel_epi64((__m128i *)(out + i), _mm_packus_epi16(w, w));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t hex_decode_avx2(const char *hex, size_t n, uint8_t *out) {
+    const __m256i c0    = _mm256_set1_epi8('0');
+    const __m256i ca    = _mm256_set1_epi8('a');
+    const __m256i c20   = _mm256_set1_epi8(0x20);
+    const __m256i nine  = _mm256_set1_epi8(9);
+    const __m256i five  = _mm256_set1_epi8(5);
+    const __m256i ten   = _mm256_set1_epi8(10);
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i c = _mm256_loadu_si256((const __m256i *)(hex + 2 * i));
+        __m256i d = _mm256_sub_epi8(c, c0);
+        __m256i a = _mm256_sub_epi8(_mm256_or_si256(c, c20), ca);
+        __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, nine), d);
+        __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(a, five), a);
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != -1) {
+            break;
+        }
+
+        __m256i v = _mm256_blendv_epi8(_mm256_add_epi8(a, ten), d, is_digit);
+        __m256i w = _mm256_maddubs_epi16(v, weights);
+
+        /* packus works per lane: bytes 0-7 land in qword 0, 8-15 in qword 2. */
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi16(w, w), 0x08);
+        _mm_storeu_si128((__m128i *)(out + i), _mm256_castsi256_si128(p));
+    }
+
+    return i;
+}
+
+#endif /* HEX_X86 */
+
+#ifdef HEX_NEON
+
+static size_t hex_decode_neon(const char *hex, size_t n, uint8_t *out) {
+    const uint8x16_t c0   = vdupq_n_u8('0');
+    const uint8x16_t ca   = vdupq_n_u8('a');
+    const uint8x16_t c20  = vdupq_n_u8(0x20);
+    const uint8x16_t nine = vdupq_n_u8(9);
+    const uint8x16_t five = vdupq_n_u8(5);
+    const uint8x16_t ten  = vdupq_n_u8(10);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        /* De-interleaving load: val[0] = high digits, val[1] = low digits. */
+        uint8x16x2_t c = vld2q_u8((const uint8_t *)hex + 2 * i);
+        uint8x16_t   nib[2];
+        uint8x16_t   ok = vdupq_n_u8(0xFF);
+
+        for (int k = 0; k < 2; ++k) {
+            uint8x16_t d = vsubq_u8(c.val[k], c0);
+            uint8x16_t a = vsubq_u8(vorrq_u8(c.val[k], c20), ca);
+            uint8x16_t is_digit = vcleq_u8(d, nine);
+            uint8x16_t is_alpha = vcleq_u8(a, five);
+
+            ok     = vandq_u8(ok, vorrq_u8(is_digit, is_alpha));
+            nib[k] = vbslq_u8(is_digit, d, vaddq_u8(a, ten));
+        }
+
+        if (vminvq_u8(ok) != 0xFF) {
+            break;
+        }
+        vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(nib[0], 4), nib[1]));
+    }
+
+    return i;
+}
+
+#endif /* HEX_NEON */
+
+static int hex_decode_chars(const char *hex, size_t n, uint8_t *out, size_t *bad) {
+    size_t done = 0;
+
+#ifdef HEX_X86
+    if (n >= 16 && __builtin_cpu_supports("avx2")) {
+        done = hex_decode_avx2(hex, n, out);
+    } else if (n >= 8 && __builtin_cpu_supports("ssse3")) {
+        done = hex_decode_ssse3(hex, n, out);
+    }
+#elif defined(HEX_NEON)
+    done = hex_decode_neon(hex, n, out);
+#endif
+
+    if (hex_decode_scalar(hex + 2 * done, n - done, out + done, bad) != 0) {
+        *bad += 2 * done;
+        return -1;
+    }
+    return 0;
+}
+
 int web3c_hex_decode(const char *hex, uint8_t *out, size_t out_size) {
     if (hex == NULL || out == NULL) {
         return -1;
     }
 
-    size_t len = 0;
-    while (hex[len] != '\0') {
-        ++len;
-    }
+    size_t len = strlen(hex);
 
     if (len % 2 != 0) {
         /* Hex string length must be even. */
@@ -44,18 +315,216 @@ int web3c_hex_decode(const char *hex, uint8_t *out, size_t out_size) {
     }
 
     size_t bytes_needed = len / 2;
-    if (out_size < bytes_needed) {
+    if (out_size < bytes_needed || bytes_needed > INT_MAX) {
         return -1;
     }
 
-    for (size_t i = 0; i < bytes_needed; ++i) {
-        int hi = hex_value(hex[2 * i]);
-        int lo = hex_value(hex[2 * i + 1]);
-        if (hi < 0 || lo < 0) {
+    size_t bad = 0;
+    if (hex_decode_chars(hex, bytes_needed, out, &bad) != 0) {
+        return -1;
+    }
+
+    return (int)bytes_needed;
+}
+
+int web3c_hex_decode_n(const char *hex,
+                       size_t hex_len,
+                       uint8_t *out,
+                       size_t out_size,
+                       size_t *err_offset) {
+    size_t start = 0;
+    size_t bad   = 0;
+
+    if (hex == NULL && hex_len != 0) {
+        if (err_offset) {
+            *err_offset = 0;
+        }
+        return -1;
+    }
+
+    if (hex_len >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        start = 2;
+    }
+
+    size_t digits       = hex_len - start;
+    size_t bytes_needed = digits / 2;
+    size_t limit        = out == NULL ? 0 : out_size;
+
+    if (limit > INT_MAX) {
+        limit = INT_MAX;
+    }
+
+    if (digits % 2 != 0 || bytes_needed > limit) {
+        /*
+         * Length errors are reported only for otherwise valid input, so
+         * the offset matches the streaming decoder: first an invalid
+         * character, then a missing last digit, then the first
+         * character whose byte does not fit.
+         */
+        bad = start;
+        while (bad < hex_len && hex_value(hex[bad]) >= 0) {
+            ++bad;
+        }
+        if (bad == hex_len) {
+            bad = digits % 2 != 0 ? hex_len : start + 2 * limit;
+        }
+    } else if (hex_decode_chars(hex + start, bytes_needed, out, &bad) == 0) {
+        return (int)bytes_needed;
+    } else {
+        bad += start;
+    }
+
+    if (err_offset) {
+        *err_offset = bad;
+    }
+    return -1;
+}
+
+/* Output block of web3c_hex_decode_update_sink(). */
+#define HEX_SINK_BLOCK 4096
+
+void web3c_hex_decode_init(web3c_hex_decode_ctx *ctx, unsigned flags) {
+    if (ctx == NULL) {
+        return;
+    }
+    ctx->offset     = 0;
+    ctx->err_offset = 0;
+    ctx->nibble     = -1;
+    ctx->flags      = flags;
+    ctx->error      = 0;
+}
+
+static int hex_stream_fail(web3c_hex_decode_ctx *ctx, uint64_t at) {
+    ctx->error      = 1;
+    ctx->err_offset = at;
+    return -1;
+}
+
+int web3c_hex_decode_update(web3c_hex_decode_ctx *ctx,
+                            const char *hex,
+                            size_t hex_len,
+                            uint8_t *out,
+                            size_t out_size,
+                            size_t *consumed) {
+    size_t i     = 0;
+    size_t o     = 0;
+    size_t limit = out == NULL ? 0 : out_size;
+
+    if (consumed) {
+        *consumed = 0;
+    }
+    if (ctx == NULL || ctx->error) {
+        return -1;
+    }
+    if (hex == NULL && hex_len != 0) {
+        return hex_stream_fail(ctx, ctx->offset);
+    }
+    if (limit > INT_MAX) {
+        limit = INT_MAX;
+    }
+
+    /*
+     * Character by character while a digit is carried over from the
+     * previous chunk or a "0x" prefix may still be in progress.
+     */
+    int prefix = (ctx->flags & WEB3C_HEX_DECODE_PREFIX) != 0;
+
+    while (i < hex_len && (ctx->nibble >= 0 || (prefix && ctx->offset + i < 2))) {
+        uint64_t pos = ctx->offset + i;
+
+        if (pos == 1 && ctx->nibble == 0 && prefix && (hex[i] == 'x' || hex[i] == 'X')) {
+            /* The leading '0' was the prefix, not a digit. */
+            ctx->nibble = -1;
+            ++i;
+            continue;
+        }
+
+        int v = hex_value(hex[i]);
+        if (v < 0) {
+            return hex_stream_fail(ctx, pos);
+        }
+        if (ctx->nibble < 0) {
+            if (o >= limit) {
+                break;
+            }
+            ctx->nibble = v;
+        } else {
+            out[o++]    = (uint8_t)((ctx->nibble << 4) | v);
+            ctx->nibble = -1;
+        }
+        ++i;
+    }
+
+    /* Aligned: whole pairs through the SIMD decoder. */
+    if (ctx->nibble < 0 && !(prefix && ctx->offset + i < 2)) {
+        size_t pairs = (hex_len - i) / 2;
+        size_t bad   = 0;
+
+        if (pairs > limit - o) {
+            pairs = limit - o;
+        }
+        if (hex_decode_chars(hex + i, pairs, out + o, &bad) != 0) {
+            return hex_stream_fail(ctx, ctx->offset + i + bad);
+        }
+        i += 2 * pairs;
+        o += pairs;
+
+        /* A lone trailing digit waits for the next chunk. */
+        if (i + 1 == hex_len && o < limit) {
+            int v = hex_value(hex[i]);
+            if (v < 0) {
+                return hex_stream_fail(ctx, ctx->offset + i);
+            }
+            ctx->nibble = v;
+            ++i;
+        }
+    }
+
+    ctx->offset += i;
+    if (consumed) {
+        *consumed = i;
+    }
+    return (int)o;
+}
+
+int web3c_hex_decode_update_sink(web3c_hex_decode_ctx *ctx,
+                                 const char *hex,
+                                 size_t hex_len,
+                                 web3c_hex_sink sink,
+                                 void *user) {
+    uint8_t block[HEX_SINK_BLOCK];
+
+    if (ctx == NULL || ctx->error) {
+        return -1;
+    }
+    if (sink == NULL) {
+        return hex_stream_fail(ctx, ctx->offset);
+    }
+
+    while (hex_len > 0) {
+        size_t used = 0;
+        int    n    = web3c_hex_decode_update(ctx, hex, hex_len, block, sizeof(block), &used);
+
+        if (n < 0) {
             return -1;
         }
-        out[i] = (uint8_t)((hi << 4) | lo);
+        if (n > 0 && sink(user, block, (size_t)n) != 0) {
+            return hex_stream_fail(ctx, ctx->offset);
+        }
+        hex     += used;
+        hex_len -= used;
     }
 
-    return (int)bytes_needed;
+    return 0;
+}
+
+int web3c_hex_decode_final(web3c_hex_decode_ctx *ctx) {
+    if (ctx == NULL || ctx->error) {
+        return -1;
+    }
+    if (ctx->nibble >= 0) {
+        /* A digit is missing at the end. */
+        return hex_stream_fail(ctx, ctx->offset);
+    }
+    return 0;
 }
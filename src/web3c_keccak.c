@@ -1,12 +1,13 @@
 #include "web3c/keccak.h"
+#include "web3c_keccak_internal.h"
 
 #include <string.h>
 
 /* Internal rotation macro */
 #define WEB3C_ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
 
-/* Keccak-f[1600] round constants */
-static const uint64_t web3c_keccakf_rndc[24] = {
+/* Keccak-f[1600] round constants (shared with the SIMD kernels) */
+const uint64_t web3c_keccakf_rndc[24] = {
     0x0000000000000001ULL, 0x0000000000008082ULL,
     0x800000000000808aULL, 0x8000000080008000ULL,
     0x000000000000808bULL, 0x0000000080000001ULL,
@@ -21,88 +22,201 @@ static const uint64_t web3c_keccakf_rndc[24] = {
     0x0000000080000001ULL, 0x8000000080008008ULL
 };
 
-/* Rotation offsets (flattened) */
-static const unsigned int web3c_keccakf_rotc[24] = {
-     1,  3,  6, 10, 15, 21,
-    28, 36, 45, 55,  2, 14,
-    27, 41, 56,  8, 25, 43,
-    62, 18, 39, 61, 20, 44
-};
-
-/* Permutation indices */
-static const unsigned int web3c_keccakf_piln[24] = {
-    10,  7, 11, 17, 18,  3,
-     5, 16,  8, 21, 24,  4,
-    15, 23, 19, 13, 12,  2,
-    20, 14, 22,  9,  6,  1
-};
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define WEB3C_KECCAK_LE 1
+#endif
 
 static uint64_t web3c_load64_le(const uint8_t *src)
 {
+#ifdef WEB3C_KECCAK_LE
+    uint64_t w;
+    memcpy(&w, src, sizeof(w));  /* single unaligned word load */
+    return w;
+#else
     uint64_t w = 0;
     for (int i = 0; i < 8; ++i) {
         w |= ((uint64_t)src[i]) << (8 * i);
     }
     return w;
+#endif
 }
 
 static void web3c_store64_le(uint8_t *dst, uint64_t w)
 {
+#ifdef WEB3C_KECCAK_LE
+    memcpy(dst, &w, sizeof(w));
+#else
     for (int i = 0; i < 8; ++i) {
         dst[i] = (uint8_t)(w >> (8 * i));
     }
+#endif
+}
+
+/* XOR one full rate-sized block into the state, word by word. */
+static void web3c_keccak_absorb_block(uint64_t st[25], const uint8_t *block)
+{
+    for (size_t i = 0; i < WEB3C_KECCAK_RATE / 8; ++i) {
+        st[i] ^= web3c_load64_le(block + 8 * i);
+    }
 }
 
+/* XOR `len` bytes into the state starting at byte offset `pos`. */
+static void web3c_keccak_absorb_bytes(uint64_t st[25],
+                                      size_t pos,
+                                      const uint8_t *data,
+                                      size_t len)
+{
+#ifdef WEB3C_KECCAK_LE
+    uint8_t *bytes = (uint8_t *)st;
+    for (size_t i = 0; i < len; ++i) {
+        bytes[pos + i] ^= data[i];
+    }
+#else
+    for (size_t i = 0; i < len; ++i, ++pos) {
+        st[pos / 8] ^= (uint64_t)data[i] << (8 * (pos % 8));
+    }
+#endif
+}
+
+/*
+ * One fully unrolled round, reading lanes A##xy and writing E##xy, in the
+ * style of the XKCP reference code. Lanes be, bi, go, ki, mi and sa are
+ * kept complemented ("lane complementing"), which turns most of the
+ * ~b & c terms of chi into plain AND/OR and saves a NOT per lane. The
+ * column parities for the next round's theta are accumulated on the fly.
+ */
+#define WEB3C_KECCAK_ROUND(i, A, E)                                      \
+    Da = Cu ^ WEB3C_ROTL64(Ce, 1);                                       \
+    De = Ca ^ WEB3C_ROTL64(Ci, 1);                                       \
+    Di = Ce ^ WEB3C_ROTL64(Co, 1);                                       \
+    Do = Ci ^ WEB3C_ROTL64(Cu, 1);                                       \
+    Du = Co ^ WEB3C_ROTL64(Ca, 1);                                       \
+                                                                         \
+    A##ba ^= Da; Bba = A##ba;                                            \
+    A##ge ^= De; Bbe = WEB3C_ROTL64(A##ge, 44);                          \
+    A##ki ^= Di; Bbi = WEB3C_ROTL64(A##ki, 43);                          \
+    A##mo ^= Do; Bbo = WEB3C_ROTL64(A##mo, 21);                          \
+    A##su ^= Du; Bbu = WEB3C_ROTL64(A##su, 14);                          \
+    E##ba = Bba ^ (Bbe | Bbi) ^ web3c_keccakf_rndc[i]; Ca = E##ba;       \
+    E##be = Bbe ^ ((~Bbi) | Bbo); Ce = E##be;                            \
+    E##bi = Bbi ^ (Bbo & Bbu); Ci = E##bi;                               \
+    E##bo = Bbo ^ (Bbu | Bba); Co = E##bo;                               \
+    E##bu = Bbu ^ (Bba & Bbe); Cu = E##bu;                               \
+                                                                         \
+    A##bo ^= Do; Bga = WEB3C_ROTL64(A##bo, 28);                          \
+    A##gu ^= Du; Bge = WEB3C_ROTL64(A##gu, 20);                          \
+    A##ka ^= Da; Bgi = WEB3C_ROTL64(A##ka, 3);                           \
+    A##me ^= De; Bgo = WEB3C_ROTL64(A##me, 45);                          \
+    A##si ^= Di; Bgu = WEB3C_ROTL64(A##si, 61);                          \
+    E##ga = Bga ^ (Bge | Bgi); Ca ^= E##ga;                              \
+    E##ge = Bge ^ (Bgi & Bgo); Ce ^= E##ge;                              \
+    E##gi = Bgi ^ (Bgo | (~Bgu)); Ci ^= E##gi;                           \
+    E##go = Bgo ^ (Bgu | Bga); Co ^= E##go;                              \
+    E##gu = Bgu ^ (Bga & Bge); Cu ^= E##gu;                              \
+                                                                         \
+    A##be ^= De; Bka = WEB3C_ROTL64(A##be, 1);                           \
+    A##gi ^= Di; Bke = WEB3C_ROTL64(A##gi, 6);                           \
+    A##ko ^= Do; Bki = WEB3C_ROTL64(A##ko, 25);                          \
+    A##mu ^= Du; Bko = WEB3C_ROTL64(A##mu, 8);                           \
+    A##sa ^= Da; Bku = WEB3C_ROTL64(A##sa, 18);                          \
+    E##ka = Bka ^ (Bke | Bki); Ca ^= E##ka;                              \
+    E##ke = Bke ^ (Bki & Bko); Ce ^= E##ke;                              \
+    E##ki = Bki ^ ((~Bko) & Bku); Ci ^= E##ki;                           \
+    E##ko = (~Bko) ^ (Bku | Bka); Co ^= E##ko;                           \
+    E##ku = Bku ^ (Bka & Bke); Cu ^= E##ku;                              \
+                                                                         \
+    A##bu ^= Du; Bma = WEB3C_ROTL64(A##bu, 27);                          \
+    A##ga ^= Da; Bme = WEB3C_ROTL64(A##ga, 36);                          \
+    A##ke ^= De; Bmi = WEB3C_ROTL64(A##ke, 10);                          \
+    A##mi ^= Di; Bmo = WEB3C_ROTL64(A##mi, 15);                          \
+    A##so ^= Do; Bmu = WEB3C_ROTL64(A##so, 56);                          \
+    E##ma = Bma ^ (Bme & Bmi); Ca ^= E##ma;                              \
+    E##me = Bme ^ (Bmi | Bmo); Ce ^= E##me;                              \
+    E##mi = Bmi ^ ((~Bmo) | Bmu); Ci ^= E##mi;                           \
+    E##mo = (~Bmo) ^ (Bmu & Bma); Co ^= E##mo;                           \
+    E##mu = Bmu ^ (Bma | Bme); Cu ^= E##mu;                              \
+                                                                         \
+    A##bi ^= Di; Bsa = WEB3C_ROTL64(A##bi, 62);                          \
+    A##go ^= Do; Bse = WEB3C_ROTL64(A##go, 55);                          \
+    A##ku ^= Du; Bsi = WEB3C_ROTL64(A##ku, 39);                          \
+    A##ma ^= Da; Bso = WEB3C_ROTL64(A##ma, 41);                          \
+    A##se ^= De; Bsu = WEB3C_ROTL64(A##se, 2);                           \
+    E##sa = Bsa ^ ((~Bse) & Bsi); Ca ^= E##sa;                           \
+    E##se = (~Bse) ^ (Bsi | Bso); Ce ^= E##se;                           \
+    E##si = Bsi ^ (Bso & Bsu); Ci ^= E##si;                              \
+    E##so = Bso ^ (Bsu | Bsa); Co ^= E##so;                              \
+    E##su = Bsu ^ (Bsa & Bse); Cu ^= E##su;
+
 /**
  * @brief Core Keccak-f[1600] permutation.
  *
  * This is the 24-round permutation used by all Keccak-based functions.
+ * All rounds are unrolled and the 25 lanes live in local variables so the
+ * compiler can keep them in registers. The state is stored in normal
+ * (uncomplemented) form; the lane-complementing transform is applied on
+ * entry and undone on exit.
  */
 static void web3c_keccakf(uint64_t st[25])
 {
-    int round;
-    uint64_t bc[5];
+    uint64_t Aba, Abe, Abi, Abo, Abu, Aga, Age, Agi, Ago, Agu;
+    uint64_t Aka, Ake, Aki, Ako, Aku, Ama, Ame, Ami, Amo, Amu;
+    uint64_t Asa, Ase, Asi, Aso, Asu;
+    uint64_t Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu;
+    uint64_t Eka, Eke, Eki, Eko, Eku, Ema, Eme, Emi, Emo, Emu;
+    uint64_t Esa, Ese, Esi, Eso, Esu;
+    uint64_t Bba, Bbe, Bbi, Bbo, Bbu, Bga, Bge, Bgi, Bgo, Bgu;
+    uint64_t Bka, Bke, Bki, Bko, Bku, Bma, Bme, Bmi, Bmo, Bmu;
+    uint64_t Bsa, Bse, Bsi, Bso, Bsu;
+    uint64_t Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du;
 
-    for (round = 0; round < 24; ++round) {
-        /* Theta */
-        for (int i = 0; i < 5; ++i) {
-            bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
-        }
+    Aba =  st[0];  Abe = ~st[1];  Abi = ~st[2];  Abo =  st[3];  Abu =  st[4];
+    Aga =  st[5];  Age =  st[6];  Agi =  st[7];  Ago = ~st[8];  Agu =  st[9];
+    Aka =  st[10]; Ake =  st[11]; Aki = ~st[12]; Ako =  st[13]; Aku =  st[14];
+    Ama =  st[15]; Ame =  st[16]; Ami = ~st[17]; Amo =  st[18]; Amu =  st[19];
+    Asa = ~st[20]; Ase =  st[21]; Asi =  st[22]; Aso =  st[23]; Asu =  st[24];
 
-        for (int i = 0; i < 5; ++i) {
-            uint64_t t = bc[(i + 4) % 5] ^ WEB3C_ROTL64(bc[(i + 1) % 5], 1);
-            for (int j = 0; j < 25; j += 5) {
-                st[j + i] ^= t;
-            }
-        }
+    Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+    Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+    Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+    Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+    Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
 
-        /* Rho and Pi */
-        uint64_t t = st[1];
-        for (int i = 0; i < 24; ++i) {
-            int j = web3c_keccakf_piln[i];
-            uint64_t tmp = st[j];
-            st[j] = WEB3C_ROTL64(t, web3c_keccakf_rotc[i]);
-            t = tmp;
-        }
+    WEB3C_KECCAK_ROUND( 0, A, E); WEB3C_KECCAK_ROUND( 1, E, A);
+    WEB3C_KECCAK_ROUND( 2, A, E); WEB3C_KECCAK_ROUND( 3, E, A);
+    WEB3C_KECCAK_ROUND( 4, A, E); WEB3C_KECCAK_ROUND( 5, E, A);
+    WEB3C_KECCAK_ROUND( 6, A, E); WEB3C_KECCAK_ROUND( 7, E, A);
+    WEB3C_KECCAK_ROUND( 8, A, E); WEB3C_KECCAK_ROUND( 9, E, A);
+    WEB3C_KECCAK_ROUND(10, A, E); WEB3C_KECCAK_ROUND(11, E, A);
+    WEB3C_KECCAK_ROUND(12, A, E); WEB3C_KECCAK_ROUND(13, E, A);
+    WEB3C_KECCAK_ROUND(14, A, E); WEB3C_KECCAK_ROUND(15, E, A);
+    WEB3C_KECCAK_ROUND(16, A, E); WEB3C_KECCAK_ROUND(17, E, A);
+    WEB3C_KECCAK_ROUND(18, A, E); WEB3C_KECCAK_ROUND(19, E, A);
+    WEB3C_KECCAK_ROUND(20, A, E); WEB3C_KECCAK_ROUND(21, E, A);
+    WEB3C_KECCAK_ROUND(22, A, E); WEB3C_KECCAK_ROUND(23, E, A);
 
-        /* Chi */
-        for (int j = 0; j < 25; j += 5) {
-            uint64_t a0 = st[j + 0];
-            uint64_t a1 = st[j + 1];
-            uint64_t a2 = st[j + 2];
-            uint64_t a3 = st[j + 3];
-            uint64_t a4 = st[j + 4];
-
-            st[j + 0] ^= (~a1) & a2;
-            st[j + 1] ^= (~a2) & a3;
-            st[j + 2] ^= (~a3) & a4;
-            st[j + 3] ^= (~a4) & a0;
-            st[j + 4] ^= (~a0) & a1;
-        }
+    st[0]  =  Aba; st[1]  = ~Abe; st[2]  = ~Abi; st[3]  =  Abo; st[4]  =  Abu;
+    st[5]  =  Aga; st[6]  =  Age; st[7]  =  Agi; st[8]  = ~Ago; st[9]  =  Agu;
+    st[10] =  Aka; st[11] =  Ake; st[12] = ~Aki; st[13] =  Ako; st[14] =  Aku;
+    st[15] =  Ama; st[16] =  Ame; st[17] = ~Ami; st[18] =  Amo; st[19] =  Amu;
+    st[20] = ~Asa; st[21] =  Ase; st[22] =  Asi; st[23] =  Aso; st[24] =  Asu;
+}
+
+#undef WEB3C_KECCAK_ROUND
 
-        /* Iota */
-        st[0] ^= web3c_keccakf_rndc[round];
+/*
+ * Permutation used by the streaming and one-shot API. On x86 CPUs with
+ * AVX-512 the single-state vector kernel is selected at runtime, so one
+ * library binary runs everywhere.
+ */
+static void web3c_keccak_permute(uint64_t st[25])
+{
+#ifdef WEB3C_KECCAK_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        web3c_keccakf_avx512(st);
+        return;
     }
+#endif
+    web3c_keccakf(st);
 }
 
 void web3c_keccak256_init(web3c_keccak_ctx *ctx)
@@ -112,10 +226,8 @@ void web3c_keccak256_init(web3c_keccak_ctx *ctx)
     }
 
     memset(ctx->state, 0, sizeof(ctx->state));
-    memset(ctx->buffer, 0, sizeof(ctx->buffer));
-    ctx->rate       = 136;  /* 1088 bits */
-    ctx->buffer_pos = 0;
-    ctx->finalized  = 0;
+    ctx->pos       = 0;
+    ctx->finalized = 0;
 }
 
 void web3c_keccak_update(web3c_keccak_ctx *ctx,
@@ -126,55 +238,98 @@ void web3c_keccak_update(web3c_keccak_ctx *ctx,
         return;
     }
 
-    while (len > 0) {
-        size_t space = ctx->rate - ctx->buffer_pos;
-        size_t to_copy = (len < space) ? len : space;
+    size_t pos = ctx->pos;
 
-        memcpy(ctx->buffer + ctx->buffer_pos, data, to_copy);
-        ctx->buffer_pos += to_copy;
-        data += to_copy;
-        len  -= to_copy;
+    /* Top up a partially absorbed block first. */
+    if (pos > 0) {
+        size_t space = WEB3C_KECCAK_RATE - pos;
+        size_t take  = (len < space) ? len : space;
 
-        if (ctx->buffer_pos == ctx->rate) {
-            /* Absorb full block into state */
-            for (size_t i = 0; i < ctx->rate / 8; ++i) {
-                uint64_t lane = web3c_load64_le(ctx->buffer + 8 * i);
-                ctx->state[i] ^= lane;
-            }
-            web3c_keccakf(ctx->state);
-            ctx->buffer_pos = 0;
+        web3c_keccak_absorb_bytes(ctx->state, pos, data, take);
+        pos  += take;
+        data += take;
+        len  -= take;
+
+        if (pos < WEB3C_KECCAK_RATE) {
+            ctx->pos = (uint32_t)pos;
+            return;
         }
+        web3c_keccak_permute(ctx->state);
     }
+
+    /* Full blocks are absorbed straight from the caller's buffer. */
+    while (len >= WEB3C_KECCAK_RATE) {
+        web3c_keccak_absorb_block(ctx->state, data);
+        web3c_keccak_permute(ctx->state);
+        data += WEB3C_KECCAK_RATE;
+        len  -= WEB3C_KECCAK_RATE;
+    }
+
+    /* The tail is XOR'd into the state; there is no staging buffer. */
+    web3c_keccak_absorb_bytes(ctx->state, 0, data, len);
+    ctx->pos = (uint32_t)len;
 }
 
 void web3c_keccak_final(web3c_keccak_ctx *ctx, uint8_t out[32])
 {
+    static const uint8_t pad_first = 0x01;
+    static const uint8_t pad_last  = 0x80;
+
     if (!ctx || !out || ctx->finalized) {
         return;
     }
 
     /* Keccak (Ethereum) padding: pad10*1, i.e. 0x01 ... 0x80 */
-    ctx->buffer[ctx->buffer_pos++] = 0x01;
+    web3c_keccak_absorb_bytes(ctx->state, ctx->pos, &pad_first, 1);
+    web3c_keccak_absorb_bytes(ctx->state, WEB3C_KECCAK_RATE - 1, &pad_last, 1);
+    web3c_keccak_permute(ctx->state);
 
-    while (ctx->buffer_pos < ctx->rate) {
-        ctx->buffer[ctx->buffer_pos++] = 0x00;
+    /* Squeeze first 32 bytes (256 bits) */
+    for (size_t i = 0; i < 4; ++i) {
+        web3c_store64_le(out + 8 * i, ctx->state[i]);
     }
 
-    ctx->buffer[ctx->rate - 1] |= 0x80;
+    ctx->finalized = 1;
+}
 
-    /* Absorb final padded block */
-    for (size_t i = 0; i < ctx->rate / 8; ++i) {
-        uint64_t lane = web3c_load64_le(ctx->buffer + 8 * i);
-        ctx->state[i] ^= lane;
+void web3c_keccak_clone(web3c_keccak_ctx *dst, const web3c_keccak_ctx *src)
+{
+    if (!dst || !src || dst == src) {
+        return;
     }
-    web3c_keccakf(ctx->state);
 
-    /* Squeeze first 32 bytes (256 bits) */
-    for (size_t i = 0; i < 4; ++i) {
+    memcpy(dst, src, sizeof(*dst));
+}
+
+int web3c_keccak_export(const web3c_keccak_ctx *ctx,
+                        uint8_t out[WEB3C_KECCAK_MIDSTATE_SIZE])
+{
+    if (!ctx || !out || ctx->finalized) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < 25; ++i) {
         web3c_store64_le(out + 8 * i, ctx->state[i]);
     }
+    out[200] = (uint8_t)ctx->pos;
 
-    ctx->finalized = 1;
+    return 0;
+}
+
+int web3c_keccak_import(web3c_keccak_ctx *ctx,
+                        const uint8_t in[WEB3C_KECCAK_MIDSTATE_SIZE])
+{
+    if (!ctx || !in || in[200] >= WEB3C_KECCAK_RATE) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < 25; ++i) {
+        ctx->state[i] = web3c_load64_le(in + 8 * i);
+    }
+    ctx->pos       = in[200];
+    ctx->finalized = 0;
+
+    return 0;
 }
 
 int web3c_keccak256(const uint8_t *data, size_t len, uint8_t out[32])
@@ -192,4 +347,194 @@ int web3c_keccak256(const uint8_t *data, size_t len, uint8_t out[32])
 
     web3c_keccak_final(&ctx, out);
     return 0;
-}
\ No newline at end of file
+}
+
+#ifdef WEB3C_KECCAK_X86
+
+/* Maximum number of sponges a multi-buffer kernel processes at once. */
+#define WEB3C_KECCAK_MAX_LANES 8
+
+/*
+ * Build the final padded block for a message tail of `len` bytes
+ * (len < rate), using Keccak pad10*1 with the 0x01 domain byte.
+ */
+static void web3c_keccak_pad_block(uint8_t block[WEB3C_KECCAK_RATE],
+                                   const uint8_t *tail,
+                                   size_t len)
+{
+    memset(block, 0, WEB3C_KECCAK_RATE);
+    if (len > 0) {
+        memcpy(block, tail, len);
+    }
+    block[len] = 0x01;
+    block[WEB3C_KECCAK_RATE - 1] |= 0x80;
+}
+
+/*
+ * Absorb `len` bytes starting at a block boundary into a scalar state,
+ * pad, permute and squeeze the 32-byte digest.
+ */
+static void web3c_keccak_finish_scalar(uint64_t st[25],
+                                       const uint8_t *data,
+                                       size_t len,
+                                       uint8_t out[32])
+{
+    uint8_t block[WEB3C_KECCAK_RATE];
+
+    while (len >= WEB3C_KECCAK_RATE) {
+        web3c_keccak_absorb_block(st, data);
+        web3c_keccak_permute(st);
+        data += WEB3C_KECCAK_RATE;
+        len  -= WEB3C_KECCAK_RATE;
+    }
+
+    web3c_keccak_pad_block(block, data, len);
+    web3c_keccak_absorb_block(st, block);
+    web3c_keccak_permute(st);
+
+    for (size_t i = 0; i < 4; ++i) {
+        web3c_store64_le(out + 8 * i, st[i]);
+    }
+}
+
+/*
+ * Multi-buffer driver: `lanes` independent sponges share one
+ * interleaved permutation call per block (st[lanes * i + l] is lane i
+ * of sponge l). A sponge that finishes its message is immediately
+ * refilled with the next pending one, so mixed lengths keep every lane
+ * busy. The very last message is finished on the scalar path instead
+ * of paying for a mostly idle vector permutation.
+ */
+static void web3c_keccak_batch_lanes(void (*permute)(uint64_t *st),
+                                     size_t lanes,
+                                     const uint8_t *const *inputs,
+                                     const size_t *lens,
+                                     uint8_t (*outs)[32],
+                                     size_t n)
+{
+    uint64_t st[25 * WEB3C_KECCAK_MAX_LANES];
+    uint8_t  block[WEB3C_KECCAK_RATE];
+    size_t   msg[WEB3C_KECCAK_MAX_LANES];
+    size_t   off[WEB3C_KECCAK_MAX_LANES];
+    int      busy[WEB3C_KECCAK_MAX_LANES];
+    int      last[WEB3C_KECCAK_MAX_LANES];
+    size_t   next = 0;
+    size_t   active = 0;
+
+    memset(st, 0, sizeof(st));
+
+    for (size_t l = 0; l < lanes; ++l) {
+        busy[l] = (next < n);
+        if (busy[l]) {
+            msg[l] = next++;
+            off[l] = 0;
+            ++active;
+        }
+    }
+
+    while (active > 0) {
+        if (active == 1 && next == n) {
+            /* One straggler left: continue it on the scalar path. */
+            for (size_t l = 0; l < lanes; ++l) {
+                if (busy[l]) {
+                    uint64_t s[25];
+                    const uint8_t *p = lens[msg[l]] ? inputs[msg[l]] + off[l] : NULL;
+
+                    for (size_t i = 0; i < 25; ++i) {
+                        s[i] = st[lanes * i + l];
+                    }
+                    web3c_keccak_finish_scalar(s, p, lens[msg[l]] - off[l],
+                                               outs[msg[l]]);
+                    break;
+                }
+            }
+            return;
+        }
+
+        for (size_t l = 0; l < lanes; ++l) {
+            if (!busy[l]) {
+                continue;
+            }
+
+            size_t left = lens[msg[l]] - off[l];
+            const uint8_t *p = left ? inputs[msg[l]] + off[l] : NULL;
+
+            if (left >= WEB3C_KECCAK_RATE) {
+                off[l] += WEB3C_KECCAK_RATE;
+                last[l] = 0;
+            } else {
+                web3c_keccak_pad_block(block, p, left);
+                p = block;
+                last[l] = 1;
+            }
+
+            for (size_t i = 0; i < WEB3C_KECCAK_RATE / 8; ++i) {
+                st[lanes * i + l] ^= web3c_load64_le(p + 8 * i);
+            }
+        }
+
+        permute(st);
+
+        for (size_t l = 0; l < lanes; ++l) {
+            if (!busy[l] || !last[l]) {
+                continue;
+            }
+
+            for (size_t i = 0; i < 4; ++i) {
+                web3c_store64_le(outs[msg[l]] + 8 * i, st[lanes * i + l]);
+            }
+            for (size_t i = 0; i < 25; ++i) {
+                st[lanes * i + l] = 0;
+            }
+
+            if (next < n) {
+                msg[l] = next++;
+                off[l] = 0;
+            } else {
+                busy[l] = 0;
+                --active;
+            }
+        }
+    }
+}
+
+#endif /* WEB3C_KECCAK_X86 */
+
+int web3c_keccak256_batch(const uint8_t *const *inputs,
+                          const size_t *lens,
+                          uint8_t (*outs)[32],
+                          size_t n)
+{
+    if (n == 0) {
+        return 0;
+    }
+
+    if (!inputs || !lens || !outs) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (lens[i] > 0 && inputs[i] == NULL) {
+            return -1;
+        }
+    }
+
+#ifdef WEB3C_KECCAK_X86
+    if (n > 1 && __builtin_cpu_supports("avx512f")) {
+        web3c_keccak_batch_lanes(web3c_keccakf_x8_avx512, 8,
+                                 inputs, lens, outs, n);
+        return 0;
+    }
+    if (n > 1 && __builtin_cpu_supports("avx2")) {
+        web3c_keccak_batch_lanes(web3c_keccakf_x4_avx2, 4,
+                                 inputs, lens, outs, n);
+        return 0;
+    }
+#endif
+
+    for (size_t i = 0; i < n; ++i) {
+        web3c_keccak256(inputs[i], lens[i], outs[i]);
+    }
+
+    return 0;
+}
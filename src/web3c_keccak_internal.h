@@ -0,0 +1,50 @@
+#ifndef WEB3C_KECCAK_INTERNAL_H
+#define WEB3C_KECCAK_INTERNAL_H
+
+#include <stdint.h>
+
+/*
+ * Internal interface between the portable Keccak code in web3c_keccak.c
+ * and the SIMD permutation kernels in web3c_keccak_x86.c.
+ *
+ * Not part of the public API.
+ */
+
+/* Sponge rate for Keccak-256 in bytes (1088 bits). */
+#define WEB3C_KECCAK_RATE 136
+
+/* Keccak-f[1600] round constants (defined in web3c_keccak.c). */
+extern const uint64_t web3c_keccakf_rndc[24];
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define WEB3C_KECCAK_X86 1
+#endif
+
+#ifdef WEB3C_KECCAK_X86
+
+/*
+ * 4-way Keccak-f[1600] using AVX2.
+ *
+ * The state of four independent sponges is stored lane-interleaved:
+ * st[4 * i + l] is lane i of sponge l. Callers must check for AVX2
+ * support at runtime before calling.
+ */
+void web3c_keccakf_x4_avx2(uint64_t st[100]);
+
+/*
+ * 8-way Keccak-f[1600] using AVX-512F (vpternlogq for theta and chi,
+ * native 64-bit rotates). Same lane-interleaved layout as the AVX2
+ * kernel: st[8 * i + l] is lane i of sponge l.
+ */
+void web3c_keccakf_x8_avx512(uint64_t st[200]);
+
+/*
+ * Single-state Keccak-f[1600] using AVX-512F. Drop-in replacement for
+ * the scalar permutation on a plain st[25] state.
+ */
+void web3c_keccakf_avx512(uint64_t st[25]);
+
+#endif /* WEB3C_KECCAK_X86 */
+
+#endif /* WEB3C_KECCAK_INTERNAL_H */
@@ -0,0 +1,254 @@
+#include "web3c_keccak_internal.h"
+
+#ifdef WEB3C_KECCAK_X86
+
+#include <immintrin.h>
+
+/*
+ * One Keccak-f[1600] round over 25 lane vectors A[0..24], lane index
+ * x + 5 * y. The round is written once and instantiated for each ISA
+ * through the V, XOR, XOR5, ROL and CHI macros, where
+ * CHI(a, b, c) = a ^ (~b & c).
+ */
+#define WEB3C_KECCAK_VROUND(A, rc)                                      \
+    do {                                                                \
+        V c0 = XOR5(A[0], A[5], A[10], A[15], A[20]);                   \
+        V c1 = XOR5(A[1], A[6], A[11], A[16], A[21]);                   \
+        V c2 = XOR5(A[2], A[7], A[12], A[17], A[22]);                   \
+        V c3 = XOR5(A[3], A[8], A[13], A[18], A[23]);                   \
+        V c4 = XOR5(A[4], A[9], A[14], A[19], A[24]);                   \
+        V d0 = XOR(c4, ROL(c1, 1));                                     \
+        V d1 = XOR(c0, ROL(c2, 1));                                     \
+        V d2 = XOR(c1, ROL(c3, 1));                                     \
+        V d3 = XOR(c2, ROL(c4, 1));                                     \
+        V d4 = XOR(c3, ROL(c0, 1));                                     \
+        V b0 = XOR(A[0], d0);                                           \
+        V b1 = ROL(XOR(A[6], d1), 44);                                  \
+        V b2 = ROL(XOR(A[12], d2), 43);                                 \
+        V b3 = ROL(XOR(A[18], d3), 21);                                 \
+        V b4 = ROL(XOR(A[24], d4), 14);                                 \
+        V b5 = ROL(XOR(A[3], d3), 28);                                  \
+        V b6 = ROL(XOR(A[9], d4), 20);                                  \
+        V b7 = ROL(XOR(A[10], d0), 3);                                  \
+        V b8 = ROL(XOR(A[16], d1), 45);                                 \
+        V b9 = ROL(XOR(A[22], d2), 61);                                 \
+        V b10 = ROL(XOR(A[1], d1), 1);                                  \
+        V b11 = ROL(XOR(A[7], d2), 6);                                  \
+        V b12 = ROL(XOR(A[13], d3), 25);                                \
+        V b13 = ROL(XOR(A[19], d4), 8);                                 \
+        V b14 = ROL(XOR(A[20], d0), 18);                                \
+        V b15 = ROL(XOR(A[4], d4), 27);                                 \
+        V b16 = ROL(XOR(A[5], d0), 36);                                 \
+        V b17 = ROL(XOR(A[11], d1), 10);                                \
+        V b18 = ROL(XOR(A[17], d2), 15);                                \
+        V b19 = ROL(XOR(A[23], d3), 56);                                \
+        V b20 = ROL(XOR(A[2], d2), 62);                                 \
+        V b21 = ROL(XOR(A[8], d3), 55);                                 \
+        V b22 = ROL(XOR(A[14], d4), 39);                                \
+        V b23 = ROL(XOR(A[15], d0), 41);                                \
+        V b24 = ROL(XOR(A[21], d1), 2);                                 \
+        A[0] = XOR(CHI(b0, b1, b2), (rc));                              \
+        A[1] = CHI(b1, b2, b3);                                         \
+        A[2] = CHI(b2, b3, b4);                                         \
+        A[3] = CHI(b3, b4, b0);                                         \
+        A[4] = CHI(b4, b0, b1);                                         \
+        A[5] = CHI(b5, b6, b7);                                         \
+        A[6] = CHI(b6, b7, b8);                                         \
+        A[7] = CHI(b7, b8, b9);                                         \
+        A[8] = CHI(b8, b9, b5);                                         \
+        A[9] = CHI(b9, b5, b6);                                         \
+        A[10] = CHI(b10, b11, b12);                                     \
+        A[11] = CHI(b11, b12, b13);                                     \
+        A[12] = CHI(b12, b13, b14);                                     \
+        A[13] = CHI(b13, b14, b10);                                     \
+        A[14] = CHI(b14, b10, b11);                                     \
+        A[15] = CHI(b15, b16, b17);                                     \
+        A[16] = CHI(b16, b17, b18);                                     \
+        A[17] = CHI(b17, b18, b19);                                     \
+        A[18] = CHI(b18, b19, b15);                                     \
+        A[19] = CHI(b19, b15, b16);                                     \
+        A[20] = CHI(b20, b21, b22);                                     \
+        A[21] = CHI(b21, b22, b23);                                     \
+        A[22] = CHI(b22, b23, b24);                                     \
+        A[23] = CHI(b23, b24, b20);                                     \
+        A[24] = CHI(b24, b20, b21);                                     \
+    } while (0)
+
+/* ---- AVX2: four sponges per permutation ---- */
+
+#define V          __m256i
+#define XOR(a, b)  _mm256_xor_si256((a), (b))
+#define XOR5(a, b, c, d, e) XOR(XOR(XOR(a, b), XOR(c, d)), (e))
+#define ROL(a, n)  _mm256_or_si256(_mm256_slli_epi64((a), (n)), \
+                                   _mm256_srli_epi64((a), 64 - (n)))
+#define CHI(a, b, c) XOR((a), _mm256_andnot_si256((b), (c)))
+
+__attribute__((target("avx2")))
+void web3c_keccakf_x4_avx2(uint64_t st[100])
+{
+    __m256i a[25];
+
+    for (int i = 0; i < 25; ++i) {
+        a[i] = _mm256_loadu_si256((const __m256i *)(st + 4 * i));
+    }
+
+    for (int round = 0; round < 24; ++round) {
+        WEB3C_KECCAK_VROUND(a, _mm256_set1_epi64x(
+            (long long)web3c_keccakf_rndc[round]));
+    }
+
+    for (int i = 0; i < 25; ++i) {
+        _mm256_storeu_si256((__m256i *)(st + 4 * i), a[i]);
+    }
+}
+
+#undef V
+#undef XOR
+#undef XOR5
+#undef ROL
+#undef CHI
+
+/* ---- AVX-512: eight sponges per permutation ---- */
+
+#define V          __m512i
+#define XOR(a, b)  _mm512_xor_si512((a), (b))
+#define XOR5(a, b, c, d, e) \
+    _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64((a), (b), (c), 0x96), \
+                              (d), (e), 0x96)
+#define ROL(a, n)  _mm512_rol_epi64((a), (n))
+#define CHI(a, b, c) _mm512_ternarylogic_epi64((a), (b), (c), 0xD2)
+
+__attribute__((target("avx512f")))
+void web3c_keccakf_x8_avx512(uint64_t st[200])
+{
+    __m512i a[25];
+
+    for (int i = 0; i < 25; ++i) {
+        a[i] = _mm512_loadu_si512((const void *)(st + 8 * i));
+    }
+
+    for (int round = 0; round < 24; ++round) {
+        WEB3C_KECCAK_VROUND(a, _mm512_set1_epi64(
+            (long long)web3c_keccakf_rndc[round]));
+    }
+
+    for (int i = 0; i < 25; ++i) {
+        _mm512_storeu_si512((void *)(st + 8 * i), a[i]);
+    }
+}
+
+#undef V
+#undef XOR
+#undef XOR5
+#undef ROL
+#undef CHI
+
+/* ---- AVX-512: single state, one plane per register ---- */
+
+/*
+ * Each zmm register holds one row (plane y) of five lanes, lane x in
+ * element x; elements 5..7 are don't-care. Theta reduces the five rows
+ * with vpternlogq and rotates the column parities with vpermq, rho is
+ * a per-element vprolvq, and pi is a per-row element permutation that
+ * leaves the state in column layout (register x, element y), where chi
+ * is a single vpternlogq per register. A 5x5 transpose brings the state
+ * back to row layout for the next round.
+ */
+__attribute__((target("avx512f")))
+void web3c_keccakf_avx512(uint64_t st[25])
+{
+    const __mmask8 m5 = 0x1F;
+
+    const __m512i theta_prev = _mm512_setr_epi64(4, 0, 1, 2, 3, 5, 6, 7);
+    const __m512i theta_next = _mm512_setr_epi64(1, 2, 3, 4, 0, 5, 6, 7);
+
+    const __m512i rho0 = _mm512_setr_epi64( 0,  1, 62, 28, 27, 0, 0, 0);
+    const __m512i rho1 = _mm512_setr_epi64(36, 44,  6, 55, 20, 0, 0, 0);
+    const __m512i rho2 = _mm512_setr_epi64( 3, 10, 43, 25, 39, 0, 0, 0);
+    const __m512i rho3 = _mm512_setr_epi64(41, 45, 15, 21,  8, 0, 0, 0);
+    const __m512i rho4 = _mm512_setr_epi64(18,  2, 61, 56, 14, 0, 0, 0);
+
+    /* pi: element r of column y takes lane 3 * (r - 3y) mod 5 of row y. */
+    const __m512i pi0 = _mm512_setr_epi64(0, 3, 1, 4, 2, 5, 6, 7);
+    const __m512i pi1 = _mm512_setr_epi64(1, 4, 2, 0, 3, 5, 6, 7);
+    const __m512i pi2 = _mm512_setr_epi64(2, 0, 3, 1, 4, 5, 6, 7);
+    const __m512i pi3 = _mm512_setr_epi64(3, 1, 4, 2, 0, 5, 6, 7);
+    const __m512i pi4 = _mm512_setr_epi64(4, 2, 0, 3, 1, 5, 6, 7);
+
+    /* Transpose helpers: interleave two columns, then gather rows. */
+    const __m512i zip_lo = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    const __m512i zip_hi = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    const __m512i row0 = _mm512_setr_epi64(0, 1,  8,  9, 0, 0, 0, 0);
+    const __m512i row1 = _mm512_setr_epi64(2, 3, 10, 11, 0, 0, 0, 0);
+    const __m512i row2 = _mm512_setr_epi64(4, 5, 12, 13, 0, 0, 0, 0);
+    const __m512i row3 = _mm512_setr_epi64(6, 7, 14, 15, 0, 0, 0, 0);
+
+    __m512i r0 = _mm512_maskz_loadu_epi64(m5, st + 0);
+    __m512i r1 = _mm512_maskz_loadu_epi64(m5, st + 5);
+    __m512i r2 = _mm512_maskz_loadu_epi64(m5, st + 10);
+    __m512i r3 = _mm512_maskz_loadu_epi64(m5, st + 15);
+    __m512i r4 = _mm512_maskz_loadu_epi64(m5, st + 20);
+
+    for (int round = 0; round < 24; ++round) {
+        /* Theta */
+        __m512i c = _mm512_ternarylogic_epi64(
+            _mm512_ternarylogic_epi64(r0, r1, r2, 0x96), r3, r4, 0x96);
+        __m512i cp = _mm512_permutexvar_epi64(theta_prev, c);
+        __m512i cn = _mm512_rol_epi64(_mm512_permutexvar_epi64(theta_next, c), 1);
+
+        r0 = _mm512_ternarylogic_epi64(r0, cp, cn, 0x96);
+        r1 = _mm512_ternarylogic_epi64(r1, cp, cn, 0x96);
+        r2 = _mm512_ternarylogic_epi64(r2, cp, cn, 0x96);
+        r3 = _mm512_ternarylogic_epi64(r3, cp, cn, 0x96);
+        r4 = _mm512_ternarylogic_epi64(r4, cp, cn, 0x96);
+
+        /* Rho and pi: row y becomes column y. */
+        __m512i k0 = _mm512_permutexvar_epi64(pi0, _mm512_rolv_epi64(r0, rho0));
+        __m512i k1 = _mm512_permutexvar_epi64(pi1, _mm512_rolv_epi64(r1, rho1));
+        __m512i k2 = _mm512_permutexvar_epi64(pi2, _mm512_rolv_epi64(r2, rho2));
+        __m512i k3 = _mm512_permutexvar_epi64(pi3, _mm512_rolv_epi64(r3, rho3));
+        __m512i k4 = _mm512_permutexvar_epi64(pi4, _mm512_rolv_epi64(r4, rho4));
+
+        /* Chi works across columns, so it needs no permutes here. */
+        __m512i x0 = _mm512_ternarylogic_epi64(k0, k1, k2, 0xD2);
+        __m512i x1 = _mm512_ternarylogic_epi64(k1, k2, k3, 0xD2);
+        __m512i x2 = _mm512_ternarylogic_epi64(k2, k3, k4, 0xD2);
+        __m512i x3 = _mm512_ternarylogic_epi64(k3, k4, k0, 0xD2);
+        __m512i x4 = _mm512_ternarylogic_epi64(k4, k0, k1, 0xD2);
+
+        /* Iota */
+        x0 = _mm512_mask_xor_epi64(x0, 0x01, x0,
+                 _mm512_set1_epi64((long long)web3c_keccakf_rndc[round]));
+
+        /* Transpose columns back to rows. */
+        __m512i t01l = _mm512_permutex2var_epi64(x0, zip_lo, x1);
+        __m512i t23l = _mm512_permutex2var_epi64(x2, zip_lo, x3);
+        __m512i t01h = _mm512_permutex2var_epi64(x0, zip_hi, x1);
+        __m512i t23h = _mm512_permutex2var_epi64(x2, zip_hi, x3);
+
+        r0 = _mm512_permutex2var_epi64(t01l, row0, t23l);
+        r1 = _mm512_permutex2var_epi64(t01l, row1, t23l);
+        r2 = _mm512_permutex2var_epi64(t01l, row2, t23l);
+        r3 = _mm512_permutex2var_epi64(t01l, row3, t23l);
+        r4 = _mm512_permutex2var_epi64(t01h, row0, t23h);
+
+        r0 = _mm512_mask_permutexvar_epi64(r0, 0x10, _mm512_set1_epi64(0), x4);
+        r1 = _mm512_mask_permutexvar_epi64(r1, 0x10, _mm512_set1_epi64(1), x4);
+        r2 = _mm512_mask_permutexvar_epi64(r2, 0x10, _mm512_set1_epi64(2), x4);
+        r3 = _mm512_mask_permutexvar_epi64(r3, 0x10, _mm512_set1_epi64(3), x4);
+        r4 = _mm512_mask_permutexvar_epi64(r4, 0x10, _mm512_set1_epi64(4), x4);
+    }
+
+    _mm512_mask_storeu_epi64(st + 0,  m5, r0);
+    _mm512_mask_storeu_epi64(st + 5,  m5, r1);
+    _mm512_mask_storeu_epi64(st + 10, m5, r2);
+    _mm512_mask_storeu_epi64(st + 15, m5, r3);
+    _mm512_mask_storeu_epi64(st + 20, m5, r4);
+}
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int web3c_keccak_x86_unused;
+
+#endif /* WEB3C_KECCAK_X86 */
@@ -1,66 +1,28 @@
 #include "web3c/rlp.h"
+#include "web3c_rlp_internal.h"
 
 #include <string.h>
 
+/* Header for a string (base 0x80) or list (base 0xC0) payload of len. */
 static int rlp_write_length(size_t len,
-                            uint8_t short_base,
-                            uint8_t long_base,
+                            uint8_t base,
                             uint8_t *out,
                             size_t out_size,
                             size_t *out_len)
 {
-    if (len <= 55) {
-        size_t needed = 1;
-        if (out_len) {
-            *out_len = needed;
-        }
-        if (out == NULL) {
-            return 0;
-        }
-        if (out_size < needed) {
-            return -1;
-        }
-        out[0] = (uint8_t)(short_base + len);
+    size_t needed = len <= 55 ? 1 : 1 + web3c_rlp_be_len64((uint64_t)len);
+
+    if (out_len) {
+        *out_len = needed;
+    }
+    if (out == NULL) {
         return 0;
     }
-
-    /* Long form: base + lenlen, then len in big-endian. */
-    uint8_t tmp[sizeof(size_t)];
-    size_t tmp_len = 0;
-
-    {
-        size_t v = len;
-        /* Build big-endian representation without leading zeros. */
-        for (int i = (int)(sizeof(size_t) - 1); i >= 0; --i) {
-            tmp[i] = (uint8_t)(v & 0xFF);
-            v >>= 8;
-        }
-        size_t i = 0;
-        while (i < sizeof(size_t) && tmp[i] == 0) {
-            ++i;
-        }
-        tmp_len = sizeof(size_t) - i;
-        if (tmp_len == 0) {
-            tmp_len = 1;
-            tmp[sizeof(size_t) - 1] = 0;
-            i = sizeof(size_t) - 1;
-        }
-
-        size_t needed = 1 + tmp_len;
-        if (out_len) {
-            *out_len = needed;
-        }
-        if (out == NULL) {
-            return 0;
-        }
-        if (out_size < needed) {
-            return -1;
-        }
-
-        out[0] = (uint8_t)(long_base + tmp_len);
-        memcpy(out + 1, tmp + i, tmp_len);
+    if (out_size < needed) {
+        return -1;
     }
 
+    web3c_rlp_put_length(out, len, base);
     return 0;
 }
 
@@ -69,59 +31,34 @@ int web3c_rlp_encode_uint64(uint64_t value,
                             size_t out_size,
                             size_t *out_len)
 {
-    /* Special case: zero -> empty string (0x80). */
-    if (value == 0) {
-        size_t needed = 1;
-        if (out_len) {
-            *out_len = needed;
-        }
-        if (out == NULL) {
-            return 0;
-        }
-        if (out_size < needed) {
-            return -1;
-        }
-        out[0] = 0x80;
+    /* Length from clz; bytes from one byte-swapped store. */
+    size_t needed = web3c_rlp_uint64_size(value);
+
+    if (out_len) {
+        *out_len = needed;
+    }
+    if (out == NULL) {
         return 0;
     }
-
-    /* Convert to big-endian bytes without leading zeros. */
-    uint8_t buf[8];
-    for (int i = 7; i >= 0; --i) {
-        buf[i] = (uint8_t)(value & 0xFF);
-        value >>= 8;
+    if (out_size < needed) {
+        return -1;
     }
 
-    size_t offset = 0;
-    while (offset < sizeof(buf) && buf[offset] == 0) {
-        ++offset;
-    }
-    size_t len = sizeof(buf) - offset;
+    web3c_rlp_put_uint64(out, value);
+    return 0;
+}
 
-    /* If single byte <= 0x7f, encode as itself. */
-    if (len == 1 && buf[offset] <= 0x7f) {
-        size_t needed = 1;
-        if (out_len) {
-            *out_len = needed;
-        }
-        if (out == NULL) {
-            return 0;
-        }
-        if (out_size < needed) {
-            return -1;
-        }
-        out[0] = buf[offset];
-        return 0;
+int web3c_rlp_encode_uint256(const uint8_t value[32],
+                             uint8_t *out,
+                             size_t out_size,
+                             size_t *out_len)
+{
+    if (value == NULL) {
+        return -1;
     }
 
-    /* Otherwise encode as a string. */
-    size_t prefix_len = 0;
-    int rc = rlp_write_length(len, 0x80, 0xb7, out, out_size, &prefix_len);
-    if (rc != 0) {
-        return rc;
-    }
+    size_t needed = web3c_rlp_uint256_size(value);
 
-    size_t needed = prefix_len + len;
     if (out_len) {
         *out_len = needed;
     }
@@ -132,10 +69,28 @@ int web3c_rlp_encode_uint64(uint64_t value,
         return -1;
     }
 
-    memcpy(out + prefix_len, buf + offset, len);
+    web3c_rlp_put_uint256(out, value);
     return 0;
 }
 
+int web3c_rlp_encode_uint256_limbs(const uint64_t limbs[4],
+                                   uint8_t *out,
+                                   size_t out_size,
+                                   size_t *out_len)
+{
+    uint8_t be[32];
+
+    if (limbs == NULL) {
+        return -1;
+    }
+
+    /* Most significant limb first. */
+    for (size_t i = 0; i < 4; ++i) {
+        web3c_rlp_store_be64(be + 8 * i, limbs[3 - i]);
+    }
+    return web3c_rlp_encode_uint256(be, out, out_size, out_len);
+}
+
 int web3c_rlp_encode_bytes(const uint8_t *data,
                            size_t len,
                            uint8_t *out,
@@ -179,7 +134,7 @@ int web3c_rlp_encode_bytes(const uint8_t *data,
     }
 
     size_t prefix_len = 0;
-    int rc = rlp_write_length(len, 0x80, 0xb7, out, out_size, &prefix_len);
+    int rc = rlp_write_length(len, 0x80, out, out_size, &prefix_len);
     if (rc != 0) {
         return rc;
     }
@@ -204,6 +159,505 @@ int web3c_rlp_encode_list_header(size_t payload_len,
                                  size_t out_size,
                                  size_t *out_len)
 {
-    return rlp_write_length(payload_len, 0xC0, 0xF7,
-                            out, out_size, out_len);
-}
\ No newline at end of file
+    return rlp_write_length(payload_len, 0xC0, out, out_size, out_len);
+}
+
+int web3c_rlp_encode_bytes_header(const uint8_t *data,
+                                  size_t len,
+                                  uint8_t *out,
+                                  size_t out_size,
+                                  size_t *out_len)
+{
+    if (len == 1 && data == NULL) {
+        return -1;
+    }
+
+    /* Single byte in [0x00, 0x7f]: no header. */
+    if (len == 1 && data[0] <= 0x7f) {
+        if (out_len) {
+            *out_len = 0;
+        }
+        return 0;
+    }
+
+    return rlp_write_length(len, 0x80, out, out_size, out_len);
+}
+
+/* Header size for a payload of len bytes (string or list). */
+static size_t rlp_header_size(size_t len)
+{
+    return len <= 55 ? 1 : 1 + web3c_rlp_be_len64((uint64_t)len);
+}
+
+size_t web3c_rlp_uint64_size(uint64_t value)
+{
+    return value <= 0x7f ? 1 : 1 + web3c_rlp_be_len64(value);
+}
+
+size_t web3c_rlp_uint256_size(const uint8_t value[32])
+{
+    if (value == NULL) {
+        return 0;
+    }
+
+    size_t n = web3c_rlp_be_len256(value);
+    return n <= 1 && value[31] <= 0x7f ? 1 : 1 + n;
+}
+
+size_t web3c_rlp_bytes_size(const uint8_t *data, size_t len)
+{
+    if (len == 1 && data != NULL && data[0] <= 0x7f) {
+        return 1;
+    }
+    return rlp_header_size(len) + len;
+}
+
+size_t web3c_rlp_list_size(size_t payload_len)
+{
+    return rlp_header_size(payload_len) + payload_len;
+}
+
+/* Largest RLP header: prefix byte + 8 length bytes. */
+#define RLP_MAX_HEADER 9
+
+/* Reserve n data bytes; NULL (and the sticky error) if they do not fit. */
+static uint8_t *rlp_builder_reserve(web3c_rlp_builder *b, size_t n)
+{
+    if (b->error || n > b->limit - b->pos) {
+        b->error = 1;
+        return NULL;
+    }
+
+    uint8_t *p = b->buf + b->pos;
+    b->pos += n;
+    return p;
+}
+
+void web3c_rlp_builder_init(web3c_rlp_builder *b, uint8_t *buf, size_t size)
+{
+    if (b == NULL) {
+        return;
+    }
+
+    memset(b, 0, sizeof(*b));
+    b->buf   = buf;
+    b->size  = buf == NULL ? 0 : size;
+    b->limit = b->size;
+}
+
+int web3c_rlp_builder_begin_list(web3c_rlp_builder *b)
+{
+    if (b == NULL) {
+        return -1;
+    }
+    if (b->depth == WEB3C_RLP_BUILDER_DEPTH ||
+        b->limit - b->pos < RLP_MAX_HEADER + sizeof(size_t)) {
+        b->error = 1;
+    }
+    if (b->error) {
+        return -1;
+    }
+
+    size_t start = b->pos;
+
+    /* Log entries grow down from the end, in begin (= offset) order. */
+    b->limit -= sizeof(size_t);
+    b->n_lists++;
+    memcpy(b->buf + b->limit, &start, sizeof(size_t));
+
+    b->open[b->depth].start = start;
+    b->open[b->depth].gaps  = 0;
+    b->depth++;
+    b->pos += RLP_MAX_HEADER;
+    return 0;
+}
+
+int web3c_rlp_builder_end_list(web3c_rlp_builder *b)
+{
+    if (b == NULL) {
+        return -1;
+    }
+    if (b->depth == 0) {
+        b->error = 1;
+    }
+    if (b->error) {
+        return -1;
+    }
+
+    size_t start   = b->open[b->depth - 1].start;
+    size_t gaps    = b->open[b->depth - 1].gaps;
+    size_t payload = b->pos - (start + RLP_MAX_HEADER) - gaps;
+    size_t header  = rlp_header_size(payload);
+
+    if (header == RLP_MAX_HEADER) {
+        /* Payloads of 2^56 bytes and more leave no room for the gap. */
+        b->error = 1;
+        return -1;
+    }
+
+    /* Header right-aligned in the slot; the gap's first byte holds its size. */
+    size_t gap = RLP_MAX_HEADER - header;
+    web3c_rlp_put_length(b->buf + start + gap, payload, 0xC0);
+    b->buf[start] = (uint8_t)gap;
+
+    b->depth--;
+    if (b->depth > 0) {
+        b->open[b->depth - 1].gaps += gaps + gap;
+    }
+    return 0;
+}
+
+int web3c_rlp_builder_append_uint64(web3c_rlp_builder *b, uint64_t value)
+{
+    if (b == NULL) {
+        return -1;
+    }
+
+    uint8_t *p = rlp_builder_reserve(b, web3c_rlp_uint64_size(value));
+    if (p == NULL) {
+        return -1;
+    }
+    web3c_rlp_put_uint64(p, value);
+    return 0;
+}
+
+int web3c_rlp_builder_append_uint256(web3c_rlp_builder *b, const uint8_t value[32])
+{
+    if (b == NULL) {
+        return -1;
+    }
+    if (value == NULL) {
+        b->error = 1;
+        return -1;
+    }
+
+    uint8_t *p = rlp_builder_reserve(b, web3c_rlp_uint256_size(value));
+    if (p == NULL) {
+        return -1;
+    }
+    web3c_rlp_put_uint256(p, value);
+    return 0;
+}
+
+int web3c_rlp_builder_append_bytes(web3c_rlp_builder *b,
+                                   const uint8_t *data,
+                                   size_t len)
+{
+    if (b == NULL) {
+        return -1;
+    }
+    if (data == NULL && len != 0) {
+        b->error = 1;
+        return -1;
+    }
+
+    size_t   size = web3c_rlp_bytes_size(data, len);
+    uint8_t *p    = size < len ? NULL : rlp_builder_reserve(b, size);
+    if (p == NULL) {
+        b->error = 1;
+        return -1;
+    }
+    web3c_rlp_put_bytes(p, data, len);
+    return 0;
+}
+
+int web3c_rlp_builder_append_raw(web3c_rlp_builder *b,
+                                 const uint8_t *encoded,
+                                 size_t len)
+{
+    if (b == NULL) {
+        return -1;
+    }
+    if (encoded == NULL && len != 0) {
+        b->error = 1;
+        return -1;
+    }
+
+    uint8_t *p = rlp_builder_reserve(b, len);
+    if (p == NULL) {
+        return -1;
+    }
+    if (len > 0) {
+        memcpy(p, encoded, len);
+    }
+    return 0;
+}
+
+int web3c_rlp_builder_finish(web3c_rlp_builder *b, size_t *out_len)
+{
+    if (b == NULL || b->error || b->depth != 0) {
+        return -1;
+    }
+
+    /*
+     * One forward pass over the gap log (sorted by offset): slide each
+     * stretch of data between two gaps down over the gaps before it.
+     */
+    size_t src = 0;
+    size_t dst = 0;
+
+    for (size_t i = 1; i <= b->n_lists; ++i) {
+        size_t start;
+
+        memcpy(&start, b->buf + b->size - i * sizeof(size_t), sizeof(size_t));
+        if (dst != src) {
+            memmove(b->buf + dst, b->buf + src, start - src);
+        }
+        dst += start - src;
+        src  = start + b->buf[start];
+    }
+    if (dst != src) {
+        memmove(b->buf + dst, b->buf + src, b->pos - src);
+    }
+    dst += b->pos - src;
+
+    /* The builder is reusable for appending after the finished data. */
+    b->pos     = dst;
+    b->limit   = b->size;
+    b->n_lists = 0;
+
+    if (out_len) {
+        *out_len = dst;
+    }
+    return 0;
+}
+
+/*
+ * Parse a long-form length of lenlen bytes. Canonical lengths have no
+ * leading zero byte and do not fit the short form (> 55).
+ */
+static int rlp_read_length(const uint8_t *p, size_t lenlen, size_t *len)
+{
+    size_t v = 0;
+
+    if (lenlen > sizeof(size_t) || p[0] == 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < lenlen; ++i) {
+        v = (v << 8) | p[i];
+    }
+    if (v <= 55) {
+        return -1;
+    }
+
+    *len = v;
+    return 0;
+}
+
+/*
+ * Parse and check the header at in[0] (in_len > 0): payload starts at
+ * in + *header and spans *len bytes, all within in_len. A single byte
+ * below 0x80 is its own payload (*header == 0).
+ */
+static int rlp_parse_header(const uint8_t *in,
+                            size_t in_len,
+                            web3c_rlp_type *type,
+                            size_t *header,
+                            size_t *len)
+{
+    uint8_t b = in[0];
+
+    *type   = b <= 0xbf ? WEB3C_RLP_STRING : WEB3C_RLP_LIST;
+    *header = 1;
+    *len    = 0;
+
+    if (b <= 0x7f) {
+        /* Single byte, its own encoding. */
+        *header = 0;
+        *len    = 1;
+        return 0;
+    }
+
+    if (b <= 0xb7) {
+        *len = (size_t)(b - 0x80);
+    } else if (b <= 0xbf) {
+        *header += (size_t)(b - 0xb7);
+    } else if (b <= 0xf7) {
+        *len = (size_t)(b - 0xc0);
+    } else {
+        *header += (size_t)(b - 0xf7);
+    }
+
+    if (*header > in_len) {
+        return -1;
+    }
+    if (*header > 1 && rlp_read_length(in + 1, *header - 1, len) != 0) {
+        return -1;
+    }
+    if (*len > in_len - *header) {
+        return -1;
+    }
+
+    /* A single byte below 0x80 must be encoded as itself. */
+    if (*type == WEB3C_RLP_STRING && *len == 1 && in[1] <= 0x7f) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int web3c_rlp_decode(const uint8_t *in, size_t in_len, web3c_rlp_item *item)
+{
+    size_t header = 0;
+    size_t len    = 0;
+
+    if (in == NULL || item == NULL || in_len == 0) {
+        return -1;
+    }
+
+    if (rlp_parse_header(in, in_len, &item->type, &header, &len) != 0) {
+        return -1;
+    }
+
+    item->data = in + header;
+    item->len  = len;
+    item->raw  = in;
+    item->size = header + len;
+    return 0;
+}
+
+int web3c_rlp_validate(const uint8_t *in,
+                       size_t in_len,
+                       size_t max_depth,
+                       size_t *err_offset)
+{
+    /* ends[d]: offset where the list open at depth d + 1 ends. */
+    size_t ends[WEB3C_RLP_MAX_DEPTH];
+    size_t depth = 0;
+    size_t pos   = 0;
+
+    if (in == NULL || in_len == 0) {
+        if (err_offset) {
+            *err_offset = 0;
+        }
+        return -1;
+    }
+    if (max_depth > WEB3C_RLP_MAX_DEPTH) {
+        max_depth = WEB3C_RLP_MAX_DEPTH;
+    }
+
+    /*
+     * One header per iteration. String payloads are skipped by length,
+     * never read, so the cost is proportional to the number of items.
+     */
+    do {
+        size_t         limit = depth > 0 ? ends[depth - 1] : in_len;
+        web3c_rlp_type type;
+        size_t         header, len;
+
+        if (rlp_parse_header(in + pos, limit - pos, &type, &header, &len) != 0) {
+            break;
+        }
+
+        if (type == WEB3C_RLP_LIST) {
+            if (depth == max_depth) {
+                break;
+            }
+            ends[depth++] = pos + header + len;
+            pos += header;
+        } else {
+            pos += header + len;
+        }
+
+        /* Close every list that ends here. */
+        while (depth > 0 && pos == ends[depth - 1]) {
+            --depth;
+        }
+    } while (depth > 0);
+
+    /* Done only when the top-level item spans the whole input. */
+    if (depth == 0 && pos == in_len) {
+        return 0;
+    }
+
+    if (err_offset) {
+        *err_offset = pos;
+    }
+    return -1;
+}
+
+int web3c_rlp_iter_init(web3c_rlp_iter *it, const web3c_rlp_item *list)
+{
+    if (it == NULL || list == NULL || list->type != WEB3C_RLP_LIST) {
+        return -1;
+    }
+
+    it->pos = list->data;
+    it->end = list->data + list->len;
+    return 0;
+}
+
+int web3c_rlp_iter_next(web3c_rlp_iter *it, web3c_rlp_item *item)
+{
+    if (it == NULL || item == NULL) {
+        return -1;
+    }
+    if (it->pos == it->end) {
+        return 0;
+    }
+
+    if (web3c_rlp_decode(it->pos, (size_t)(it->end - it->pos), item) != 0) {
+        return -1;
+    }
+    it->pos += item->size;
+    return 1;
+}
+
+int web3c_rlp_list_get(const web3c_rlp_item *list,
+                       size_t index,
+                       web3c_rlp_item *item)
+{
+    web3c_rlp_iter it;
+
+    if (item == NULL || web3c_rlp_iter_init(&it, list) != 0) {
+        return -1;
+    }
+
+    for (size_t i = 0; i <= index; ++i) {
+        if (web3c_rlp_iter_next(&it, item) != 1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int web3c_rlp_list_count(const web3c_rlp_item *list, size_t *count)
+{
+    web3c_rlp_iter it;
+    web3c_rlp_item item;
+    size_t         n = 0;
+    int            rc;
+
+    if (count == NULL || web3c_rlp_iter_init(&it, list) != 0) {
+        return -1;
+    }
+
+    while ((rc = web3c_rlp_iter_next(&it, &item)) == 1) {
+        ++n;
+    }
+    if (rc != 0) {
+        return -1;
+    }
+
+    *count = n;
+    return 0;
+}
+
+int web3c_rlp_item_uint64(const web3c_rlp_item *item, uint64_t *value)
+{
+    uint64_t v = 0;
+
+    if (item == NULL || value == NULL || item->type != WEB3C_RLP_STRING) {
+        return -1;
+    }
+    if (item->len > 8 || (item->len > 0 && item->data[0] == 0)) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < item->len; ++i) {
+        v = (v << 8) | item->data[i];
+    }
+
+    *value = v;
+    return 0;
+}
@@ -0,0 +1,157 @@
+#ifndef WEB3C_RLP_INTERNAL_H
+#define WEB3C_RLP_INTERNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * Unchecked RLP writers shared by web3c_rlp.c and the transaction
+ * encoders. Callers size the whole output first (web3c_rlp_*_size())
+ * and check it once; each writer then returns the end of what it wrote.
+ *
+ * Not part of the public API.
+ */
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define WEB3C_RLP_LE 1
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define WEB3C_RLP_BE 1
+#endif
+
+/* Leading zero bits of a non-zero value. */
+static inline unsigned web3c_rlp_clz64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_clzll(v);
+#else
+    unsigned n = 0;
+
+    while ((v & 0x8000000000000000ull) == 0) {
+        v <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/* Bytes of the big-endian form of v without leading zeros (0 for 0). */
+static inline size_t web3c_rlp_be_len64(uint64_t v)
+{
+    return v == 0 ? 0 : (size_t)(71 - web3c_rlp_clz64(v)) >> 3;
+}
+
+/* Store all 8 bytes of v big-endian. */
+static inline void web3c_rlp_store_be64(uint8_t *p, uint64_t v)
+{
+#if defined(WEB3C_RLP_LE) && (defined(__GNUC__) || defined(__clang__))
+    v = __builtin_bswap64(v);
+    memcpy(p, &v, 8);
+#elif defined(WEB3C_RLP_BE)
+    memcpy(p, &v, 8);
+#else
+    for (int i = 0; i < 8; ++i) {
+        p[i] = (uint8_t)(v >> (56 - 8 * i));
+    }
+#endif
+}
+
+static inline uint64_t web3c_rlp_load_be64(const uint8_t *p)
+{
+#if defined(WEB3C_RLP_LE) && (defined(__GNUC__) || defined(__clang__))
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return __builtin_bswap64(v);
+#elif defined(WEB3C_RLP_BE)
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+#else
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+#endif
+}
+
+/* Write the low n bytes of v big-endian (n <= 8). */
+static inline uint8_t *web3c_rlp_put_be(uint8_t *p, uint64_t v, size_t n)
+{
+    uint8_t be[8];
+
+    web3c_rlp_store_be64(be, v);
+    memcpy(p, be + 8 - n, n);
+    return p + n;
+}
+
+/* String (base 0x80) or list (base 0xC0) header for a payload of len. */
+static inline uint8_t *web3c_rlp_put_length(uint8_t *p, size_t len, uint8_t base)
+{
+    if (len <= 55) {
+        *p = (uint8_t)(base + len);
+        return p + 1;
+    }
+
+    size_t n = web3c_rlp_be_len64((uint64_t)len);
+    *p = (uint8_t)(base + 55 + n);
+    return web3c_rlp_put_be(p + 1, (uint64_t)len, n);
+}
+
+static inline uint8_t *web3c_rlp_put_uint64(uint8_t *p, uint64_t v)
+{
+    if (v <= 0x7f) {
+        *p = v == 0 ? 0x80 : (uint8_t)v;
+        return p + 1;
+    }
+
+    size_t n = web3c_rlp_be_len64(v);
+    *p = (uint8_t)(0x80 + n);
+    return web3c_rlp_put_be(p + 1, v, n);
+}
+
+static inline uint8_t *web3c_rlp_put_bytes(uint8_t *p, const uint8_t *data, size_t len)
+{
+    if (len == 1 && data[0] <= 0x7f) {
+        *p = data[0];
+        return p + 1;
+    }
+
+    p = web3c_rlp_put_length(p, len, 0x80);
+    if (len > 0) {
+        memcpy(p, data, len);
+    }
+    return p + len;
+}
+
+/*
+ * Minimal big-endian length of a 256-bit big-endian value: index of the
+ * top non-zero 64-bit word plus clz within it.
+ */
+static inline size_t web3c_rlp_be_len256(const uint8_t value[32])
+{
+    for (size_t i = 0; i < 4; ++i) {
+        uint64_t w = web3c_rlp_load_be64(value + 8 * i);
+        if (w != 0) {
+            return 8 * (3 - i) + web3c_rlp_be_len64(w);
+        }
+    }
+    return 0;
+}
+
+/* A 256-bit big-endian integer: its minimal bytes are a suffix of value. */
+static inline uint8_t *web3c_rlp_put_uint256(uint8_t *p, const uint8_t value[32])
+{
+    size_t n = web3c_rlp_be_len256(value);
+
+    if (n <= 1 && value[31] <= 0x7f) {
+        *p = value[31] == 0 ? 0x80 : value[31];
+        return p + 1;
+    }
+
+    *p = (uint8_t)(0x80 + n);
+    memcpy(p + 1, value + 32 - n, n);
+    return p + 1 + n;
+}
+
+#endif /* WEB3C_RLP_INTERNAL_H */
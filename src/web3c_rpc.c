@@ -0,0 +1,315 @@
+#include "web3c/rpc.h"
+#include "web3c/hex.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static const char rpc_hex_chars[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+};
+
+/* Leading zero bits of a non-zero value. */
+static unsigned rpc_clz64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_clzll(v);
+#else
+    unsigned n = 0;
+
+    while ((v & 0x8000000000000000ull) == 0) {
+        v <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/*
+ * Minimal hex digits of v, 1 for zero: v | 1 has the same bit length
+ * as v except that zero becomes one bit long.
+ */
+static size_t rpc_digits64(uint64_t v)
+{
+    return (64 - rpc_clz64(v | 1) + 3) >> 2;
+}
+
+static uint64_t rpc_load_be64(const uint8_t *p)
+{
+    uint64_t v = 0;
+
+    for (int i = 0; i < 8; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/* Index of the first non-zero 64-bit word of a 256-bit word (3 if zero). */
+static size_t rpc_top_word(const uint8_t word[32], uint64_t *top)
+{
+    size_t i = 0;
+
+    *top = rpc_load_be64(word);
+    while (*top == 0 && i < 3) {
+        ++i;
+        *top = rpc_load_be64(word + 8 * i);
+    }
+    return i;
+}
+
+/* len + n, saturating at SIZE_MAX. */
+static size_t rpc_add(size_t len, size_t n)
+{
+    return n > SIZE_MAX - len ? SIZE_MAX : len + n;
+}
+
+/*
+ * Advance the cursor by n bytes. Returns where to write them, or NULL
+ * when they do not fit (the cursor still advances).
+ */
+static char *rpc_reserve(web3c_rpc_buf *b, size_t n)
+{
+    size_t start = b->len;
+
+    b->len = rpc_add(b->len, n);
+    if (b->buf == NULL || b->len > b->size) {
+        return NULL;
+    }
+    return b->buf + start;
+}
+
+/* Write v as exactly `digits` hex digits. */
+static void rpc_write_digits64(char *p, uint64_t v, size_t digits)
+{
+    while (digits-- > 0) {
+        p[digits] = rpc_hex_chars[v & 0x0F];
+        v >>= 4;
+    }
+}
+
+static char *rpc_write_quantity_u64(char *p, uint64_t value)
+{
+    size_t digits = rpc_digits64(value);
+
+    p[0] = '"';
+    p[1] = '0';
+    p[2] = 'x';
+    rpc_write_digits64(p + 3, value, digits);
+    p[3 + digits] = '"';
+    return p + 4 + digits;
+}
+
+static char *rpc_write_quantity_u256(char *p, const uint8_t word[32])
+{
+    uint64_t top;
+    size_t   i      = rpc_top_word(word, &top);
+    size_t   digits = rpc_digits64(top);
+    size_t   rest   = 8 * (3 - i);
+
+    p[0] = '"';
+    p[1] = '0';
+    p[2] = 'x';
+    rpc_write_digits64(p + 3, top, digits);
+    p += 3 + digits;
+
+    /* Lower words keep all their digits. */
+    web3c_hex_encode_raw(word + 32 - rest, rest, p, 2 * rest);
+    p[2 * rest] = '"';
+    return p + 2 * rest + 1;
+}
+
+static char *rpc_write_data(char *p, const uint8_t *data, size_t len)
+{
+    p[0] = '"';
+    p[1] = '0';
+    p[2] = 'x';
+    web3c_hex_encode_raw(data, len, p + 3, 2 * len);
+    p[3 + 2 * len] = '"';
+    return p + 4 + 2 * len;
+}
+
+/* Quoted DATA size, saturating for absurd lengths. */
+static size_t rpc_data_size(size_t len)
+{
+    return len > (SIZE_MAX - 4) / 2 ? SIZE_MAX : 2 * len + 4;
+}
+
+void web3c_rpc_buf_init(web3c_rpc_buf *b, char *buf, size_t size)
+{
+    if (b == NULL) {
+        return;
+    }
+    b->buf  = buf;
+    b->size = buf == NULL ? 0 : size;
+    b->len  = 0;
+}
+
+int web3c_rpc_put_raw(web3c_rpc_buf *b, const char *text, size_t text_len)
+{
+    if (b == NULL || (text == NULL && text_len != 0)) {
+        return -1;
+    }
+
+    char *p = rpc_reserve(b, text_len);
+    if (p == NULL) {
+        return -1;
+    }
+    if (text_len > 0) {
+        memcpy(p, text, text_len);
+    }
+    return 0;
+}
+
+size_t web3c_rpc_quantity_u64_len(uint64_t value)
+{
+    return 2 + rpc_digits64(value);
+}
+
+size_t web3c_rpc_quantity_u256_len(const uint8_t word[32])
+{
+    uint64_t top;
+    size_t   i;
+
+    if (word == NULL) {
+        return 0;
+    }
+    i = rpc_top_word(word, &top);
+    return 2 + 16 * (3 - i) + rpc_digits64(top);
+}
+
+int web3c_rpc_put_quantity_u64(web3c_rpc_buf *b, uint64_t value)
+{
+    if (b == NULL) {
+        return -1;
+    }
+
+    char *p = rpc_reserve(b, web3c_rpc_quantity_u64_len(value) + 2);
+    if (p == NULL) {
+        return -1;
+    }
+    rpc_write_quantity_u64(p, value);
+    return 0;
+}
+
+int web3c_rpc_put_quantity_u256(web3c_rpc_buf *b, const uint8_t word[32])
+{
+    if (b == NULL || word == NULL) {
+        return -1;
+    }
+
+    char *p = rpc_reserve(b, web3c_rpc_quantity_u256_len(word) + 2);
+    if (p == NULL) {
+        return -1;
+    }
+    rpc_write_quantity_u256(p, word);
+    return 0;
+}
+
+int web3c_rpc_put_data(web3c_rpc_buf *b, const uint8_t *data, size_t len)
+{
+    if (b == NULL || (data == NULL && len != 0)) {
+        return -1;
+    }
+
+    char *p = rpc_reserve(b, rpc_data_size(len));
+    if (p == NULL) {
+        return -1;
+    }
+    rpc_write_data(p, data, len);
+    return 0;
+}
+
+int web3c_rpc_put_quantity_u64_array(web3c_rpc_buf *b,
+                                     const uint64_t *values,
+                                     size_t n)
+{
+    size_t total = 2 + (n > 0 ? n - 1 : 0);
+
+    if (b == NULL || (n > 0 && values == NULL)) {
+        return -1;
+    }
+
+    /* Each element: quotes + "0x" + digits. */
+    for (size_t i = 0; i < n; ++i) {
+        total = rpc_add(total, 4 + rpc_digits64(values[i]));
+    }
+
+    char *p = rpc_reserve(b, total);
+    if (p == NULL) {
+        return -1;
+    }
+
+    *p++ = '[';
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            *p++ = ',';
+        }
+        p = rpc_write_quantity_u64(p, values[i]);
+    }
+    *p = ']';
+    return 0;
+}
+
+int web3c_rpc_put_quantity_u256_array(web3c_rpc_buf *b,
+                                      const uint8_t (*words)[32],
+                                      size_t n)
+{
+    size_t total = 2 + (n > 0 ? n - 1 : 0);
+
+    if (b == NULL || (n > 0 && words == NULL)) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        total = rpc_add(total, 2 + web3c_rpc_quantity_u256_len(words[i]));
+    }
+
+    char *p = rpc_reserve(b, total);
+    if (p == NULL) {
+        return -1;
+    }
+
+    *p++ = '[';
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            *p++ = ',';
+        }
+        p = rpc_write_quantity_u256(p, words[i]);
+    }
+    *p = ']';
+    return 0;
+}
+
+int web3c_rpc_put_data_array(web3c_rpc_buf *b,
+                             const uint8_t *const *items,
+                             const size_t *lens,
+                             size_t n)
+{
+    size_t total = 2 + (n > 0 ? n - 1 : 0);
+
+    if (b == NULL || (n > 0 && (items == NULL || lens == NULL))) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (items[i] == NULL && lens[i] != 0) {
+            return -1;
+        }
+        total = rpc_add(total, rpc_data_size(lens[i]));
+    }
+
+    char *p = rpc_reserve(b, total);
+    if (p == NULL) {
+        return -1;
+    }
+
+    *p++ = '[';
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            *p++ = ',';
+        }
+        p = rpc_write_data(p, items[i], lens[i]);
+    }
+    *p = ']';
+    return 0;
+}
@@ -0,0 +1,1459 @@
+#include "web3c/secp256k1.h"
+#include "web3c/keccak.h"
+
+#include <string.h>
+
+/*
+ * Field elements (mod p) and scalars (mod n) are 4 little-endian 64-bit
+ * limbs, always fully reduced. Every reduction is a masked select, so no
+ * branch depends on the values.
+ *
+ * Field: p = 2^256 - c with c = 2^32 + 977, so a 512-bit product
+ * hi * 2^256 + lo reduces as hi * c + lo, folded twice.
+ *
+ * Scalars: Montgomery form (a * 2^256 mod n); only a handful of scalar
+ * operations run per signature.
+ *
+ * Points are homogeneous projective (X : Y : Z), x = X / Z, y = Y / Z,
+ * with the point at infinity (0 : 1 : 0).
+ */
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 secp_u128;
+#endif
+
+/* 2^256 - p */
+#define SECP_C 0x1000003d1ull
+
+typedef struct {
+    uint64_t m[4];   /* modulus */
+    uint64_t n0;     /* -m^-1 mod 2^64 */
+    uint64_t r2[4];  /* 2^512 mod m */
+    uint64_t one[4]; /* 2^256 mod m (1 in Montgomery form) */
+    uint64_t e[4];   /* m - 2, exponent for inversion */
+} secp_mod;
+
+static const secp_mod secp_n = {
+    { 0xbfd25e8cd0364141ull, 0xbaaedce6af48a03bull,
+      0xfffffffffffffffeull, 0xffffffffffffffffull },
+    0x4b0dff665588b13full,
+    { 0x896cf21467d7d140ull, 0x741496c20e7cf878ull,
+      0xe697f5e45bcd07c6ull, 0x9d671cd581c69bc5ull },
+    { 0x402da1732fc9bebfull, 0x4551231950b75fc4ull, 1, 0 },
+    { 0xbfd25e8cd036413full, 0xbaaedce6af48a03bull,
+      0xfffffffffffffffeull, 0xffffffffffffffffull }
+};
+
+/* n / 2: s above this is replaced by n - s. */
+static const uint64_t secp_n_half[4] = {
+    0xdfe92f46681b20a0ull, 0x5d576e7357a4501dull,
+    0xffffffffffffffffull, 0x7fffffffffffffffull
+};
+
+/* Generator, affine. */
+static const uint64_t secp_gx[4] = {
+    0x59f2815b16f81798ull, 0x029bfcdb2dce28d9ull,
+    0x55a06295ce870b07ull, 0x79be667ef9dcbbacull
+};
+static const uint64_t secp_gy[4] = {
+    0x9c47d08ffb10d4b8ull, 0xfd17b448a6855419ull,
+    0x5da4fbfc0e1108a8ull, 0x483ada7726a3c465ull
+};
+
+/* ---- 64-bit limb helpers ---- */
+
+/* a * b + c + d, low half returned, high half in *hi (cannot overflow). */
+static inline uint64_t secp_mac(uint64_t a, uint64_t b, uint64_t c, uint64_t d,
+                                uint64_t *hi)
+{
+#if defined(__SIZEOF_INT128__)
+    secp_u128 t = (secp_u128)a * b + c + d;
+
+    *hi = (uint64_t)(t >> 64);
+    return (uint64_t)t;
+#else
+    uint64_t al = a & 0xffffffffu, ah = a >> 32;
+    uint64_t bl = b & 0xffffffffu, bh = b >> 32;
+    uint64_t ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+    uint64_t lo  = (ll & 0xffffffffu) | (mid << 32);
+    uint64_t h   = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+    lo += c;
+    h  += lo < c;
+    lo += d;
+    h  += lo < d;
+    *hi = h;
+    return lo;
+#endif
+}
+
+/* a + b + *carry; *carry becomes the carry out (0 or 1). */
+static inline uint64_t secp_adc(uint64_t a, uint64_t b, uint64_t *carry)
+{
+#if defined(__SIZEOF_INT128__)
+    secp_u128 t = (secp_u128)a + b + *carry;
+
+    *carry = (uint64_t)(t >> 64);
+    return (uint64_t)t;
+#else
+    uint64_t t = a + *carry;
+    uint64_t c = t < a;
+
+    t += b;
+    *carry = c | (t < b);
+    return t;
+#endif
+}
+
+/* a - b - *borrow; *borrow becomes the borrow out (0 or 1). */
+static inline uint64_t secp_sbb(uint64_t a, uint64_t b, uint64_t *borrow)
+{
+#if defined(__SIZEOF_INT128__)
+    secp_u128 t = (secp_u128)a - b - *borrow;
+
+    *borrow = (uint64_t)(t >> 64) & 1;
+    return (uint64_t)t;
+#else
+    uint64_t t = a - b;
+    uint64_t c = a < b;
+
+    c |= t < *borrow;
+    t -= *borrow;
+    *borrow = c;
+    return t;
+#endif
+}
+
+/* r = mask ? a : b, with mask all ones or zero. */
+static inline void secp_select(uint64_t r[4], uint64_t mask,
+                               const uint64_t a[4], const uint64_t b[4])
+{
+    for (int i = 0; i < 4; ++i) {
+        r[i] = (a[i] & mask) | (b[i] & ~mask);
+    }
+}
+
+static void secp_load(uint64_t r[4], const uint8_t in[32])
+{
+    for (int i = 0; i < 4; ++i) {
+        uint64_t v = 0;
+
+        for (int j = 0; j < 8; ++j) {
+            v = (v << 8) | in[8 * (3 - i) + j];
+        }
+        r[i] = v;
+    }
+}
+
+static void secp_store(uint8_t out[32], const uint64_t a[4])
+{
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            out[8 * (3 - i) + j] = (uint8_t)(a[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+/* a < b as 0/1; only used on public values. */
+static int secp_lt(const uint64_t a[4], const uint64_t b[4])
+{
+    uint64_t borrow = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        (void)secp_sbb(a[i], b[i], &borrow);
+    }
+    return (int)borrow;
+}
+
+static uint64_t secp_is_zero(const uint64_t a[4])
+{
+    return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+/* ---- Field arithmetic mod p ---- */
+
+/*
+ * r = v mod p for v = hi * 2^256 + lo, hi < 2^35: fold hi * c into lo,
+ * then subtract p once if needed (v >= p iff v + c carries).
+ */
+static inline void secp_fe_fold(uint64_t r[4], const uint64_t lo[4], uint64_t hi)
+{
+    uint64_t t[4], u[4], carry = 0, c2 = 0;
+
+    t[0] = secp_mac(hi, SECP_C, lo[0], 0, &carry);
+    t[1] = secp_adc(lo[1], 0, &carry);
+    t[2] = secp_adc(lo[2], 0, &carry);
+    t[3] = secp_adc(lo[3], 0, &carry);
+
+    /* A carry here leaves t < c, so adding c once more cannot carry. */
+    u[0] = secp_adc(t[0], SECP_C & ((uint64_t)0 - carry), &c2);
+    u[1] = secp_adc(t[1], 0, &c2);
+    u[2] = secp_adc(t[2], 0, &c2);
+    u[3] = secp_adc(t[3], 0, &c2);
+
+    c2 = 0;
+    t[0] = secp_adc(u[0], SECP_C, &c2);
+    t[1] = secp_adc(u[1], 0, &c2);
+    t[2] = secp_adc(u[2], 0, &c2);
+    t[3] = secp_adc(u[3], 0, &c2);
+    secp_select(r, (uint64_t)0 - c2, t, u);
+}
+
+static void secp_fe_mul(uint64_t r[4], const uint64_t a[4], const uint64_t b[4])
+{
+    uint64_t t[8], lo[4], hi;
+
+    /* 512-bit schoolbook product. */
+    for (int i = 0; i < 8; ++i) {
+        t[i] = 0;
+    }
+    for (int i = 0; i < 4; ++i) {
+        uint64_t c = 0;
+
+        for (int j = 0; j < 4; ++j) {
+            t[i + j] = secp_mac(a[i], b[j], t[i + j], c, &c);
+        }
+        t[i + 4] = c;
+    }
+
+    /* t_hi * c + t_lo: 256 + 34 bits. */
+    uint64_t c = 0;
+    for (int i = 0; i < 4; ++i) {
+        lo[i] = secp_mac(t[4 + i], SECP_C, t[i], c, &c);
+    }
+    hi = c;
+    secp_fe_fold(r, lo, hi);
+}
+
+static void secp_fe_sqr(uint64_t r[4], const uint64_t a[4])
+{
+    secp_fe_mul(r, a, a);
+}
+
+/* r = a * k for a small constant k. */
+static void secp_fe_mul_small(uint64_t r[4], const uint64_t a[4], uint64_t k)
+{
+    uint64_t lo[4], c = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        lo[i] = secp_mac(a[i], k, 0, c, &c);
+    }
+    secp_fe_fold(r, lo, c);
+}
+
+static void secp_fe_add(uint64_t r[4], const uint64_t a[4], const uint64_t b[4])
+{
+    uint64_t t[4], u[4], carry = 0, c2 = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        t[i] = secp_adc(a[i], b[i], &carry);
+    }
+    /* t - p = t + c mod 2^256; needed iff t overflowed or t + c does. */
+    u[0] = secp_adc(t[0], SECP_C, &c2);
+    u[1] = secp_adc(t[1], 0, &c2);
+    u[2] = secp_adc(t[2], 0, &c2);
+    u[3] = secp_adc(t[3], 0, &c2);
+    secp_select(r, (uint64_t)0 - (carry | c2), u, t);
+}
+
+static void secp_fe_sub(uint64_t r[4], const uint64_t a[4], const uint64_t b[4])
+{
+    uint64_t t[4], u[4], borrow = 0, b2 = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        t[i] = secp_sbb(a[i], b[i], &borrow);
+    }
+    /* On borrow add p back: t + p = t - c mod 2^256. */
+    u[0] = secp_sbb(t[0], SECP_C, &b2);
+    u[1] = secp_sbb(t[1], 0, &b2);
+    u[2] = secp_sbb(t[2], 0, &b2);
+    u[3] = secp_sbb(t[3], 0, &b2);
+    secp_select(r, (uint64_t)0 - borrow, u, t);
+}
+
+static void secp_fe_sqr_n(uint64_t r[4], const uint64_t a[4], int n)
+{
+    secp_fe_sqr(r, a);
+    while (--n > 0) {
+        secp_fe_sqr(r, r);
+    }
+}
+
+/*
+ * Shared head of the inversion and square root chains: x223 = a^(2^223 - 1),
+ * plus x22 and x2 (a^(2^k - 1)) for the tails.
+ */
+static void secp_fe_pow_x223(uint64_t x223[4], uint64_t x22[4], uint64_t x2[4],
+                             const uint64_t a[4])
+{
+    uint64_t x3[4], x6[4], x9[4], x11[4], x44[4], x88[4], x176[4], x220[4];
+
+    secp_fe_sqr(x2, a);
+    secp_fe_mul(x2, x2, a);
+    secp_fe_sqr(x3, x2);
+    secp_fe_mul(x3, x3, a);
+    secp_fe_sqr_n(x6, x3, 3);
+    secp_fe_mul(x6, x6, x3);
+    secp_fe_sqr_n(x9, x6, 3);
+    secp_fe_mul(x9, x9, x3);
+    secp_fe_sqr_n(x11, x9, 2);
+    secp_fe_mul(x11, x11, x2);
+    secp_fe_sqr_n(x22, x11, 11);
+    secp_fe_mul(x22, x22, x11);
+    secp_fe_sqr_n(x44, x22, 22);
+    secp_fe_mul(x44, x44, x22);
+    secp_fe_sqr_n(x88, x44, 44);
+    secp_fe_mul(x88, x88, x44);
+    secp_fe_sqr_n(x176, x88, 88);
+    secp_fe_mul(x176, x176, x88);
+    secp_fe_sqr_n(x220, x176, 44);
+    secp_fe_mul(x220, x220, x44);
+    secp_fe_sqr_n(x223, x220, 3);
+    secp_fe_mul(x223, x223, x3);
+}
+
+/* a^(p-2) = a^-1 through a fixed addition chain (255 squarings, 15 products). */
+static void secp_fe_inv(uint64_t r[4], const uint64_t a[4])
+{
+    uint64_t x2[4], x22[4], x223[4], t[4];
+
+    secp_fe_pow_x223(x223, x22, x2, a);
+    secp_fe_sqr_n(t, x223, 23);
+    secp_fe_mul(t, t, x22);
+    secp_fe_sqr_n(t, t, 5);
+    secp_fe_mul(t, t, a);
+    secp_fe_sqr_n(t, t, 3);
+    secp_fe_mul(t, t, x2);
+    secp_fe_sqr_n(t, t, 2);
+    secp_fe_mul(r, t, a);
+}
+
+/*
+ * a^((p+1)/4), a square root of a when one exists (p = 3 mod 4); the
+ * caller checks it by squaring.
+ */
+static void secp_fe_sqrt(uint64_t r[4], const uint64_t a[4])
+{
+    uint64_t x2[4], x22[4], x223[4], t[4];
+
+    secp_fe_pow_x223(x223, x22, x2, a);
+    secp_fe_sqr_n(t, x223, 23);
+    secp_fe_mul(t, t, x22);
+    secp_fe_sqr_n(t, t, 6);
+    secp_fe_mul(t, t, x2);
+    secp_fe_sqr_n(r, t, 2);
+}
+
+/*
+ * out[i] = in[i]^-1 for n non-zero elements with one inversion
+ * (Montgomery's trick); out must not alias in.
+ */
+static void secp_fe_inv_batch(uint64_t (*out)[4], const uint64_t (*in)[4], size_t n)
+{
+    uint64_t inv[4];
+
+    if (n == 0) {
+        return;
+    }
+    memcpy(out[0], in[0], sizeof(out[0]));
+    for (size_t i = 1; i < n; ++i) {
+        secp_fe_mul(out[i], out[i - 1], in[i]);
+    }
+    secp_fe_inv(inv, out[n - 1]);
+    for (size_t i = n - 1; i > 0; --i) {
+        secp_fe_mul(out[i], inv, out[i - 1]);
+        secp_fe_mul(inv, inv, in[i]);
+    }
+    memcpy(out[0], inv, sizeof(inv));
+}
+
+/* ---- Scalar arithmetic mod n (Montgomery) ---- */
+
+/* r = a mod m for a < 2m: subtract m unless that borrows. */
+static void secp_reduce_once(uint64_t r[4], const uint64_t a[4], uint64_t hi,
+                             const secp_mod *m)
+{
+    uint64_t t[4], borrow = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        t[i] = secp_sbb(a[i], m->m[i], &borrow);
+    }
+    /* Keep a only if a < m, i.e. the subtraction borrowed with no carry. */
+    secp_select(r, (uint64_t)0 - (borrow & (hi ^ 1)), a, t);
+}
+
+static void secp_add(uint64_t r[4], const uint64_t a[4], const uint64_t b[4],
+                     const secp_mod *m)
+{
+    uint64_t t[4], carry = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        t[i] = secp_adc(a[i], b[i], &carry);
+    }
+    secp_reduce_once(r, t, carry, m);
+}
+
+static void secp_sub(uint64_t r[4], const uint64_t a[4], const uint64_t b[4],
+                     const secp_mod *m)
+{
+    uint64_t t[4], borrow = 0, carry = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        t[i] = secp_sbb(a[i], b[i], &borrow);
+    }
+    /* Add m back if it borrowed. */
+    uint64_t mask = (uint64_t)0 - borrow;
+    for (int i = 0; i < 4; ++i) {
+        r[i] = secp_adc(t[i], m->m[i] & mask, &carry);
+    }
+}
+
+/* Montgomery product a * b / 2^256 mod m (CIOS). */
+static void secp_mul(uint64_t r[4], const uint64_t a[4], const uint64_t b[4],
+                     const secp_mod *m)
+{
+    uint64_t t[4] = { 0, 0, 0, 0 };
+    uint64_t t4 = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        uint64_t c = 0, carry = 0;
+
+        for (int j = 0; j < 4; ++j) {
+            t[j] = secp_mac(a[j], b[i], t[j], c, &c);
+        }
+        uint64_t t5 = 0;
+        t4 = secp_adc(t4, c, &t5);
+
+        uint64_t q = t[0] * m->n0;
+        (void)secp_mac(q, m->m[0], t[0], 0, &c);
+        for (int j = 1; j < 4; ++j) {
+            t[j - 1] = secp_mac(q, m->m[j], t[j], c, &c);
+        }
+        t[3] = secp_adc(t4, c, &carry);
+        t4   = t5 + carry;
+    }
+    secp_reduce_once(r, t, t4, m);
+}
+
+static void secp_to_mont(uint64_t r[4], const uint64_t a[4], const secp_mod *m)
+{
+    secp_mul(r, a, m->r2, m);
+}
+
+static void secp_from_mont(uint64_t r[4], const uint64_t a[4], const secp_mod *m)
+{
+    static const uint64_t one[4] = { 1, 0, 0, 0 };
+
+    secp_mul(r, a, one, m);
+}
+
+/*
+ * a^(m-2) = a^-1 (Montgomery in, Montgomery out), 4-bit fixed windows.
+ * The exponent is public, so skipping zero digits leaks nothing about a.
+ */
+static void secp_inv(uint64_t r[4], const uint64_t a[4], const secp_mod *m)
+{
+    uint64_t pw[16][4], x[4];
+
+    memcpy(pw[0], m->one, sizeof(pw[0]));
+    memcpy(pw[1], a, sizeof(pw[1]));
+    for (int i = 2; i < 16; ++i) {
+        secp_mul(pw[i], pw[i - 1], a, m);
+    }
+
+    memcpy(x, m->one, sizeof(x));
+    for (int i = 63; i >= 0; --i) {
+        unsigned digit = (unsigned)(m->e[i / 16] >> (4 * (i % 16))) & 0x0F;
+
+        for (int k = 0; k < 4; ++k) {
+            secp_mul(x, x, x, m);
+        }
+        if (digit != 0) {
+            secp_mul(x, x, pw[digit], m);
+        }
+    }
+    memcpy(r, x, sizeof(x));
+}
+
+/* Batch form of secp_inv(), as secp_fe_inv_batch(). */
+static void secp_inv_batch(uint64_t (*out)[4], const uint64_t (*in)[4], size_t n,
+                           const secp_mod *m)
+{
+    uint64_t inv[4];
+
+    if (n == 0) {
+        return;
+    }
+    memcpy(out[0], in[0], sizeof(out[0]));
+    for (size_t i = 1; i < n; ++i) {
+        secp_mul(out[i], out[i - 1], in[i], m);
+    }
+    secp_inv(inv, out[n - 1], m);
+    for (size_t i = n - 1; i > 0; --i) {
+        secp_mul(out[i], inv, out[i - 1], m);
+        secp_mul(inv, inv, in[i], m);
+    }
+    memcpy(out[0], inv, sizeof(inv));
+}
+
+/* ---- Points ---- */
+
+typedef struct {
+    uint64_t x[4], y[4], z[4];
+} secp_point;
+
+/* Complete addition, a = 0 (Renes-Costello-Batina, algorithm 7). */
+static void secp_point_add(secp_point *r, const secp_point *p, const secp_point *q)
+{
+    uint64_t t0[4], t1[4], t2[4], t3[4], t4[4], x3[4], y3[4], z3[4];
+
+    secp_fe_mul(t0, p->x, q->x);
+    secp_fe_mul(t1, p->y, q->y);
+    secp_fe_mul(t2, p->z, q->z);
+    secp_fe_add(t3, p->x, p->y);
+    secp_fe_add(t4, q->x, q->y);
+    secp_fe_mul(t3, t3, t4);
+    secp_fe_add(t4, t0, t1);
+    secp_fe_sub(t3, t3, t4);
+    secp_fe_add(t4, p->y, p->z);
+    secp_fe_add(x3, q->y, q->z);
+    secp_fe_mul(t4, t4, x3);
+    secp_fe_add(x3, t1, t2);
+    secp_fe_sub(t4, t4, x3);
+    secp_fe_add(x3, p->x, p->z);
+    secp_fe_add(y3, q->x, q->z);
+    secp_fe_mul(x3, x3, y3);
+    secp_fe_add(y3, t0, t2);
+    secp_fe_sub(y3, x3, y3);
+    secp_fe_add(x3, t0, t0);
+    secp_fe_add(t0, x3, t0);
+    secp_fe_mul_small(t2, t2, 21);
+    secp_fe_add(z3, t1, t2);
+    secp_fe_sub(t1, t1, t2);
+    secp_fe_mul_small(y3, y3, 21);
+    secp_fe_mul(x3, t4, y3);
+    secp_fe_mul(t2, t3, t1);
+    secp_fe_sub(x3, t2, x3);
+    secp_fe_mul(y3, y3, t0);
+    secp_fe_mul(t1, t1, z3);
+    secp_fe_add(y3, t1, y3);
+    secp_fe_mul(t0, t0, t3);
+    secp_fe_mul(z3, z3, t4);
+    secp_fe_add(z3, z3, t0);
+
+    memcpy(r->x, x3, sizeof(x3));
+    memcpy(r->y, y3, sizeof(y3));
+    memcpy(r->z, z3, sizeof(z3));
+}
+
+/*
+ * Mixed addition with an affine q = (qx, qy) (algorithm 8). Complete for
+ * any p, including infinity; q must not be infinity.
+ */
+static void secp_point_add_affine(secp_point *r, const secp_point *p,
+                                  const uint64_t qx[4], const uint64_t qy[4])
+{
+    uint64_t t0[4], t1[4], t2[4], t3[4], t4[4], x3[4], y3[4], z3[4];
+
+    secp_fe_mul(t0, p->x, qx);
+    secp_fe_mul(t1, p->y, qy);
+    secp_fe_add(t3, qx, qy);
+    secp_fe_add(t4, p->x, p->y);
+    secp_fe_mul(t3, t3, t4);
+    secp_fe_add(t4, t0, t1);
+    secp_fe_sub(t3, t3, t4);
+    secp_fe_mul(t4, qy, p->z);
+    secp_fe_add(t4, t4, p->y);
+    secp_fe_mul(y3, qx, p->z);
+    secp_fe_add(y3, y3, p->x);
+    secp_fe_add(x3, t0, t0);
+    secp_fe_add(t0, x3, t0);
+    secp_fe_mul_small(t2, p->z, 21);
+    secp_fe_add(z3, t1, t2);
+    secp_fe_sub(t1, t1, t2);
+    secp_fe_mul_small(y3, y3, 21);
+    secp_fe_mul(x3, t4, y3);
+    secp_fe_mul(t2, t3, t1);
+    secp_fe_sub(x3, t2, x3);
+    secp_fe_mul(y3, y3, t0);
+    secp_fe_mul(t1, t1, z3);
+    secp_fe_add(y3, t1, y3);
+    secp_fe_mul(t0, t0, t3);
+    secp_fe_mul(z3, z3, t4);
+    secp_fe_add(z3, z3, t0);
+
+    memcpy(r->x, x3, sizeof(x3));
+    memcpy(r->y, y3, sizeof(y3));
+    memcpy(r->z, z3, sizeof(z3));
+}
+
+/* Complete doubling, a = 0 (algorithm 9). */
+static void secp_point_double(secp_point *r, const secp_point *p)
+{
+    uint64_t t0[4], t1[4], t2[4], x3[4], y3[4], z3[4];
+
+    secp_fe_sqr(t0, p->y);
+    secp_fe_add(z3, t0, t0);
+    secp_fe_add(z3, z3, z3);
+    secp_fe_add(z3, z3, z3);
+    secp_fe_mul(t1, p->y, p->z);
+    secp_fe_sqr(t2, p->z);
+    secp_fe_mul_small(t2, t2, 21);
+    secp_fe_mul(x3, t2, z3);
+    secp_fe_add(y3, t0, t2);
+    secp_fe_mul(z3, t1, z3);
+    secp_fe_add(t1, t2, t2);
+    secp_fe_add(t2, t1, t2);
+    secp_fe_sub(t0, t0, t2);
+    secp_fe_mul(y3, t0, y3);
+    secp_fe_add(y3, x3, y3);
+    secp_fe_mul(t1, p->x, p->y);
+    secp_fe_mul(x3, t0, t1);
+    secp_fe_add(x3, x3, x3);
+
+    memcpy(r->x, x3, sizeof(x3));
+    memcpy(r->y, y3, sizeof(y3));
+    memcpy(r->z, z3, sizeof(z3));
+}
+
+static void secp_point_set_infinity(secp_point *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->y[0] = 1;
+}
+
+/* Affine x, y (plain form). Returns -1 for the point at infinity. */
+static int secp_point_to_affine(uint64_t x[4], uint64_t y[4], const secp_point *p)
+{
+    uint64_t zi[4];
+
+    if (secp_is_zero(p->z)) {
+        return -1;
+    }
+    secp_fe_inv(zi, p->z);
+    secp_fe_mul(x, p->x, zi);
+    secp_fe_mul(y, p->y, zi);
+    return 0;
+}
+
+/* ---- Generator tables ---- */
+
+/*
+ * Affine entries (x || y) from n projective points, one inversion for
+ * all of them. No point may be infinity.
+ */
+static void secp_points_to_table(uint64_t (*entries)[8], const secp_point *pts,
+                                 size_t n)
+{
+    uint64_t zs[WEB3C_SECP256K1_GEN_ODD][4], zi[WEB3C_SECP256K1_GEN_ODD][4];
+
+    for (size_t i = 0; i < n; ++i) {
+        memcpy(zs[i], pts[i].z, sizeof(zs[i]));
+    }
+    secp_fe_inv_batch(zi, (const uint64_t (*)[4])zs, n);
+    for (size_t i = 0; i < n; ++i) {
+        secp_fe_mul(entries[i], pts[i].x, zi[i]);
+        secp_fe_mul(entries[i] + 4, pts[i].y, zi[i]);
+    }
+}
+
+void web3c_secp256k1_ctx_init(web3c_secp256k1_ctx *ctx)
+{
+    enum { W = WEB3C_SECP256K1_WINDOW_POINTS };
+    secp_point base, twice, multiples[WEB3C_SECP256K1_GEN_ODD];
+
+    if (ctx == NULL) {
+        return;
+    }
+
+    /* base = G (projective, Z = 1). */
+    memcpy(base.x, secp_gx, sizeof(base.x));
+    memcpy(base.y, secp_gy, sizeof(base.y));
+    memset(base.z, 0, sizeof(base.z));
+    base.z[0] = 1;
+
+    /* odd[j] = (2j + 1) * G. */
+    secp_point_double(&twice, &base);
+    multiples[0] = base;
+    for (int j = 1; j < WEB3C_SECP256K1_GEN_ODD; ++j) {
+        secp_point_add(&multiples[j], &multiples[j - 1], &twice);
+    }
+    secp_points_to_table(ctx->odd, multiples, WEB3C_SECP256K1_GEN_ODD);
+
+    for (int i = 0; i < WEB3C_SECP256K1_WINDOWS; ++i) {
+        /* multiples[j] = (j + 1) * base. */
+        multiples[0] = base;
+        for (int j = 1; j < W; ++j) {
+            secp_point_add(&multiples[j], &multiples[j - 1], &base);
+        }
+        secp_points_to_table(ctx->table[i], multiples, W);
+
+        /* Next window: 16 * base = 15 * base + base. */
+        secp_point_add(&base, &multiples[W - 1], &base);
+    }
+}
+
+/*
+ * r = k * G for a plain scalar k (little-endian limbs). Every window
+ * scans all its entries and performs one addition; a zero digit keeps
+ * the previous sum through a masked select.
+ */
+static void secp_mul_gen(secp_point *r, const web3c_secp256k1_ctx *ctx,
+                         const uint64_t k[4])
+{
+    secp_point acc, sum;
+
+    secp_point_set_infinity(&acc);
+    for (int i = 0; i < WEB3C_SECP256K1_WINDOWS; ++i) {
+        uint32_t digit = (uint32_t)(k[i / 16] >> (4 * (i % 16))) & 0x0F;
+        uint64_t q[8]  = { 0 };
+
+        for (uint32_t j = 0; j < WEB3C_SECP256K1_WINDOW_POINTS; ++j) {
+            /* all ones iff j + 1 == digit */
+            uint64_t mask = (uint64_t)0 - (uint64_t)((((j + 1) ^ digit) - 1) >> 31);
+
+            for (int l = 0; l < 8; ++l) {
+                q[l] |= ctx->table[i][j][l] & mask;
+            }
+        }
+
+        secp_point_add_affine(&sum, &acc, q, q + 4);
+
+        uint64_t keep = (uint64_t)0 - (uint64_t)((digit - 1) >> 31);
+        secp_select(acc.x, keep, acc.x, sum.x);
+        secp_select(acc.y, keep, acc.y, sum.y);
+        secp_select(acc.z, keep, acc.z, sum.z);
+    }
+    *r = acc;
+}
+
+/* ---- SHA-256 / HMAC-SHA256 (RFC 6979 only) ---- */
+
+typedef struct {
+    uint32_t h[8];
+    uint8_t  block[64];
+    size_t   fill;
+    uint64_t total;
+} secp_sha256;
+
+static const uint32_t secp_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t secp_ror32(uint32_t x, unsigned n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+static void secp_sha256_block(uint32_t h[8], const uint8_t p[64])
+{
+    uint32_t w[64], a[8];
+
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16 |
+               (uint32_t)p[4 * i + 2] << 8 | p[4 * i + 3];
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = secp_ror32(w[i - 15], 7) ^ secp_ror32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = secp_ror32(w[i - 2], 17) ^ secp_ror32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    memcpy(a, h, sizeof(a));
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = secp_ror32(a[4], 6) ^ secp_ror32(a[4], 11) ^ secp_ror32(a[4], 25);
+        uint32_t ch = (a[4] & a[5]) ^ (~a[4] & a[6]);
+        uint32_t t1 = a[7] + s1 + ch + secp_sha256_k[i] + w[i];
+        uint32_t s0 = secp_ror32(a[0], 2) ^ secp_ror32(a[0], 13) ^ secp_ror32(a[0], 22);
+        uint32_t mj = (a[0] & a[1]) ^ (a[0] & a[2]) ^ (a[1] & a[2]);
+
+        memmove(a + 1, a, 7 * sizeof(uint32_t));
+        a[4] += t1;
+        a[0]  = t1 + s0 + mj;
+    }
+    for (int i = 0; i < 8; ++i) {
+        h[i] += a[i];
+    }
+}
+
+static void secp_sha256_init(secp_sha256 *c)
+{
+    static const uint32_t iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    memcpy(c->h, iv, sizeof(iv));
+    c->fill  = 0;
+    c->total = 0;
+}
+
+static void secp_sha256_update(secp_sha256 *c, const uint8_t *p, size_t len)
+{
+    c->total += len;
+    while (len > 0) {
+        size_t n = 64 - c->fill < len ? 64 - c->fill : len;
+
+        memcpy(c->block + c->fill, p, n);
+        c->fill += n;
+        p       += n;
+        len     -= n;
+        if (c->fill == 64) {
+            secp_sha256_block(c->h, c->block);
+            c->fill = 0;
+        }
+    }
+}
+
+static void secp_sha256_final(secp_sha256 *c, uint8_t out[32])
+{
+    uint64_t bits = c->total * 8;
+    uint8_t  pad[72] = { 0x80 };
+    size_t   n = (c->fill < 56 ? 56 : 120) - c->fill;
+
+    for (int i = 0; i < 8; ++i) {
+        pad[n + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    secp_sha256_update(c, pad, n + 8);
+    for (int i = 0; i < 8; ++i) {
+        out[4 * i]     = (uint8_t)(c->h[i] >> 24);
+        out[4 * i + 1] = (uint8_t)(c->h[i] >> 16);
+        out[4 * i + 2] = (uint8_t)(c->h[i] >> 8);
+        out[4 * i + 3] = (uint8_t)c->h[i];
+    }
+}
+
+/* HMAC-SHA256 with a 32-byte key over up to three message parts. */
+static void secp_hmac(uint8_t out[32], const uint8_t key[32],
+                      const uint8_t *m1, size_t l1,
+                      const uint8_t *m2, size_t l2,
+                      const uint8_t *m3, size_t l3)
+{
+    uint8_t     pad[64];
+    secp_sha256 c;
+
+    memset(pad, 0x36, sizeof(pad));
+    for (int i = 0; i < 32; ++i) {
+        pad[i] ^= key[i];
+    }
+    secp_sha256_init(&c);
+    secp_sha256_update(&c, pad, 64);
+    secp_sha256_update(&c, m1, l1);
+    secp_sha256_update(&c, m2, l2);
+    secp_sha256_update(&c, m3, l3);
+    secp_sha256_final(&c, out);
+
+    for (int i = 0; i < 64; ++i) {
+        pad[i] ^= 0x36 ^ 0x5c;
+    }
+    secp_sha256_init(&c);
+    secp_sha256_update(&c, pad, 64);
+    secp_sha256_update(&c, out, 32);
+    secp_sha256_final(&c, out);
+}
+
+/* RFC 6979 state (section 3.2, steps b-h) for one key and hash. */
+typedef struct {
+    uint8_t k[32];
+    uint8_t v[32];
+} secp_rfc6979;
+
+static void secp_rfc6979_init(secp_rfc6979 *st, const uint8_t seckey[32],
+                              const uint8_t h[32])
+{
+    static const uint8_t zero = 0x00, one = 0x01;
+    uint8_t msg[65];
+
+    memset(st->v, 0x01, 32);
+    memset(st->k, 0x00, 32);
+
+    memcpy(msg, seckey, 32);
+    memcpy(msg + 32, h, 32);
+    secp_hmac(st->k, st->k, st->v, 32, &zero, 1, msg, 64);
+    secp_hmac(st->v, st->k, st->v, 32, NULL, 0, NULL, 0);
+    secp_hmac(st->k, st->k, st->v, 32, &one, 1, msg, 64);
+    secp_hmac(st->v, st->k, st->v, 32, NULL, 0, NULL, 0);
+}
+
+/* Next candidate nonce (plain limbs); 1 <= k < n is left to the caller. */
+static void secp_rfc6979_next(secp_rfc6979 *st, uint64_t k[4], int retry)
+{
+    static const uint8_t zero = 0x00;
+
+    if (retry) {
+        secp_hmac(st->k, st->k, st->v, 32, &zero, 1, NULL, 0);
+        secp_hmac(st->v, st->k, st->v, 32, NULL, 0, NULL, 0);
+    }
+    secp_hmac(st->v, st->k, st->v, 32, NULL, 0, NULL, 0);
+    secp_load(k, st->v);
+}
+
+/* ---- Public API ---- */
+
+/* Plain scalar from 32 bytes; 0 if 0 < value < n. */
+static int secp_scalar_load(uint64_t r[4], const uint8_t in[32])
+{
+    secp_load(r, in);
+    return (secp_is_zero(r) || !secp_lt(r, secp_n.m)) ? -1 : 0;
+}
+
+int web3c_secp256k1_seckey_verify(const uint8_t seckey[32])
+{
+    uint64_t d[4];
+
+    if (seckey == NULL) {
+        return -1;
+    }
+    return secp_scalar_load(d, seckey);
+}
+
+int web3c_secp256k1_pubkey(const web3c_secp256k1_ctx *ctx,
+                           const uint8_t seckey[32],
+                           uint8_t pubkey[64])
+{
+    uint64_t   d[4], x[4], y[4];
+    secp_point q;
+
+    if (ctx == NULL || seckey == NULL || pubkey == NULL ||
+        secp_scalar_load(d, seckey) != 0) {
+        return -1;
+    }
+
+    secp_mul_gen(&q, ctx, d);
+    if (secp_point_to_affine(x, y, &q) != 0) {
+        return -1;
+    }
+    secp_store(pubkey, x);
+    secp_store(pubkey + 32, y);
+    return 0;
+}
+
+int web3c_secp256k1_address(const web3c_secp256k1_ctx *ctx,
+                            const uint8_t seckey[32],
+                            uint8_t address[20])
+{
+    uint8_t pub[64], hash[32];
+
+    if (address == NULL || web3c_secp256k1_pubkey(ctx, seckey, pub) != 0 ||
+        web3c_keccak256(pub, sizeof(pub), hash) != 0) {
+        return -1;
+    }
+    memcpy(address, hash + 12, 20);
+    return 0;
+}
+
+int web3c_secp256k1_sign(const web3c_secp256k1_ctx *ctx,
+                         const uint8_t hash[32],
+                         const uint8_t seckey[32],
+                         uint8_t r[32],
+                         uint8_t s[32],
+                         unsigned *recid)
+{
+    const secp_mod *n = &secp_n;
+    uint64_t     d[4], z[4], k[4], rx[4], ry[4], rr[4], ss[4];
+    uint64_t     dm[4], zm[4], km[4], rm[4];
+    uint8_t      zb[32];
+    secp_rfc6979 rng;
+    secp_point   big_r;
+
+    if (ctx == NULL || hash == NULL || seckey == NULL || r == NULL || s == NULL ||
+        secp_scalar_load(d, seckey) != 0) {
+        return -1;
+    }
+
+    /* z = hash mod n (hash < 2^256 < 2n). */
+    secp_load(z, hash);
+    secp_reduce_once(z, z, 0, n);
+    secp_store(zb, z);
+
+    secp_to_mont(dm, d, n);
+    secp_to_mont(zm, z, n);
+    secp_rfc6979_init(&rng, seckey, zb);
+
+    for (int attempt = 0; ; ++attempt) {
+        secp_rfc6979_next(&rng, k, attempt > 0);
+        if (secp_is_zero(k) || !secp_lt(k, n->m)) {
+            continue;
+        }
+
+        secp_mul_gen(&big_r, ctx, k);
+        if (secp_point_to_affine(rx, ry, &big_r) != 0) {
+            continue;
+        }
+
+        /* r = R.x mod n; R.x >= n only with probability ~2^-128. */
+        unsigned id = (unsigned)(ry[0] & 1) | (secp_lt(rx, n->m) ? 0u : 2u);
+        secp_reduce_once(rr, rx, 0, n);
+        if (secp_is_zero(rr)) {
+            continue;
+        }
+
+        /* s = k^-1 (z + r d) mod n */
+        secp_to_mont(rm, rr, n);
+        secp_to_mont(km, k, n);
+        secp_mul(rm, rm, dm, n);
+        secp_add(rm, rm, zm, n);
+        secp_inv(km, km, n);
+        secp_mul(ss, km, rm, n);
+        secp_from_mont(ss, ss, n);
+        if (secp_is_zero(ss)) {
+            continue;
+        }
+
+        /* Low s (EIP-2): s > n/2 becomes n - s, flipping R.y's parity. */
+        if (secp_lt(secp_n_half, ss)) {
+            uint64_t zero[4] = { 0, 0, 0, 0 };
+            secp_sub(ss, zero, ss, n);
+            id ^= 1;
+        }
+
+        secp_store(r, rr);
+        secp_store(s, ss);
+        if (recid) {
+            *recid = id;
+        }
+        break;
+    }
+
+    memset(&rng, 0, sizeof(rng));
+    memset(d, 0, sizeof(d));
+    memset(dm, 0, sizeof(dm));
+    memset(k, 0, sizeof(k));
+    memset(km, 0, sizeof(km));
+    return 0;
+}
+
+/* ---- Recovery ---- */
+
+/* Signatures per block: shared inversions, table normalization. */
+#define SECP_RECOVER_BLOCK 16
+
+/* Odd multiples of R per signature (5-bit wNAF: R, 3R, ..., 15R). */
+#define SECP_RECOVER_ODD 8
+
+static const uint64_t secp_p[4] = {
+    0xfffffffefffffc2full, 0xffffffffffffffffull,
+    0xffffffffffffffffull, 0xffffffffffffffffull
+};
+
+/* Bits [pos, pos + count) of k, count <= 32. */
+static uint32_t secp_bits(const uint64_t k[4], unsigned pos, unsigned count)
+{
+    unsigned limb = pos / 64, off = pos % 64;
+    uint64_t v = k[limb] >> off;
+
+    if (off + count > 64 && limb < 3) {
+        v |= k[limb + 1] << (64 - off);
+    }
+    return (uint32_t)v & ((1u << count) - 1);
+}
+
+/*
+ * Width-w NAF of a plain scalar: naf[i] is 0 or odd with |naf[i]| <
+ * 2^(w-1), and any w consecutive digits hold at most one non-zero.
+ * Returns the index of the top non-zero digit + 1 (0 for k = 0).
+ */
+static unsigned secp_wnaf(int naf[257], const uint64_t k[4], unsigned w)
+{
+    unsigned bit = 0, len = 0;
+    uint32_t carry = 0;
+
+    memset(naf, 0, 257 * sizeof(naf[0]));
+    while (bit < 256) {
+        if (secp_bits(k, bit, 1) == carry) {
+            ++bit;
+            continue;
+        }
+
+        unsigned now = w < 256 - bit ? w : 256 - bit;
+        int32_t  word = (int32_t)(secp_bits(k, bit, now) + carry);
+
+        carry = (uint32_t)(word >> (w - 1)) & 1;
+        word -= (int32_t)(carry << w);
+        naf[bit] = word;
+        len = bit + 1;
+        bit += now;
+    }
+    if (carry) {
+        naf[256] = 1;
+        len = 257;
+    }
+    return len;
+}
+
+/*
+ * Jacobian point (x = X / Z^2, y = Y / Z^3) for the variable-time
+ * recovery chain: doubling and mixed addition are cheaper than the
+ * complete formulas, and the special cases are plain branches since
+ * every input is public.
+ */
+typedef struct {
+    uint64_t x[4], y[4], z[4];
+    int      infinity;
+} secp_gej;
+
+/* r = 2 r (a = 0: 3M + 4S). */
+static void secp_gej_double(secp_gej *r)
+{
+    uint64_t a[4], b[4], c[4], m[4], t[4];
+
+    if (r->infinity) {
+        return;
+    }
+    if (secp_is_zero(r->y)) {
+        r->infinity = 1;
+        return;
+    }
+
+    secp_fe_sqr(a, r->x);
+    secp_fe_sqr(b, r->y);
+    secp_fe_sqr(c, b);
+    secp_fe_mul(t, r->x, b);            /* S = 4 X B */
+    secp_fe_add(t, t, t);
+    secp_fe_add(t, t, t);
+    secp_fe_add(m, a, a);               /* M = 3 A */
+    secp_fe_add(m, m, a);
+
+    secp_fe_mul(r->z, r->y, r->z);      /* Z3 = 2 Y Z */
+    secp_fe_add(r->z, r->z, r->z);
+
+    secp_fe_sqr(a, m);                  /* X3 = M^2 - 2 S */
+    secp_fe_sub(a, a, t);
+    secp_fe_sub(a, a, t);
+
+    secp_fe_sub(t, t, a);               /* Y3 = M (S - X3) - 8 C */
+    secp_fe_mul(t, m, t);
+    secp_fe_add(c, c, c);
+    secp_fe_add(c, c, c);
+    secp_fe_add(c, c, c);
+    secp_fe_sub(r->y, t, c);
+    memcpy(r->x, a, sizeof(a));
+}
+
+/* r += (qx, qy), affine q (8M + 3S). */
+static void secp_gej_add_affine(secp_gej *r, const uint64_t qx[4], const uint64_t qy[4])
+{
+    uint64_t zz[4], u2[4], s2[4], h[4], rr[4], hh[4], hhh[4], v[4], t[4];
+
+    if (r->infinity) {
+        memcpy(r->x, qx, sizeof(r->x));
+        memcpy(r->y, qy, sizeof(r->y));
+        memset(r->z, 0, sizeof(r->z));
+        r->z[0]     = 1;
+        r->infinity = 0;
+        return;
+    }
+
+    secp_fe_sqr(zz, r->z);
+    secp_fe_mul(u2, qx, zz);
+    secp_fe_mul(s2, qy, zz);
+    secp_fe_mul(s2, s2, r->z);
+    secp_fe_sub(h, u2, r->x);
+    secp_fe_sub(rr, s2, r->y);
+
+    if (secp_is_zero(h)) {
+        if (secp_is_zero(rr)) {
+            secp_gej_double(r);
+        } else {
+            r->infinity = 1;
+        }
+        return;
+    }
+
+    secp_fe_sqr(hh, h);
+    secp_fe_mul(hhh, h, hh);
+    secp_fe_mul(v, r->x, hh);
+
+    secp_fe_sqr(t, rr);                 /* X3 = r^2 - H^3 - 2 V */
+    secp_fe_sub(t, t, hhh);
+    secp_fe_sub(t, t, v);
+    secp_fe_sub(t, t, v);
+
+    secp_fe_sub(v, v, t);               /* Y3 = r (V - X3) - Y1 H^3 */
+    secp_fe_mul(v, rr, v);
+    secp_fe_mul(hhh, r->y, hhh);
+    secp_fe_sub(r->y, v, hhh);
+    memcpy(r->x, t, sizeof(t));
+
+    secp_fe_mul(r->z, r->z, h);         /* Z3 = Z1 H */
+}
+
+/* acc += digit * table entry, for an odd non-zero wNAF digit. */
+static void secp_add_digit(secp_gej *acc, const uint64_t (*odd)[8], int digit)
+{
+    static const uint64_t zero[4] = { 0, 0, 0, 0 };
+    const uint64_t *e = odd[((digit < 0 ? -digit : digit) - 1) / 2];
+
+    if (digit > 0) {
+        secp_gej_add_affine(acc, e, e + 4);
+    } else {
+        uint64_t ny[4];
+
+        secp_fe_sub(ny, zero, e + 4);
+        secp_gej_add_affine(acc, e, ny);
+    }
+}
+
+/*
+ * u1 * G + u2 * R in one doubling chain (Straus): 8-bit wNAF digits of
+ * u1 index the context's odd multiples of G, 5-bit digits of u2 the
+ * affine odd multiples of R.
+ */
+static void secp_mul_double(secp_gej *r, const web3c_secp256k1_ctx *ctx,
+                            const uint64_t u1[4], const uint64_t u2[4],
+                            const uint64_t (*odd_r)[8])
+{
+    int      naf1[257], naf2[257];
+    unsigned len1 = secp_wnaf(naf1, u1, 8);
+    unsigned len2 = secp_wnaf(naf2, u2, 5);
+    unsigned len  = len1 > len2 ? len1 : len2;
+
+    r->infinity = 1;
+    for (unsigned i = len; i-- > 0; ) {
+        secp_gej_double(r);
+        if (naf1[i] != 0) {
+            secp_add_digit(r, (const uint64_t (*)[8])ctx->odd, naf1[i]);
+        }
+        if (naf2[i] != 0) {
+            secp_add_digit(r, odd_r, naf2[i]);
+        }
+    }
+}
+
+/*
+ * Decompress R from r and the recovery id: x = r (+ n for recid 2, 3),
+ * y the square root of x^3 + 7 with parity recid & 1.
+ */
+static int secp_lift_x(uint64_t x[4], uint64_t y[4], const uint64_t r[4],
+                       unsigned recid)
+{
+    static const uint64_t zero[4]  = { 0, 0, 0, 0 };
+    static const uint64_t seven[4] = { 7, 0, 0, 0 };
+    uint64_t rhs[4], check[4], carry = 0;
+
+    memcpy(x, r, 4 * sizeof(uint64_t));
+    if (recid & 2) {
+        for (int i = 0; i < 4; ++i) {
+            x[i] = secp_adc(r[i], secp_n.m[i], &carry);
+        }
+    }
+    if (carry || !secp_lt(x, secp_p)) {
+        return -1;
+    }
+
+    secp_fe_sqr(rhs, x);
+    secp_fe_mul(rhs, rhs, x);
+    secp_fe_add(rhs, rhs, seven);
+    secp_fe_sqrt(y, rhs);
+    secp_fe_sqr(check, y);
+    if (memcmp(check, rhs, sizeof(check)) != 0) {
+        return -1;
+    }
+    if ((y[0] & 1) != (recid & 1)) {
+        secp_fe_sub(y, zero, y);
+    }
+    return 0;
+}
+
+/*
+ * Recover up to SECP_RECOVER_BLOCK public keys: Q = r^-1 (s R - z G).
+ * ok[i] is set to 1 when pubs[i] holds a key, 0 for invalid input.
+ * Invalid entries run with G standing in for R and r = 1 so the shared
+ * inversions stay well defined.
+ */
+static void secp_recover_block(const web3c_secp256k1_ctx *ctx,
+                               const uint8_t (*hashes)[32],
+                               const uint8_t (*sigs)[64],
+                               const unsigned *recids,
+                               size_t count,
+                               uint8_t (*pubs)[64],
+                               int *ok)
+{
+    enum { B = SECP_RECOVER_BLOCK, K = SECP_RECOVER_ODD };
+    const secp_mod *n = &secp_n;
+    uint64_t   rm[B][4], sm[B][4], zm[B][4], rinv[B][4];
+    uint64_t   rx[B][4], ry[B][4];
+    uint64_t   zs[B * (K - 1)][4], zi[B * (K - 1)][4];
+    uint64_t   odd[B][K][8];
+    secp_point pts[B][K];
+    secp_gej   q[B];
+
+    /* Decode, range-check and lift R. */
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t r[4], s[4], z[4];
+
+        secp_load(r, sigs[i]);
+        secp_load(s, sigs[i] + 32);
+        ok[i] = recids[i] <= 3 &&
+                !secp_is_zero(r) && secp_lt(r, n->m) &&
+                !secp_is_zero(s) && secp_lt(s, n->m) &&
+                secp_lift_x(rx[i], ry[i], r, recids[i]) == 0;
+
+        if (!ok[i]) {
+            memcpy(rx[i], secp_gx, sizeof(rx[i]));
+            memcpy(ry[i], secp_gy, sizeof(ry[i]));
+            memcpy(rm[i], n->one, sizeof(rm[i]));
+            memcpy(sm[i], n->one, sizeof(sm[i]));
+            memcpy(zm[i], n->one, sizeof(zm[i]));
+            continue;
+        }
+
+        secp_load(z, hashes[i]);
+        secp_reduce_once(z, z, 0, n);
+        secp_to_mont(rm[i], r, n);
+        secp_to_mont(sm[i], s, n);
+        secp_to_mont(zm[i], z, n);
+    }
+
+    /* One scalar inversion for every r^-1. */
+    secp_inv_batch(rinv, (const uint64_t (*)[4])rm, count, n);
+
+    /* Odd multiples of each R; one field inversion makes them affine. */
+    for (size_t i = 0; i < count; ++i) {
+        secp_point twice;
+
+        memcpy(pts[i][0].x, rx[i], sizeof(rx[i]));
+        memcpy(pts[i][0].y, ry[i], sizeof(ry[i]));
+        memset(pts[i][0].z, 0, sizeof(pts[i][0].z));
+        pts[i][0].z[0] = 1;
+        secp_point_double(&twice, &pts[i][0]);
+        for (int j = 1; j < K; ++j) {
+            secp_point_add(&pts[i][j], &pts[i][j - 1], &twice);
+            memcpy(zs[i * (K - 1) + j - 1], pts[i][j].z, sizeof(zs[0]));
+        }
+    }
+    secp_fe_inv_batch(zi, (const uint64_t (*)[4])zs, count * (K - 1));
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(odd[i][0], rx[i], sizeof(rx[i]));
+        memcpy(odd[i][0] + 4, ry[i], sizeof(ry[i]));
+        for (int j = 1; j < K; ++j) {
+            const uint64_t *z = zi[i * (K - 1) + j - 1];
+
+            secp_fe_mul(odd[i][j], pts[i][j].x, z);
+            secp_fe_mul(odd[i][j] + 4, pts[i][j].y, z);
+        }
+    }
+
+    /* Q = u1 G + u2 R with u1 = -z / r, u2 = s / r. */
+    for (size_t i = 0; i < count; ++i) {
+        static const uint64_t zero[4] = { 0, 0, 0, 0 };
+        uint64_t u1[4], u2[4];
+
+        secp_sub(u1, zero, zm[i], n);
+        secp_mul(u1, u1, rinv[i], n);
+        secp_mul(u2, sm[i], rinv[i], n);
+        secp_from_mont(u1, u1, n);
+        secp_from_mont(u2, u2, n);
+
+        secp_mul_double(&q[i], ctx, u1, u2, (const uint64_t (*)[8])odd[i]);
+        if (q[i].infinity) {
+            ok[i] = 0;
+        }
+        memcpy(zs[i], q[i].z, sizeof(zs[i]));
+        if (!ok[i]) {
+            memset(zs[i], 0, sizeof(zs[i]));
+            zs[i][0] = 1;
+        }
+    }
+
+    /* One field inversion for every Q. */
+    secp_fe_inv_batch(zi, (const uint64_t (*)[4])zs, count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t x[4], y[4], zi2[4], zi3[4];
+
+        if (!ok[i]) {
+            memset(pubs[i], 0, 64);
+            continue;
+        }
+        secp_fe_sqr(zi2, zi[i]);
+        secp_fe_mul(zi3, zi2, zi[i]);
+        secp_fe_mul(x, q[i].x, zi2);
+        secp_fe_mul(y, q[i].y, zi3);
+        secp_store(pubs[i], x);
+        secp_store(pubs[i] + 32, y);
+    }
+}
+
+int web3c_secp256k1_recover(const web3c_secp256k1_ctx *ctx,
+                            const uint8_t hash[32],
+                            const uint8_t r[32],
+                            const uint8_t s[32],
+                            unsigned recid,
+                            uint8_t pubkey[64])
+{
+    uint8_t sig[1][64];
+    int     ok = 0;
+
+    if (ctx == NULL || hash == NULL || r == NULL || s == NULL || pubkey == NULL) {
+        return -1;
+    }
+
+    memcpy(sig[0], r, 32);
+    memcpy(sig[0] + 32, s, 32);
+    secp_recover_block(ctx, (const uint8_t (*)[32])hash,
+                       (const uint8_t (*)[64])sig, &recid, 1,
+                       (uint8_t (*)[64])pubkey, &ok);
+    return ok ? 0 : -1;
+}
+
+int web3c_secp256k1_recover_batch(const web3c_secp256k1_ctx *ctx,
+                                  const uint8_t (*hashes)[32],
+                                  const uint8_t (*sigs)[64],
+                                  const unsigned *recids,
+                                  size_t n,
+                                  uint8_t (*addresses)[20],
+                                  int *status)
+{
+    uint8_t        pubs[SECP_RECOVER_BLOCK][64];
+    uint8_t        hashed[SECP_RECOVER_BLOCK][32];
+    const uint8_t *inputs[SECP_RECOVER_BLOCK];
+    size_t         lens[SECP_RECOVER_BLOCK];
+    int            ok[SECP_RECOVER_BLOCK];
+    int            failed = 0;
+
+    if (n == 0) {
+        return 0;
+    }
+    if (ctx == NULL || hashes == NULL || sigs == NULL || recids == NULL ||
+        addresses == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < SECP_RECOVER_BLOCK; ++i) {
+        inputs[i] = pubs[i];
+        lens[i]   = 64;
+    }
+
+    for (size_t base = 0; base < n; base += SECP_RECOVER_BLOCK) {
+        size_t count = n - base < SECP_RECOVER_BLOCK ? n - base : SECP_RECOVER_BLOCK;
+
+        secp_recover_block(ctx, hashes + base, sigs + base, recids + base,
+                           count, pubs, ok);
+        web3c_keccak256_batch(inputs, lens, hashed, count);
+
+        for (size_t i = 0; i < count; ++i) {
+            if (ok[i]) {
+                memcpy(addresses[base + i], hashed[i] + 12, 20);
+            } else {
+                memset(addresses[base + i], 0, 20);
+                failed = 1;
+            }
+            if (status) {
+                status[base + i] = ok[i] ? 0 : -1;
+            }
+        }
+    }
+
+    return failed ? -1 : 0;
+}
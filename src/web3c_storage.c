@@ -0,0 +1,214 @@
+#include "web3c/storage.h"
+#include "web3c/abi.h"
+#include "web3c/keccak.h"
+
+#include <string.h>
+
+/* Preimages hashed per web3c_keccak256_batch() call. */
+#define WEB3C_STORAGE_BATCH 64
+
+/* out = word + value (mod 2^256), both big-endian; out may alias word. */
+static void web3c_storage_add64(const uint8_t word[32],
+                                uint64_t value,
+                                uint8_t out[32])
+{
+    unsigned carry = 0;
+
+    for (int i = 31; i >= 0; --i) {
+        unsigned sum = (unsigned)word[i] + (unsigned)(value & 0xFF) + carry;
+        out[i] = (uint8_t)sum;
+        carry  = sum >> 8;
+        value >>= 8;
+    }
+}
+
+int web3c_storage_mapping_slot(const uint8_t key[32],
+                               const uint8_t slot[32],
+                               uint8_t out[32])
+{
+    uint8_t pre[64];
+
+    if (key == NULL || slot == NULL || out == NULL) {
+        return -1;
+    }
+
+    memcpy(pre, key, 32);
+    memcpy(pre + 32, slot, 32);
+    return web3c_keccak256(pre, sizeof(pre), out);
+}
+
+int web3c_storage_mapping_slot_address(const uint8_t address[20],
+                                       const uint8_t slot[32],
+                                       uint8_t out[32])
+{
+    uint8_t pre[64];
+
+    if (address == NULL || slot == NULL || out == NULL) {
+        return -1;
+    }
+
+    web3c_abi_encode_address(address, pre);
+    memcpy(pre + 32, slot, 32);
+    return web3c_keccak256(pre, sizeof(pre), out);
+}
+
+int web3c_storage_array_slot(const uint8_t slot[32],
+                             uint64_t index,
+                             uint8_t out[32])
+{
+    if (slot == NULL || out == NULL) {
+        return -1;
+    }
+
+    if (web3c_keccak256(slot, 32, out) != 0) {
+        return -1;
+    }
+    web3c_storage_add64(out, index, out);
+    return 0;
+}
+
+int web3c_storage_nested_slot(const uint8_t (*keys)[32],
+                              size_t depth,
+                              const uint8_t slot[32],
+                              uint8_t out[32])
+{
+    return web3c_storage_nested_slots(keys, depth, 1, slot, (uint8_t (*)[32])out);
+}
+
+/*
+ * Hash m 64-byte preimages into outs. Only the first word of each
+ * preimage changes between calls, so callers fill the second word once.
+ */
+static int web3c_storage_hash64(uint8_t pre[][64],
+                                size_t m,
+                                uint8_t (*outs)[32])
+{
+    const uint8_t *in[WEB3C_STORAGE_BATCH];
+    size_t         lens[WEB3C_STORAGE_BATCH];
+
+    for (size_t j = 0; j < m; ++j) {
+        in[j]   = pre[j];
+        lens[j] = 64;
+    }
+    return web3c_keccak256_batch(in, lens, outs, m);
+}
+
+int web3c_storage_mapping_slots(const uint8_t (*keys)[32],
+                                size_t n,
+                                const uint8_t slot[32],
+                                uint8_t (*outs)[32])
+{
+    uint8_t pre[WEB3C_STORAGE_BATCH][64];
+
+    if (slot == NULL || (n > 0 && (keys == NULL || outs == NULL))) {
+        return -1;
+    }
+
+    for (size_t j = 0; j < WEB3C_STORAGE_BATCH; ++j) {
+        memcpy(pre[j] + 32, slot, 32);
+    }
+
+    for (size_t done = 0; done < n; ) {
+        size_t m = n - done < WEB3C_STORAGE_BATCH ? n - done : WEB3C_STORAGE_BATCH;
+
+        for (size_t j = 0; j < m; ++j) {
+            memcpy(pre[j], keys[done + j], 32);
+        }
+        if (web3c_storage_hash64(pre, m, outs + done) != 0) {
+            return -1;
+        }
+        done += m;
+    }
+
+    return 0;
+}
+
+int web3c_storage_mapping_slots_address(const uint8_t (*addresses)[20],
+                                        size_t n,
+                                        const uint8_t slot[32],
+                                        uint8_t (*outs)[32])
+{
+    uint8_t pre[WEB3C_STORAGE_BATCH][64];
+
+    if (slot == NULL || (n > 0 && (addresses == NULL || outs == NULL))) {
+        return -1;
+    }
+
+    /* ABI address word: 12 zero bytes, then the address. */
+    for (size_t j = 0; j < WEB3C_STORAGE_BATCH; ++j) {
+        memset(pre[j], 0, 12);
+        memcpy(pre[j] + 32, slot, 32);
+    }
+
+    for (size_t done = 0; done < n; ) {
+        size_t m = n - done < WEB3C_STORAGE_BATCH ? n - done : WEB3C_STORAGE_BATCH;
+
+        for (size_t j = 0; j < m; ++j) {
+            memcpy(pre[j] + 12, addresses[done + j], 20);
+        }
+        if (web3c_storage_hash64(pre, m, outs + done) != 0) {
+            return -1;
+        }
+        done += m;
+    }
+
+    return 0;
+}
+
+int web3c_storage_array_slots(const uint8_t slot[32],
+                              uint64_t first_index,
+                              size_t n,
+                              uint8_t (*outs)[32])
+{
+    uint8_t base[32];
+
+    if (slot == NULL || (n > 0 && outs == NULL)) {
+        return -1;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    if (web3c_keccak256(slot, 32, base) != 0) {
+        return -1;
+    }
+    web3c_storage_add64(base, first_index, outs[0]);
+
+    /* Consecutive slots: increment the previous one. */
+    for (size_t i = 1; i < n; ++i) {
+        web3c_storage_add64(outs[i - 1], 1, outs[i]);
+    }
+
+    return 0;
+}
+
+int web3c_storage_nested_slots(const uint8_t (*keys)[32],
+                               size_t depth,
+                               size_t n,
+                               const uint8_t slot[32],
+                               uint8_t (*outs)[32])
+{
+    uint8_t pre[WEB3C_STORAGE_BATCH][64];
+
+    if (slot == NULL || depth == 0 || (n > 0 && (keys == NULL || outs == NULL))) {
+        return -1;
+    }
+
+    for (size_t done = 0; done < n; ) {
+        size_t m = n - done < WEB3C_STORAGE_BATCH ? n - done : WEB3C_STORAGE_BATCH;
+
+        /* One batch per nesting level; each level's slot feeds the next. */
+        for (size_t d = 0; d < depth; ++d) {
+            for (size_t j = 0; j < m; ++j) {
+                memcpy(pre[j], keys[(done + j) * depth + d], 32);
+                memcpy(pre[j] + 32, d == 0 ? slot : outs[done + j], 32);
+            }
+            if (web3c_storage_hash64(pre, m, outs + done) != 0) {
+                return -1;
+            }
+        }
+        done += m;
+    }
+
+    return 0;
+}
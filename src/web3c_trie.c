@@ -0,0 +1,458 @@
+#include "web3c/trie.h"
+#include "web3c/keccak.h"
+
+#include <string.h>
+
+const uint8_t web3c_trie_empty_root[32] = {
+    0x56, 0xe8, 0x1f, 0x17, 0x1b, 0xcc, 0x55, 0xa6,
+    0xff, 0x83, 0x45, 0xe6, 0x92, 0xc0, 0xf8, 0x6e,
+    0x5b, 0x48, 0xe0, 0x1b, 0x99, 0x6c, 0xad, 0xc0,
+    0x01, 0x62, 0x2f, 0xb5, 0xe3, 0x63, 0xb4, 0x21
+};
+
+/* rlp(index) is at most 9 bytes for a 64-bit index. */
+#define WEB3C_TRIE_MAX_NIBBLES 18
+
+/* Bytes of node encodings buffered before the pending hashes are flushed. */
+#define WEB3C_TRIE_ARENA 16384
+
+/* Node hashes buffered before a flush. */
+#define WEB3C_TRIE_MAX_PENDING 64
+
+/* Largest branch encoding: header + 16 * (0xa0 ++ hash) + empty value. */
+#define WEB3C_TRIE_BRANCH_MAX (3 + 16 * 33 + 1)
+
+/*
+ * Reference to a child node as it appears inside its parent:
+ *   len == 0  - no child (encoded as 0x80)
+ *   len <  32 - the node's own encoding, embedded verbatim
+ *   len == 32 - keccak256 of the node's encoding
+ */
+typedef struct {
+    uint8_t len;
+    uint8_t data[32];
+} web3c_trie_ref;
+
+/* A node encoding in the arena whose hash still has to be computed. */
+typedef struct {
+    size_t          off;
+    size_t          len;
+    web3c_trie_ref *dest;
+} web3c_trie_pending;
+
+typedef struct {
+    const uint8_t *const *items;
+    const size_t         *lens;
+    size_t                n;
+
+    uint8_t               arena[WEB3C_TRIE_ARENA];
+    size_t                arena_used;
+    web3c_trie_pending    pending[WEB3C_TRIE_MAX_PENDING];
+    size_t                npending;
+} web3c_trie_builder;
+
+/*
+ * Item index of the j-th key in sorted key order.
+ *
+ * rlp(0) = 0x80 sorts after the single-byte keys 0x01..0x7f and before
+ * the multi-byte keys 0x81.., which in turn sort by numeric value.
+ */
+static size_t web3c_trie_sorted_index(size_t n, size_t j)
+{
+    size_t small = (n < 128 ? n : 128) - 1; /* keys 1..127 present */
+
+    if (j < small) {
+        return j + 1;
+    }
+    if (j == small) {
+        return 0;
+    }
+    return j;
+}
+
+/* Nibbles of rlp(index); returns the nibble count. */
+static size_t web3c_trie_key(size_t index, uint8_t nib[WEB3C_TRIE_MAX_NIBBLES])
+{
+    uint8_t key[9];
+    size_t  len = 0;
+
+    if (index == 0) {
+        key[len++] = 0x80;
+    } else if (index < 0x80) {
+        key[len++] = (uint8_t)index;
+    } else {
+        size_t bytes = 0;
+        for (uint64_t v = index; v != 0; v >>= 8) {
+            ++bytes;
+        }
+        key[len++] = (uint8_t)(0x80 + bytes);
+        for (size_t i = bytes; i > 0; --i) {
+            key[len++] = (uint8_t)((uint64_t)index >> (8 * (i - 1)));
+        }
+    }
+
+    for (size_t i = 0; i < len; ++i) {
+        nib[2 * i]     = key[i] >> 4;
+        nib[2 * i + 1] = key[i] & 0x0F;
+    }
+    return 2 * len;
+}
+
+static uint8_t web3c_trie_nibble_at(const web3c_trie_builder *b,
+                                    size_t j,
+                                    size_t depth)
+{
+    uint8_t nib[WEB3C_TRIE_MAX_NIBBLES];
+
+    web3c_trie_key(web3c_trie_sorted_index(b->n, j), nib);
+    return nib[depth];
+}
+
+/* RLP string/list header for a payload of len bytes; returns its size. */
+static size_t web3c_trie_put_header(uint8_t *out, size_t len, uint8_t base)
+{
+    if (len <= 55) {
+        out[0] = (uint8_t)(base + len);
+        return 1;
+    }
+
+    size_t bytes = 0;
+    for (size_t v = len; v != 0; v >>= 8) {
+        ++bytes;
+    }
+    out[0] = (uint8_t)(base + 55 + bytes);
+    for (size_t i = 0; i < bytes; ++i) {
+        out[1 + i] = (uint8_t)(len >> (8 * (bytes - 1 - i)));
+    }
+    return 1 + bytes;
+}
+
+/* RLP-encoded hex-prefix path; returns its size (at most 11 bytes). */
+static size_t web3c_trie_put_path(uint8_t *out,
+                                  const uint8_t *nib,
+                                  size_t count,
+                                  int leaf)
+{
+    uint8_t hp[1 + WEB3C_TRIE_MAX_NIBBLES / 2];
+    size_t  hp_len = 1;
+    size_t  i      = 0;
+    uint8_t flag   = leaf ? 2 : 0;
+
+    if (count % 2) {
+        hp[0] = (uint8_t)(((flag + 1) << 4) | nib[0]);
+        i = 1;
+    } else {
+        hp[0] = (uint8_t)(flag << 4);
+    }
+    for (; i < count; i += 2) {
+        hp[hp_len++] = (uint8_t)((nib[i] << 4) | nib[i + 1]);
+    }
+
+    if (hp_len == 1 && hp[0] < 0x80) {
+        out[0] = hp[0];
+        return 1;
+    }
+    out[0] = (uint8_t)(0x80 + hp_len);
+    memcpy(out + 1, hp, hp_len);
+    return 1 + hp_len;
+}
+
+static size_t web3c_trie_put_ref(uint8_t *out, const web3c_trie_ref *ref)
+{
+    if (ref->len == 0) {
+        out[0] = 0x80;
+        return 1;
+    }
+    if (ref->len == 32) {
+        out[0] = 0xa0;
+        memcpy(out + 1, ref->data, 32);
+        return 33;
+    }
+    memcpy(out, ref->data, ref->len);
+    return ref->len;
+}
+
+/* Hash every pending node encoding in one batch and fill in the refs. */
+static int web3c_trie_flush(web3c_trie_builder *b)
+{
+    const uint8_t *in[WEB3C_TRIE_MAX_PENDING];
+    size_t         lens[WEB3C_TRIE_MAX_PENDING];
+    uint8_t        outs[WEB3C_TRIE_MAX_PENDING][32];
+
+    if (b->npending == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < b->npending; ++i) {
+        in[i]   = b->arena + b->pending[i].off;
+        lens[i] = b->pending[i].len;
+    }
+    if (web3c_keccak256_batch(in, lens, outs, b->npending) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < b->npending; ++i) {
+        b->pending[i].dest->len = 32;
+        memcpy(b->pending[i].dest->data, outs[i], 32);
+    }
+
+    b->npending   = 0;
+    b->arena_used = 0;
+    return 0;
+}
+
+/*
+ * Reserve len bytes of arena for a node encoding whose hash goes to dest.
+ * Returns NULL if the encoding can never fit the arena.
+ */
+static uint8_t *web3c_trie_reserve(web3c_trie_builder *b,
+                                   size_t len,
+                                   web3c_trie_ref *dest)
+{
+    if (len > WEB3C_TRIE_ARENA) {
+        return NULL;
+    }
+    if (b->arena_used + len > WEB3C_TRIE_ARENA ||
+        b->npending == WEB3C_TRIE_MAX_PENDING) {
+        if (web3c_trie_flush(b) != 0) {
+            return NULL;
+        }
+    }
+
+    web3c_trie_pending *p = &b->pending[b->npending++];
+    p->off  = b->arena_used;
+    p->len  = len;
+    p->dest = dest;
+
+    uint8_t *out = b->arena + b->arena_used;
+    b->arena_used += len;
+    return out;
+}
+
+/* Store a finished node encoding as a reference in dest. */
+static int web3c_trie_emit(web3c_trie_builder *b,
+                           const uint8_t *enc,
+                           size_t len,
+                           web3c_trie_ref *dest)
+{
+    if (len < 32) {
+        dest->len = (uint8_t)len;
+        memcpy(dest->data, enc, len);
+        return 0;
+    }
+
+    uint8_t *out = web3c_trie_reserve(b, len, dest);
+    if (out == NULL) {
+        return -1;
+    }
+    memcpy(out, enc, len);
+    return 0;
+}
+
+/* Leaf node: [hp(path, leaf), rlp(item)]. */
+static int web3c_trie_leaf(web3c_trie_builder *b,
+                           size_t index,
+                           const uint8_t *path,
+                           size_t path_len,
+                           web3c_trie_ref *dest)
+{
+    const uint8_t *item = b->items[index];
+    size_t         len  = b->lens[index];
+    uint8_t        head[32];
+    size_t         path_size;
+    size_t         value_head;
+    size_t         list_head;
+
+    if (item == NULL && len != 0) {
+        return -1;
+    }
+
+    /* Encode the path and value header after room for the list header. */
+    path_size = web3c_trie_put_path(head + 9, path, path_len, 1);
+    if (len == 1 && item[0] < 0x80) {
+        value_head = 0;
+    } else {
+        value_head = web3c_trie_put_header(head + 9 + path_size, len, 0x80);
+    }
+
+    size_t   payload = path_size + value_head + len;
+    uint8_t  list[9];
+    list_head = web3c_trie_put_header(list, payload, 0xc0);
+
+    size_t total = list_head + payload;
+    uint8_t *out = NULL;
+    uint8_t  small[32];
+
+    if (total < 32) {
+        out = small;
+    } else {
+        out = web3c_trie_reserve(b, total, dest);
+    }
+
+    if (out == NULL) {
+        /* Too large to buffer: hash it straight from the caller's item. */
+        web3c_keccak_ctx ctx;
+
+        web3c_keccak256_init(&ctx);
+        web3c_keccak_update(&ctx, list, list_head);
+        web3c_keccak_update(&ctx, head + 9, path_size + value_head);
+        web3c_keccak_update(&ctx, item, len);
+        web3c_keccak_final(&ctx, dest->data);
+        dest->len = 32;
+        return 0;
+    }
+
+    memcpy(out, list, list_head);
+    memcpy(out + list_head, head + 9, path_size + value_head);
+    if (len) {
+        memcpy(out + list_head + path_size + value_head, item, len);
+    }
+
+    if (out == small) {
+        dest->len = (uint8_t)total;
+        memcpy(dest->data, small, total);
+    }
+    return 0;
+}
+
+static int web3c_trie_node(web3c_trie_builder *b,
+                           size_t lo,
+                           size_t hi,
+                           size_t depth,
+                           web3c_trie_ref *dest);
+
+/* Branch node over sorted keys [lo, hi) that all share depth nibbles. */
+static int web3c_trie_branch(web3c_trie_builder *b,
+                             size_t lo,
+                             size_t hi,
+                             size_t depth,
+                             web3c_trie_ref *dest)
+{
+    web3c_trie_ref children[16];
+    uint8_t        enc[WEB3C_TRIE_BRANCH_MAX];
+    uint8_t        payload[WEB3C_TRIE_BRANCH_MAX];
+    size_t         payload_len = 0;
+
+    memset(children, 0, sizeof(children));
+
+    for (size_t j = lo; j < hi; ) {
+        uint8_t v = web3c_trie_nibble_at(b, j, depth);
+
+        /* Keys are sorted: find the end of the run with nibble v. */
+        size_t l = j + 1;
+        size_t r = hi;
+        while (l < r) {
+            size_t mid = l + (r - l) / 2;
+            if (web3c_trie_nibble_at(b, mid, depth) == v) {
+                l = mid + 1;
+            } else {
+                r = mid;
+            }
+        }
+
+        if (web3c_trie_node(b, j, l, depth + 1, &children[v]) != 0) {
+            return -1;
+        }
+        j = l;
+    }
+
+    /* Children hashes are needed now; this also hashes their siblings. */
+    if (web3c_trie_flush(b) != 0) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        payload_len += web3c_trie_put_ref(payload + payload_len, &children[i]);
+    }
+    payload[payload_len++] = 0x80; /* keys are prefix-free: no value */
+
+    size_t head = web3c_trie_put_header(enc, payload_len, 0xc0);
+    memcpy(enc + head, payload, payload_len);
+
+    return web3c_trie_emit(b, enc, head + payload_len, dest);
+}
+
+/* Subtrie over sorted keys [lo, hi) that all share depth nibbles. */
+static int web3c_trie_node(web3c_trie_builder *b,
+                           size_t lo,
+                           size_t hi,
+                           size_t depth,
+                           web3c_trie_ref *dest)
+{
+    uint8_t first[WEB3C_TRIE_MAX_NIBBLES];
+    uint8_t last[WEB3C_TRIE_MAX_NIBBLES];
+    size_t  first_len = web3c_trie_key(web3c_trie_sorted_index(b->n, lo), first);
+
+    if (hi - lo == 1) {
+        return web3c_trie_leaf(b, web3c_trie_sorted_index(b->n, lo),
+                               first + depth, first_len - depth, dest);
+    }
+
+    /* The common prefix of a sorted range is that of its end points. */
+    size_t last_len = web3c_trie_key(web3c_trie_sorted_index(b->n, hi - 1), last);
+    size_t cp       = depth;
+    while (cp < first_len && cp < last_len && first[cp] == last[cp]) {
+        ++cp;
+    }
+
+    if (cp == depth) {
+        return web3c_trie_branch(b, lo, hi, depth, dest);
+    }
+
+    /* Extension node: [hp(shared nibbles), branch]. */
+    web3c_trie_ref child;
+    uint8_t        enc[3 + 11 + 33];
+    uint8_t        payload[11 + 33];
+    size_t         payload_len;
+
+    memset(&child, 0, sizeof(child));
+    if (web3c_trie_branch(b, lo, hi, cp, &child) != 0 ||
+        web3c_trie_flush(b) != 0) {
+        return -1;
+    }
+
+    payload_len  = web3c_trie_put_path(payload, first + depth, cp - depth, 0);
+    payload_len += web3c_trie_put_ref(payload + payload_len, &child);
+
+    size_t head = web3c_trie_put_header(enc, payload_len, 0xc0);
+    memcpy(enc + head, payload, payload_len);
+
+    return web3c_trie_emit(b, enc, head + payload_len, dest);
+}
+
+int web3c_trie_ordered_root(const uint8_t *const *items,
+                            const size_t *lens,
+                            size_t n,
+                            uint8_t root[32])
+{
+    web3c_trie_builder b;
+    web3c_trie_ref     ref;
+
+    if (root == NULL || (n > 0 && (items == NULL || lens == NULL))) {
+        return -1;
+    }
+
+    if (n == 0) {
+        memcpy(root, web3c_trie_empty_root, 32);
+        return 0;
+    }
+
+    b.items      = items;
+    b.lens       = lens;
+    b.n          = n;
+    b.arena_used = 0;
+    b.npending   = 0;
+    memset(&ref, 0, sizeof(ref));
+
+    if (web3c_trie_node(&b, 0, n, 0, &ref) != 0 ||
+        web3c_trie_flush(&b) != 0) {
+        return -1;
+    }
+
+    /* The root is always referenced by hash, even when short. */
+    if (ref.len < 32) {
+        return web3c_keccak256(ref.data, ref.len, root);
+    }
+
+    memcpy(root, ref.data, 32);
+    return 0;
+}
@@ -1,5 +1,8 @@
 #include "web3c/tx.h"
 #include "web3c/rlp.h"
+#include "web3c/keccak.h"
+#include "web3c/secp256k1.h"
+#include "web3c_rlp_internal.h"
 
 #include <string.h>
 
@@ -70,6 +73,21 @@ int web3c_tx_legacy_validate(const web3c_tx_legacy *tx) {
     return 0;
 }
 
+/*
+ * Payload length of [nonce, gasPrice, gasLimit, to, value, data,
+ * chainId, 0, 0], from arithmetic sizes only.
+ */
+static size_t tx_legacy_payload_len(const web3c_tx_legacy *tx) {
+    return web3c_rlp_uint64_size(tx->nonce) +
+           web3c_rlp_uint64_size(tx->gas_price) +
+           web3c_rlp_uint64_size(tx->gas_limit) +
+           (tx->has_to ? 1 + 20 : 1) +
+           web3c_rlp_uint64_size(tx->value) +
+           web3c_rlp_bytes_size(tx->data, tx->data_len) +
+           web3c_rlp_uint64_size(tx->chain_id) +
+           2; /* r = 0, s = 0: 0x80 each */
+}
+
 int web3c_tx_legacy_rlp_size(const web3c_tx_legacy *tx, size_t *out_size) {
     if (tx == NULL || out_size == NULL) {
         return -1;
@@ -79,215 +97,757 @@ int web3c_tx_legacy_rlp_size(const web3c_tx_legacy *tx, size_t *out_size) {
         return -1;
     }
 
-    size_t len_nonce      = 0;
-    size_t len_gas_price  = 0;
-    size_t len_gas_limit  = 0;
-    size_t len_to         = 0;
-    size_t len_value      = 0;
-    size_t len_data       = 0;
-    size_t len_chain_id   = 0;
-    size_t len_zero_r     = 0;
-    size_t len_zero_s     = 0;
+    *out_size = web3c_rlp_list_size(tx_legacy_payload_len(tx));
+    return 0;
+}
 
-    /* 1) Size of each element (size-only mode). */
-    if (web3c_rlp_encode_uint64(tx->nonce, NULL, 0, &len_nonce) != 0) {
+int web3c_tx_legacy_rlp_encode(const web3c_tx_legacy *tx,
+                               uint8_t *out,
+                               size_t out_size,
+                               size_t *out_len)
+{
+    if (tx == NULL || out == NULL) {
         return -1;
     }
-    if (web3c_rlp_encode_uint64(tx->gas_price, NULL, 0, &len_gas_price) != 0) {
+
+    if (web3c_tx_legacy_validate(tx) != 0) {
         return -1;
     }
-    if (web3c_rlp_encode_uint64(tx->gas_limit, NULL, 0, &len_gas_limit) != 0) {
+
+    /*
+     * Sizes are arithmetic; every field is then written exactly once by
+     * the unchecked writers, after the single size check below.
+     */
+    size_t payload_len = tx_legacy_payload_len(tx);
+    size_t total_size  = web3c_rlp_list_size(payload_len);
+
+    if (out_size < total_size) {
         return -1;
     }
 
-    if (tx->has_to) {
-        if (web3c_rlp_encode_bytes(tx->to, 20, NULL, 0, &len_to) != 0) {
-            return -1;
-        }
-    } else {
-        if (web3c_rlp_encode_bytes(NULL, 0, NULL, 0, &len_to) != 0) {
-            return -1;
-        }
+    uint8_t *p = web3c_rlp_put_length(out, payload_len, 0xC0);
+
+    p = web3c_rlp_put_uint64(p, tx->nonce);
+    p = web3c_rlp_put_uint64(p, tx->gas_price);
+    p = web3c_rlp_put_uint64(p, tx->gas_limit);
+    p = web3c_rlp_put_bytes(p, tx->to, tx->has_to ? 20 : 0);
+    p = web3c_rlp_put_uint64(p, tx->value);
+    p = web3c_rlp_put_bytes(p, tx->data, tx->data_len);
+    p = web3c_rlp_put_uint64(p, tx->chain_id);
+    *p++ = 0x80;
+    *p++ = 0x80;
+
+    if (out_len) {
+        *out_len = (size_t)(p - out);
     }
 
-    if (web3c_rlp_encode_uint64(tx->value, NULL, 0, &len_value) != 0) {
+    return 0;
+}
+
+int web3c_tx_legacy_rlp_encode_iov(const web3c_tx_legacy *tx,
+                                   uint8_t scratch[WEB3C_TX_IOV_SCRATCH],
+                                   web3c_rlp_iovec iov[WEB3C_TX_IOV_MAX],
+                                   size_t *iov_count,
+                                   size_t *out_len)
+{
+    if (tx == NULL || scratch == NULL || iov == NULL || iov_count == NULL) {
         return -1;
     }
 
-    if (web3c_rlp_encode_bytes(tx->data, tx->data_len, NULL, 0, &len_data) != 0) {
+    if (web3c_tx_legacy_validate(tx) != 0) {
         return -1;
     }
 
-    if (web3c_rlp_encode_uint64(tx->chain_id, NULL, 0, &len_chain_id) != 0) {
+    /*
+     * Worst case in scratch: 9-byte list header, five 9-byte integers,
+     * the 21-byte `to`, a 9-byte data header (or up to 33 inline data
+     * bytes) and the two zeros: 9 + 45 + 21 + 33 + 2 = 110 bytes.
+     */
+    size_t payload_len = tx_legacy_payload_len(tx);
+    uint8_t *p = web3c_rlp_put_length(scratch, payload_len, 0xC0);
+
+    p = web3c_rlp_put_uint64(p, tx->nonce);
+    p = web3c_rlp_put_uint64(p, tx->gas_price);
+    p = web3c_rlp_put_uint64(p, tx->gas_limit);
+    p = web3c_rlp_put_bytes(p, tx->to, tx->has_to ? 20 : 0);
+    p = web3c_rlp_put_uint64(p, tx->value);
+
+    if (tx->data_len <= WEB3C_TX_IOV_INLINE) {
+        p = web3c_rlp_put_bytes(p, tx->data, tx->data_len);
+        p = web3c_rlp_put_uint64(p, tx->chain_id);
+        *p++ = 0x80;
+        *p++ = 0x80;
+
+        iov[0].base = scratch;
+        iov[0].len  = (size_t)(p - scratch);
+        *iov_count  = 1;
+    } else {
+        p = web3c_rlp_put_length(p, tx->data_len, 0x80);
+        iov[0].base = scratch;
+        iov[0].len  = (size_t)(p - scratch);
+
+        /* Calldata by reference. */
+        iov[1].base = tx->data;
+        iov[1].len  = tx->data_len;
+
+        uint8_t *tail = p;
+        p = web3c_rlp_put_uint64(p, tx->chain_id);
+        *p++ = 0x80;
+        *p++ = 0x80;
+
+        iov[2].base = tail;
+        iov[2].len  = (size_t)(p - tail);
+        *iov_count  = 3;
+    }
+
+    if (out_len) {
+        *out_len = web3c_rlp_list_size(payload_len);
+    }
+
+    return 0;
+}
+
+int web3c_tx_legacy_signing_hash(const web3c_tx_legacy *tx, uint8_t out[32]) {
+    uint8_t          scratch[WEB3C_TX_IOV_SCRATCH];
+    web3c_rlp_iovec  iov[WEB3C_TX_IOV_MAX];
+    size_t           count = 0;
+    web3c_keccak_ctx ctx;
+
+    if (out == NULL ||
+        web3c_tx_legacy_rlp_encode_iov(tx, scratch, iov, &count, NULL) != 0) {
         return -1;
     }
 
-    /* r = 0, s = 0 for unsigned preimage. */
-    if (web3c_rlp_encode_uint64(0, NULL, 0, &len_zero_r) != 0) {
+    web3c_keccak256_init(&ctx);
+    for (size_t i = 0; i < count; ++i) {
+        web3c_keccak_update(&ctx, iov[i].base, iov[i].len);
+    }
+    web3c_keccak_final(&ctx, out);
+
+    return 0;
+}
+
+/*
+ * Payload of the signed list: the unsigned one with chainId, 0, 0
+ * replaced by v, r, s.
+ */
+static size_t tx_legacy_signed_payload_len(const web3c_tx_legacy *tx,
+                                           uint64_t v,
+                                           const uint8_t r[32],
+                                           const uint8_t s[32])
+{
+    return tx_legacy_payload_len(tx) - web3c_rlp_uint64_size(tx->chain_id) - 2 +
+           web3c_rlp_uint64_size(v) +
+           web3c_rlp_uint256_size(r) +
+           web3c_rlp_uint256_size(s);
+}
+
+int web3c_tx_legacy_signed_rlp_size(const web3c_tx_legacy *tx,
+                                    uint64_t v,
+                                    const uint8_t r[32],
+                                    const uint8_t s[32],
+                                    size_t *out_size)
+{
+    if (tx == NULL || r == NULL || s == NULL || out_size == NULL ||
+        web3c_tx_legacy_validate(tx) != 0) {
         return -1;
     }
-    if (web3c_rlp_encode_uint64(0, NULL, 0, &len_zero_s) != 0) {
+
+    *out_size = web3c_rlp_list_size(tx_legacy_signed_payload_len(tx, v, r, s));
+    return 0;
+}
+
+int web3c_tx_legacy_signed_rlp_encode(const web3c_tx_legacy *tx,
+                                      uint64_t v,
+                                      const uint8_t r[32],
+                                      const uint8_t s[32],
+                                      uint8_t *out,
+                                      size_t out_size,
+                                      size_t *out_len)
+{
+    if (tx == NULL || r == NULL || s == NULL || out == NULL ||
+        web3c_tx_legacy_validate(tx) != 0) {
         return -1;
     }
 
-    size_t payload_len =
-        len_nonce +
-        len_gas_price +
-        len_gas_limit +
-        len_to +
-        len_value +
-        len_data +
-        len_chain_id +
-        len_zero_r +
-        len_zero_s;
+    size_t payload_len = tx_legacy_signed_payload_len(tx, v, r, s);
 
-    size_t list_header_len = 0;
-    if (web3c_rlp_encode_list_header(payload_len,
-                                     NULL, 0, &list_header_len) != 0) {
+    if (out_size < web3c_rlp_list_size(payload_len)) {
         return -1;
     }
 
-    *out_size = list_header_len + payload_len;
+    uint8_t *p = web3c_rlp_put_length(out, payload_len, 0xC0);
+
+    p = web3c_rlp_put_uint64(p, tx->nonce);
+    p = web3c_rlp_put_uint64(p, tx->gas_price);
+    p = web3c_rlp_put_uint64(p, tx->gas_limit);
+    p = web3c_rlp_put_bytes(p, tx->to, tx->has_to ? 20 : 0);
+    p = web3c_rlp_put_uint64(p, tx->value);
+    p = web3c_rlp_put_bytes(p, tx->data, tx->data_len);
+    p = web3c_rlp_put_uint64(p, v);
+    p = web3c_rlp_put_uint256(p, r);
+    p = web3c_rlp_put_uint256(p, s);
+
+    if (out_len) {
+        *out_len = (size_t)(p - out);
+    }
+
     return 0;
 }
 
-int web3c_tx_legacy_rlp_encode(const web3c_tx_legacy *tx,
-                               uint8_t *out,
-                               size_t out_size,
-                               size_t *out_len)
+int web3c_tx_legacy_sign(const web3c_secp256k1_ctx *ctx,
+                         const web3c_tx_legacy *tx,
+                         const uint8_t seckey[32],
+                         uint8_t *out,
+                         size_t out_size,
+                         size_t *out_len)
 {
-    if (tx == NULL || out == NULL) {
+    uint8_t  hash[32], r[32], s[32];
+    unsigned recid = 0;
+
+    if (web3c_tx_legacy_signing_hash(tx, hash) != 0) {
         return -1;
     }
 
-    size_t total_size = 0;
-    if (web3c_tx_legacy_rlp_size(tx, &total_size) != 0) {
+    /* v = recid + 35 + 2 * chainId must fit in 64 bits. */
+    if (tx->chain_id > (UINT64_MAX - 36) / 2) {
         return -1;
     }
 
-    if (out_size < total_size) {
+    if (web3c_secp256k1_sign(ctx, hash, seckey, r, s, &recid) != 0 || recid > 1) {
         return -1;
     }
 
-    /* Recompute individual element sizes, then encode. */
-    size_t len_nonce      = 0;
-    size_t len_gas_price  = 0;
-    size_t len_gas_limit  = 0;
-    size_t len_to         = 0;
-    size_t len_value      = 0;
-    size_t len_data       = 0;
-    size_t len_chain_id   = 0;
-    size_t len_zero_r     = 0;
-    size_t len_zero_s     = 0;
+    return web3c_tx_legacy_signed_rlp_encode(tx, 35 + 2 * tx->chain_id + recid,
+                                             r, s, out, out_size, out_len);
+}
 
-    if (web3c_rlp_encode_uint64(tx->nonce, NULL, 0, &len_nonce) != 0 ||
-        web3c_rlp_encode_uint64(tx->gas_price, NULL, 0, &len_gas_price) != 0 ||
-        web3c_rlp_encode_uint64(tx->gas_limit, NULL, 0, &len_gas_limit) != 0) {
+/* Payload of [address, [keys]] for an address with count keys. */
+static size_t tx_access_entry_payload(size_t count) {
+    return 1 + 20 + web3c_rlp_list_size(33 * count);
+}
+
+/*
+ * One sweep over the counts: checks every key range and sums the
+ * encoded entries. Returns the outer list's payload length, or -1.
+ */
+static int tx_access_list_payload(const web3c_access_list *al, size_t *payload) {
+    size_t next  = 0;
+    size_t total = 0;
+
+    if (al == NULL ||
+        (al->n_addresses > 0 && (al->addresses == NULL || al->key_counts == NULL)) ||
+        (al->n_keys > 0 && al->keys == NULL)) {
         return -1;
     }
 
-    if (tx->has_to) {
-        if (web3c_rlp_encode_bytes(tx->to, 20, NULL, 0, &len_to) != 0) {
+    for (size_t i = 0; i < al->n_addresses; ++i) {
+        size_t count = al->key_counts[i];
+        size_t first = al->key_offsets ? al->key_offsets[i] : next;
+
+        if (first > al->n_keys || count > al->n_keys - first) {
             return -1;
         }
-    } else {
-        if (web3c_rlp_encode_bytes(NULL, 0, NULL, 0, &len_to) != 0) {
-            return -1;
+        next   = first + count;
+        total += web3c_rlp_list_size(tx_access_entry_payload(count));
+    }
+
+    *payload = total;
+    return 0;
+}
+
+int web3c_access_list_rlp_size(const web3c_access_list *al, size_t *out_size) {
+    size_t payload;
+
+    if (out_size == NULL || tx_access_list_payload(al, &payload) != 0) {
+        return -1;
+    }
+
+    *out_size = web3c_rlp_list_size(payload);
+    return 0;
+}
+
+int web3c_access_list_rlp_encode(const web3c_access_list *al,
+                                 uint8_t *out,
+                                 size_t out_size,
+                                 size_t *out_len)
+{
+    size_t payload;
+
+    if (out == NULL || tx_access_list_payload(al, &payload) != 0) {
+        return -1;
+    }
+
+    if (out_size < web3c_rlp_list_size(payload)) {
+        return -1;
+    }
+
+    uint8_t *p    = web3c_rlp_put_length(out, payload, 0xC0);
+    size_t   next = 0;
+
+    for (size_t i = 0; i < al->n_addresses; ++i) {
+        size_t count = al->key_counts[i];
+        size_t first = al->key_offsets ? al->key_offsets[i] : next;
+
+        p = web3c_rlp_put_length(p, tx_access_entry_payload(count), 0xC0);
+        *p++ = 0x80 + 20;
+        memcpy(p, al->addresses[i], 20);
+        p = web3c_rlp_put_length(p + 20, 33 * count, 0xC0);
+
+        /* Keys are always 32-byte strings: 0xa0 + the key. */
+        for (size_t k = 0; k < count; ++k) {
+            p[0] = 0x80 + 32;
+            memcpy(p + 1, al->keys[first + k], 32);
+            p += 33;
         }
+        next = first + count;
+    }
+
+    if (out_len) {
+        *out_len = (size_t)(p - out);
+    }
+    return 0;
+}
+
+void web3c_tx_1559_init(web3c_tx_1559 *tx) {
+    if (tx == NULL) {
+        return;
     }
 
-    if (web3c_rlp_encode_uint64(tx->value, NULL, 0, &len_value) != 0 ||
-        web3c_rlp_encode_bytes(tx->data, tx->data_len, NULL, 0, &len_data) != 0 ||
-        web3c_rlp_encode_uint64(tx->chain_id, NULL, 0, &len_chain_id) != 0 ||
-        web3c_rlp_encode_uint64(0, NULL, 0, &len_zero_r) != 0 ||
-        web3c_rlp_encode_uint64(0, NULL, 0, &len_zero_s) != 0) {
+    memset(tx, 0, sizeof(*tx));
+    tx->data        = NULL;
+    tx->access_list = NULL;
+}
+
+int web3c_tx_1559_set_to(web3c_tx_1559 *tx, const uint8_t to[20]) {
+    if (tx == NULL || to == NULL) {
         return -1;
     }
 
-    size_t payload_len =
-        len_nonce +
-        len_gas_price +
-        len_gas_limit +
-        len_to +
-        len_value +
-        len_data +
-        len_chain_id +
-        len_zero_r +
-        len_zero_s;
+    memcpy(tx->to, to, 20);
+    tx->has_to = 1;
+
+    return 0;
+}
 
-    size_t list_header_len = 0;
-    if (web3c_rlp_encode_list_header(payload_len,
-                                     out, out_size, &list_header_len) != 0) {
+int web3c_tx_1559_set_data(web3c_tx_1559 *tx, const uint8_t *data, size_t len) {
+    if (tx == NULL || (len > 0 && data == NULL)) {
         return -1;
     }
 
-    size_t offset = list_header_len;
+    tx->data     = data;
+    tx->data_len = len;
+
+    return 0;
+}
+
+int web3c_tx_1559_set_access_list(web3c_tx_1559 *tx,
+                                  const uint8_t *encoded,
+                                  size_t len)
+{
+    web3c_rlp_item item;
 
-    /* Now encode each element into place. */
-    if (web3c_rlp_encode_uint64(tx->nonce,
-                                out + offset, out_size - offset, &len_nonce) != 0) {
+    if (tx == NULL || (len > 0 && encoded == NULL)) {
         return -1;
     }
-    offset += len_nonce;
 
-    if (web3c_rlp_encode_uint64(tx->gas_price,
-                                out + offset, out_size - offset, &len_gas_price) != 0) {
+    /* Checked once here, so the encoders can copy it blindly. */
+    if (len > 0 &&
+        (web3c_rlp_decode(encoded, len, &item) != 0 ||
+         item.type != WEB3C_RLP_LIST || item.size != len)) {
         return -1;
     }
-    offset += len_gas_price;
 
-    if (web3c_rlp_encode_uint64(tx->gas_limit,
-                                out + offset, out_size - offset, &len_gas_limit) != 0) {
+    tx->access_list     = len > 0 ? encoded : NULL;
+    tx->access_list_len = len;
+
+    return 0;
+}
+
+int web3c_tx_1559_validate(const web3c_tx_1559 *tx) {
+    if (tx == NULL) {
         return -1;
     }
-    offset += len_gas_limit;
 
-    if (tx->has_to) {
-        if (web3c_rlp_encode_bytes(tx->to, 20,
-                                   out + offset, out_size - offset, &len_to) != 0) {
-            return -1;
+    if (tx->chain_id == 0 || tx->gas_limit == 0) {
+        return -1;
+    }
+
+    if (tx->max_priority_fee_per_gas > tx->max_fee_per_gas) {
+        return -1;
+    }
+
+    if ((tx->data_len > 0 && tx->data == NULL) ||
+        (tx->access_list_len > 0 && tx->access_list == NULL)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Encoded access list, or the empty list. */
+static const uint8_t tx_empty_list = 0xC0;
+
+static const uint8_t *tx_1559_access_list(const web3c_tx_1559 *tx, size_t *len) {
+    if (tx->access_list_len == 0) {
+        *len = 1;
+        return &tx_empty_list;
+    }
+    *len = tx->access_list_len;
+    return tx->access_list;
+}
+
+/*
+ * Payload length of [chainId, nonce, maxPriorityFeePerGas, maxFeePerGas,
+ * gasLimit, to, value, data, accessList].
+ */
+static size_t tx_1559_payload_len(const web3c_tx_1559 *tx) {
+    return web3c_rlp_uint64_size(tx->chain_id) +
+           web3c_rlp_uint64_size(tx->nonce) +
+           web3c_rlp_uint64_size(tx->max_priority_fee_per_gas) +
+           web3c_rlp_uint64_size(tx->max_fee_per_gas) +
+           web3c_rlp_uint64_size(tx->gas_limit) +
+           (tx->has_to ? 1 + 20 : 1) +
+           web3c_rlp_uint256_size(tx->value) +
+           web3c_rlp_bytes_size(tx->data, tx->data_len) +
+           (tx->access_list_len > 0 ? tx->access_list_len : 1);
+}
+
+/*
+ * Type byte, list header and the fields up to value. At most
+ * 1 + 9 + 5 * 9 + 21 + 33 = 109 bytes.
+ */
+#define TX_1559_HEAD_MAX 109
+
+static uint8_t *tx_1559_put_head(const web3c_tx_1559 *tx,
+                                 size_t payload_len,
+                                 uint8_t *p)
+{
+    *p++ = WEB3C_TX_TYPE_1559;
+    p = web3c_rlp_put_length(p, payload_len, 0xC0);
+    p = web3c_rlp_put_uint64(p, tx->chain_id);
+    p = web3c_rlp_put_uint64(p, tx->nonce);
+    p = web3c_rlp_put_uint64(p, tx->max_priority_fee_per_gas);
+    p = web3c_rlp_put_uint64(p, tx->max_fee_per_gas);
+    p = web3c_rlp_put_uint64(p, tx->gas_limit);
+    p = web3c_rlp_put_bytes(p, tx->to, tx->has_to ? 20 : 0);
+    return web3c_rlp_put_uint256(p, tx->value);
+}
+
+/* Shared by the unsigned and signed encoders; sig_len extra payload bytes. */
+static int tx_1559_encode(const web3c_tx_1559 *tx,
+                          size_t sig_len,
+                          uint8_t *out,
+                          size_t out_size,
+                          uint8_t **end)
+{
+    if (tx == NULL || out == NULL || web3c_tx_1559_validate(tx) != 0) {
+        return -1;
+    }
+
+    size_t payload_len = tx_1559_payload_len(tx) + sig_len;
+
+    if (out_size < 1 + web3c_rlp_list_size(payload_len)) {
+        return -1;
+    }
+
+    size_t         al_len;
+    const uint8_t *al = tx_1559_access_list(tx, &al_len);
+    uint8_t       *p  = tx_1559_put_head(tx, payload_len, out);
+
+    p = web3c_rlp_put_bytes(p, tx->data, tx->data_len);
+    memcpy(p, al, al_len);
+    *end = p + al_len;
+    return 0;
+}
+
+int web3c_tx_1559_rlp_size(const web3c_tx_1559 *tx, size_t *out_size) {
+    if (tx == NULL || out_size == NULL || web3c_tx_1559_validate(tx) != 0) {
+        return -1;
+    }
+
+    *out_size = 1 + web3c_rlp_list_size(tx_1559_payload_len(tx));
+    return 0;
+}
+
+int web3c_tx_1559_rlp_encode(const web3c_tx_1559 *tx,
+                             uint8_t *out,
+                             size_t out_size,
+                             size_t *out_len)
+{
+    uint8_t *p;
+
+    if (tx_1559_encode(tx, 0, out, out_size, &p) != 0) {
+        return -1;
+    }
+
+    if (out_len) {
+        *out_len = (size_t)(p - out);
+    }
+    return 0;
+}
+
+int web3c_tx_1559_signing_hash(const web3c_tx_1559 *tx, uint8_t out[32]) {
+    /* Head, then data (header + up to WEB3C_TX_IOV_INLINE bytes) and 0xC0. */
+    uint8_t          head[TX_1559_HEAD_MAX + 1 + WEB3C_TX_IOV_INLINE + 1];
+    web3c_keccak_ctx ctx;
+    size_t           al_len;
+    const uint8_t   *al;
+
+    if (tx == NULL || out == NULL || web3c_tx_1559_validate(tx) != 0) {
+        return -1;
+    }
+
+    /*
+     * Head and the data header go through one small buffer; short data
+     * and an empty access list are copied along with them, long data and
+     * a real access list are absorbed where they are.
+     */
+    uint8_t *p = tx_1559_put_head(tx, tx_1559_payload_len(tx), head);
+
+    al = tx_1559_access_list(tx, &al_len);
+    web3c_keccak256_init(&ctx);
+    if (tx->data_len <= WEB3C_TX_IOV_INLINE) {
+        p = web3c_rlp_put_bytes(p, tx->data, tx->data_len);
+        if (al_len == 1) {
+            *p++ = *al;
+            al_len = 0;
         }
+        web3c_keccak_update(&ctx, head, (size_t)(p - head));
     } else {
-        if (web3c_rlp_encode_bytes(NULL, 0,
-                                   out + offset, out_size - offset, &len_to) != 0) {
-            return -1;
-        }
+        p = web3c_rlp_put_length(p, tx->data_len, 0x80);
+        web3c_keccak_update(&ctx, head, (size_t)(p - head));
+        web3c_keccak_update(&ctx, tx->data, tx->data_len);
+    }
+    if (al_len > 0) {
+        web3c_keccak_update(&ctx, al, al_len);
+    }
+    web3c_keccak_final(&ctx, out);
+
+    return 0;
+}
+
+/* yParity, r and s: canonical integers. */
+static size_t tx_sig_len(const uint8_t r[32], const uint8_t s[32]) {
+    return 1 + web3c_rlp_uint256_size(r) + web3c_rlp_uint256_size(s);
+}
+
+int web3c_tx_1559_signed_rlp_size(const web3c_tx_1559 *tx,
+                                  const uint8_t r[32],
+                                  const uint8_t s[32],
+                                  size_t *out_size)
+{
+    if (tx == NULL || r == NULL || s == NULL || out_size == NULL ||
+        web3c_tx_1559_validate(tx) != 0) {
+        return -1;
     }
-    offset += len_to;
 
-    if (web3c_rlp_encode_uint64(tx->value,
-                                out + offset, out_size - offset, &len_value) != 0) {
+    *out_size = 1 + web3c_rlp_list_size(tx_1559_payload_len(tx) + tx_sig_len(r, s));
+    return 0;
+}
+
+int web3c_tx_1559_signed_rlp_encode(const web3c_tx_1559 *tx,
+                                    unsigned y_parity,
+                                    const uint8_t r[32],
+                                    const uint8_t s[32],
+                                    uint8_t *out,
+                                    size_t out_size,
+                                    size_t *out_len)
+{
+    uint8_t *p;
+
+    if (r == NULL || s == NULL || y_parity > 1) {
         return -1;
     }
-    offset += len_value;
 
-    if (web3c_rlp_encode_bytes(tx->data, tx->data_len,
-                               out + offset, out_size - offset, &len_data) != 0) {
+    if (tx_1559_encode(tx, tx_sig_len(r, s), out, out_size, &p) != 0) {
         return -1;
     }
-    offset += len_data;
 
-    if (web3c_rlp_encode_uint64(tx->chain_id,
-                                out + offset, out_size - offset, &len_chain_id) != 0) {
+    p = web3c_rlp_put_uint64(p, y_parity);
+    p = web3c_rlp_put_uint256(p, r);
+    p = web3c_rlp_put_uint256(p, s);
+
+    if (out_len) {
+        *out_len = (size_t)(p - out);
+    }
+    return 0;
+}
+
+int web3c_tx_1559_sign(const web3c_secp256k1_ctx *ctx,
+                       const web3c_tx_1559 *tx,
+                       const uint8_t seckey[32],
+                       uint8_t *out,
+                       size_t out_size,
+                       size_t *out_len)
+{
+    uint8_t  hash[32], r[32], s[32];
+    unsigned recid = 0;
+
+    if (web3c_tx_1559_signing_hash(tx, hash) != 0 ||
+        web3c_secp256k1_sign(ctx, hash, seckey, r, s, &recid) != 0 || recid > 1) {
         return -1;
     }
-    offset += len_chain_id;
 
-    if (web3c_rlp_encode_uint64(0,
-                                out + offset, out_size - offset, &len_zero_r) != 0) {
+    return web3c_tx_1559_signed_rlp_encode(tx, recid, r, s, out, out_size, out_len);
+}
+
+/* Transactions parsed per web3c_secp256k1_recover_batch() call. */
+#define TX_RECOVER_BLOCK 64
+
+/* Most fields in a signed transaction (EIP-1559). */
+#define TX_RECOVER_FIELDS 12
+
+/* n / 2, big-endian: the largest s accepted since Homestead (EIP-2). */
+static const uint8_t tx_n_half[32] = {
+    0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x5d, 0x57, 0x6e, 0x73, 0x57, 0xa4, 0x50, 0x1d,
+    0xdf, 0xe9, 0x2f, 0x46, 0x68, 0x1b, 0x20, 0xa0
+};
+
+/* A canonical integer string of at most 32 bytes, left-padded. */
+static int tx_item_uint256(const web3c_rlp_item *item, uint8_t out[32]) {
+    if (item->type != WEB3C_RLP_STRING || item->len > 32 ||
+        (item->len > 0 && item->data[0] == 0)) {
         return -1;
     }
-    offset += len_zero_r;
+    memset(out, 0, 32 - item->len);
+    memcpy(out + 32 - item->len, item->data, item->len);
+    return 0;
+}
+
+/*
+ * Signing hash, r || s and recovery id of one raw signed transaction.
+ * The unsigned fields are hashed where they are, behind a new list
+ * header (and the EIP-155 chainId, 0, 0 suffix for legacy).
+ */
+static int tx_parse_signed(const uint8_t *raw, size_t len,
+                           uint8_t hash[32], uint8_t sig[64], unsigned *recid)
+{
+    web3c_rlp_item   list, f[TX_RECOVER_FIELDS + 1];
+    web3c_rlp_iter   it;
+    web3c_keccak_ctx ctx;
+    uint8_t          head[1 + 9], tail[9 + 2];
+    uint8_t         *h = head, *t = tail;
+    size_t           count = 0, unsigned_fields;
+    uint64_t         v;
+    int              rc;
 
-    if (web3c_rlp_encode_uint64(0,
-                                out + offset, out_size - offset, &len_zero_s) != 0) {
+    if (raw == NULL || len == 0) {
         return -1;
     }
-    offset += len_zero_s;
 
-    if (out_len) {
-        *out_len = offset;
+    /* Typed envelope: type byte, then the list. */
+    if (raw[0] == 0x01 || raw[0] == 0x02) {
+        *h++ = raw[0];
+        ++raw;
+        --len;
+    } else if (raw[0] < 0xC0) {
+        return -1;
     }
 
+    if (web3c_rlp_decode(raw, len, &list) != 0 || list.size != len ||
+        web3c_rlp_iter_init(&it, &list) != 0) {
+        return -1;
+    }
+    while ((rc = web3c_rlp_iter_next(&it, &f[count])) == 1) {
+        if (++count > TX_RECOVER_FIELDS) {
+            return -1;
+        }
+    }
+    if (rc != 0) {
+        return -1;
+    }
+
+    if (h == head) {
+        /* Legacy: [nonce, gasPrice, gasLimit, to, value, data, v, r, s] */
+        if (count != 9 || web3c_rlp_item_uint64(&f[6], &v) != 0) {
+            return -1;
+        }
+        if (v == 27 || v == 28) {
+            *recid = (unsigned)(v - 27);
+        } else if (v >= 35) {
+            *recid = (unsigned)((v - 35) & 1);
+            t = web3c_rlp_put_uint64(t, (v - 35) / 2);
+            *t++ = 0x80;
+            *t++ = 0x80;
+        } else {
+            return -1;
+        }
+        unsigned_fields = 6;
+    } else {
+        /* Typed: [..., yParity, r, s], 8 (0x01) or 9 (0x02) fields before. */
+        unsigned_fields = head[0] == 0x01 ? 8 : 9;
+        if (count != unsigned_fields + 3 ||
+            web3c_rlp_item_uint64(&f[unsigned_fields], &v) != 0 || v > 1) {
+            return -1;
+        }
+        *recid = (unsigned)v;
+    }
+
+    if (tx_item_uint256(&f[count - 2], sig) != 0 ||
+        tx_item_uint256(&f[count - 1], sig + 32) != 0 ||
+        memcmp(sig + 32, tx_n_half, 32) > 0) {
+        return -1;
+    }
+
+    const uint8_t *span     = f[0].raw;
+    size_t         span_len = (size_t)(f[unsigned_fields - 1].raw +
+                                       f[unsigned_fields - 1].size - span);
+
+    h = web3c_rlp_put_length(h, span_len + (size_t)(t - tail), 0xC0);
+
+    web3c_keccak256_init(&ctx);
+    web3c_keccak_update(&ctx, head, (size_t)(h - head));
+    web3c_keccak_update(&ctx, span, span_len);
+    web3c_keccak_update(&ctx, tail, (size_t)(t - tail));
+    web3c_keccak_final(&ctx, hash);
+
     return 0;
-}
\ No newline at end of file
+}
+
+int web3c_recover_senders(const web3c_secp256k1_ctx *ctx,
+                          const uint8_t *const *raw_txs,
+                          const size_t *lens,
+                          size_t n,
+                          uint8_t (*senders)[20],
+                          int *status)
+{
+    uint8_t  hashes[TX_RECOVER_BLOCK][32];
+    uint8_t  sigs[TX_RECOVER_BLOCK][64];
+    unsigned recids[TX_RECOVER_BLOCK];
+    int      st[TX_RECOVER_BLOCK];
+    int      failed = 0;
+
+    if (n == 0) {
+        return 0;
+    }
+    if (ctx == NULL || raw_txs == NULL || lens == NULL || senders == NULL) {
+        return -1;
+    }
+
+    for (size_t base = 0; base < n; base += TX_RECOVER_BLOCK) {
+        size_t count = n - base < TX_RECOVER_BLOCK ? n - base : TX_RECOVER_BLOCK;
+
+        /* Malformed transactions get an invalid recovery id. */
+        for (size_t i = 0; i < count; ++i) {
+            if (tx_parse_signed(raw_txs[base + i], lens[base + i],
+                                hashes[i], sigs[i], &recids[i]) != 0) {
+                memset(sigs[i], 0, sizeof(sigs[i]));
+                recids[i] = 4;
+            }
+        }
+
+        if (web3c_secp256k1_recover_batch(ctx, (const uint8_t (*)[32])hashes,
+                                          (const uint8_t (*)[64])sigs, recids,
+                                          count, senders + base, st) != 0) {
+            failed = 1;
+        }
+        if (status) {
+            memcpy(status + base, st, count * sizeof(st[0]));
+        }
+    }
+
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "web3c/web3c.h"
+
+/* Test vectors from EIP-55. */
+static const char *const eip55_vectors[] = {
+    /* All caps */
+    "0x52908400098527886E0F7030069857D2E4169EE7",
+    "0x8617E340B3D01FA5F11F306F4090FD50E238070D",
+    /* All lower */
+    "0xde709f2102306220921060314715629080e2fb77",
+    "0x27b1fdb04752bbc536007a920d24acb045561c26",
+    /* Normal */
+    "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed",
+    "0xfB6916095ca1df60bB79Ce92cE3Ea74c37c5d359",
+    "0xdbF03B407c01E7cD3CBea99509d93f8DDDC8C6FB",
+    "0xD1220A0cf47c7B9Be7A2E6BA89F429762e7b9aDb",
+};
+
+#define N_VECTORS (sizeof(eip55_vectors) / sizeof(eip55_vectors[0]))
+
+static void test_to_checksum(void) {
+    uint8_t addr[20];
+    char    out[WEB3C_ADDRESS_CHECKSUM_SIZE];
+
+    for (size_t i = 0; i < N_VECTORS; ++i) {
+        assert(web3c_hex_decode_n(eip55_vectors[i], 42, addr, 20, NULL) == 20);
+        assert(web3c_address_to_checksum(addr, out) == 0);
+        assert(strcmp(out, eip55_vectors[i]) == 0);
+    }
+
+    assert(web3c_address_to_checksum(NULL, out) != 0);
+}
+
+static void test_validate(void) {
+    uint8_t addr[20];
+    uint8_t expected[20];
+    char    buf[WEB3C_ADDRESS_CHECKSUM_SIZE];
+
+    for (size_t i = 0; i < N_VECTORS; ++i) {
+        const char *v = eip55_vectors[i];
+
+        assert(web3c_address_validate_checksum(v, 42, addr) == 0);
+        assert(web3c_hex_decode_n(v, 42, expected, 20, NULL) == 20);
+        assert(memcmp(addr, expected, 20) == 0);
+
+        /* Without the prefix. */
+        assert(web3c_address_validate_checksum(v + 2, 40, NULL) == 0);
+
+        /* Flipping the case of any letter breaks the checksum. */
+        for (size_t k = 2; k < 42; ++k) {
+            if (v[k] < 'A') {
+                continue;
+            }
+            memcpy(buf, v, sizeof(buf));
+            buf[k] ^= 0x20;
+            assert(web3c_address_validate_checksum(buf, 42, NULL) != 0);
+        }
+    }
+
+    /* Malformed input. */
+    assert(web3c_address_validate_checksum(eip55_vectors[4], 41, NULL) != 0);
+    assert(web3c_address_validate_checksum("1x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed",
+                                           42, NULL) != 0);
+    assert(web3c_address_validate_checksum("0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAeg",
+                                           42, NULL) != 0);
+    assert(web3c_address_validate_checksum(NULL, 42, NULL) != 0);
+}
+
+static void test_batch(void) {
+    enum { N = 200 };
+    static uint8_t addrs[N][20];
+    static char    outs[N][WEB3C_ADDRESS_CHECKSUM_SIZE];
+    char one[WEB3C_ADDRESS_CHECKSUM_SIZE];
+
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t k = 0; k < 20; ++k) {
+            addrs[i][k] = (uint8_t)(i * 37 + k * 101 + 13);
+        }
+    }
+
+    assert(web3c_address_to_checksum_batch((const uint8_t (*)[20])addrs, N, outs) == 0);
+    for (size_t i = 0; i < N; ++i) {
+        assert(web3c_address_to_checksum(addrs[i], one) == 0);
+        assert(strcmp(outs[i], one) == 0);
+        assert(web3c_address_validate_checksum(outs[i], 42, NULL) == 0);
+    }
+
+    assert(web3c_address_to_checksum_batch(NULL, 0, NULL) == 0);
+    assert(web3c_address_to_checksum_batch(NULL, 1, outs) != 0);
+}
+
+int main(void) {
+    printf("Running Web3C address tests...\n");
+
+    test_to_checksum();
+    test_validate();
+    test_batch();
+
+    printf("All address tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "web3c/web3c.h"
+
+static int popcount_bloom(const uint8_t bloom[WEB3C_BLOOM_SIZE]) {
+    int n = 0;
+
+    for (size_t i = 0; i < WEB3C_BLOOM_SIZE; ++i) {
+        for (uint8_t b = bloom[i]; b; b &= (uint8_t)(b - 1)) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+static void test_bits(void) {
+    uint8_t address[20];
+    uint8_t topic[1][32];
+    uint8_t zero_topic[32];
+    uint8_t bloom[WEB3C_BLOOM_SIZE];
+
+    assert(web3c_hex_decode("22341ae42d6dd7384bc8584e50419ea3ac75b83f",
+                            address, 20) == 20);
+    assert(web3c_hex_decode("04491edcd115127caedbd478e2e7895e"
+                            "d80c7847e903431f94f9cfa579cad47f",
+                            topic[0], 32) == 32);
+
+    /* Address bits: bytes 213, 168, 230. */
+    memset(bloom, 0, sizeof(bloom));
+    assert(web3c_bloom_add(bloom, address, 20) == 0);
+    assert(bloom[213] == 0x10);
+    assert(bloom[168] == 0x40);
+    assert(bloom[230] == 0x04);
+    assert(popcount_bloom(bloom) == 3);
+
+    /* Log = address + topic; the topic sets two bits in byte 9. */
+    memset(bloom, 0, sizeof(bloom));
+    assert(web3c_bloom_add_log(bloom, address, (const uint8_t (*)[32])topic, 1) == 0);
+    assert(bloom[9] == 0x81);
+    assert(bloom[109] == 0x02);
+    assert(popcount_bloom(bloom) == 6);
+
+    assert(web3c_bloom_contains(bloom, address, 20) == 1);
+    assert(web3c_bloom_contains(bloom, topic[0], 32) == 1);
+
+    memset(zero_topic, 0, sizeof(zero_topic));
+    assert(web3c_bloom_contains(bloom, zero_topic, 32) == 0);
+
+    assert(web3c_bloom_add(NULL, address, 20) != 0);
+    assert(web3c_bloom_add_log(bloom, address, NULL, 1) != 0);
+}
+
+static void test_or_match(void) {
+    uint8_t a[WEB3C_BLOOM_SIZE];
+    uint8_t b[WEB3C_BLOOM_SIZE];
+    uint8_t mask[WEB3C_BLOOM_SIZE];
+    uint8_t item_a[20];
+    uint8_t item_b[20];
+
+    memset(item_a, 0xAA, sizeof(item_a));
+    memset(item_b, 0xBB, sizeof(item_b));
+    memset(a, 0, sizeof(a));
+    memset(b, 0, sizeof(b));
+    assert(web3c_bloom_add(a, item_a, 20) == 0);
+    assert(web3c_bloom_add(b, item_b, 20) == 0);
+
+    /* A mask requiring both items matches only the union. */
+    memset(mask, 0, sizeof(mask));
+    assert(web3c_bloom_add(mask, item_a, 20) == 0);
+    assert(web3c_bloom_add(mask, item_b, 20) == 0);
+    assert(web3c_bloom_match(a, mask) == 0);
+
+    web3c_bloom_or(a, b);
+    assert(web3c_bloom_match(a, mask) == 1);
+    assert(web3c_bloom_match(a, b) == 1);
+}
+
+/* Small deterministic PRNG for the scan test. */
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void test_scan(void) {
+    enum { ROWS = 1000, MASKS = 9, ITEMS = 24 };
+    static uint8_t  buf[ROWS * WEB3C_BLOOM_SIZE + 1];
+    static uint8_t  masks[MASKS][WEB3C_BLOOM_SIZE];
+    static uint64_t hits[MASKS * WEB3C_BLOOM_HITS_WORDS(ROWS)];
+    uint8_t items[ITEMS][32];
+    size_t  words = WEB3C_BLOOM_HITS_WORDS(ROWS);
+    size_t  n_hits = 0;
+    size_t  expected_hits = 0;
+
+    for (size_t i = 0; i < ITEMS; ++i) {
+        memset(items[i], (int)i, 32);
+    }
+
+    /* Rows start at an odd address, like records inside a mapped file. */
+    uint8_t *rows = buf + 1;
+    memset(buf, 0, sizeof(buf));
+    for (size_t r = 0; r < ROWS; ++r) {
+        size_t n = rng_next() % 6;
+        for (size_t k = 0; k < n; ++k) {
+            assert(web3c_bloom_add(rows + r * WEB3C_BLOOM_SIZE,
+                                   items[rng_next() % ITEMS], 32) == 0);
+        }
+    }
+
+    /* Single items, pairs, and the empty mask (matches every row). */
+    memset(masks, 0, sizeof(masks));
+    for (size_t m = 0; m + 1 < MASKS; ++m) {
+        assert(web3c_bloom_add(masks[m], items[m], 32) == 0);
+        if (m % 2) {
+            assert(web3c_bloom_add(masks[m], items[m + 8], 32) == 0);
+        }
+    }
+
+    memset(hits, 0xFF, sizeof(hits));
+    assert(web3c_bloom_scan(rows, ROWS, (const uint8_t (*)[WEB3C_BLOOM_SIZE])masks,
+                            MASKS, hits, &n_hits) == 0);
+
+    for (size_t m = 0; m < MASKS; ++m) {
+        for (size_t r = 0; r < ROWS; ++r) {
+            int want = web3c_bloom_match(rows + r * WEB3C_BLOOM_SIZE, masks[m]);
+            int got  = (int)((hits[m * words + r / 64] >> (r % 64)) & 1);
+            assert(want == got);
+            expected_hits += (size_t)want;
+        }
+        /* Bits past the last row stay clear. */
+        for (size_t r = ROWS; r < words * 64; ++r) {
+            assert(((hits[m * words + r / 64] >> (r % 64)) & 1) == 0);
+        }
+    }
+    assert(n_hits == expected_hits);
+    assert(n_hits >= ROWS); /* the empty mask alone */
+
+    assert(web3c_bloom_scan(NULL, 0, NULL, 0, NULL, &n_hits) == 0);
+    assert(n_hits == 0);
+    assert(web3c_bloom_scan(NULL, 1, (const uint8_t (*)[WEB3C_BLOOM_SIZE])masks,
+                            1, hits, NULL) != 0);
+}
+
+int main(void) {
+    printf("Running Web3C bloom tests...\n");
+
+    test_bits();
+    test_or_match();
+    test_scan();
+
+    printf("All bloom tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "web3c/web3c.h"
+
+static void hex_to_bytes(const char *hex, uint8_t *out, size_t len) {
+    int rc = web3c_hex_decode(hex, out, len);
+    assert(rc == (int)len);
+}
+
+static void test_create_address(void) {
+    /* Well-known CREATE addresses for sender 0x6ac7...dbf0. */
+    static const struct {
+        uint64_t    nonce;
+        const char *expected;
+    } vectors[] = {
+        { 0,       "cd234a471b72ba2f1ccf0a70fcaba648a5eecd8d" },
+        { 1,       "343c43a37d37dff08ae8c4a11544c718abb4fcf8" },
+        { 127,     "06d9a77f5e4b311bae8d559db9cdb4df94104aa0" },
+        { 128,     "08e190dcb7b73f5fcdabb43e102215c83659a76d" },
+        { 0x10000, "f666a819b370d38f44f2573464da3fba8479b917" },
+    };
+    uint8_t sender[20];
+    uint8_t addr[20];
+    uint8_t expected[20];
+    uint8_t range[200][20];
+
+    hex_to_bytes("6ac7ea33f8831ea9dcc53393aaa88b25a785dbf0", sender, 20);
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i) {
+        hex_to_bytes(vectors[i].expected, expected, 20);
+        assert(web3c_create_address(sender, vectors[i].nonce, addr) == 0);
+        assert(memcmp(addr, expected, 20) == 0);
+    }
+
+    /* Range helper agrees with the single-address helper. */
+    assert(web3c_create_address_range(sender, 0, 200, range) == 0);
+    for (uint64_t n = 0; n < 200; ++n) {
+        assert(web3c_create_address(sender, n, addr) == 0);
+        assert(memcmp(range[n], addr, 20) == 0);
+    }
+}
+
+static void test_create2_address(void) {
+    /* EIP-1014 examples 0, 1 and 5. */
+    uint8_t deployer[20];
+    uint8_t salt[32];
+    uint8_t code[4];
+    uint8_t code_hash[32];
+    uint8_t addr[20];
+    uint8_t expected[20];
+
+    memset(deployer, 0, sizeof(deployer));
+    memset(salt, 0, sizeof(salt));
+    code[0] = 0x00;
+    assert(web3c_keccak256(code, 1, code_hash) == 0);
+    assert(web3c_create2_address(deployer, salt, code_hash, addr) == 0);
+    hex_to_bytes("4d1a2e2bb4f88f0250f26ffff098b0b30b26bf38", expected, 20);
+    assert(memcmp(addr, expected, 20) == 0);
+
+    hex_to_bytes("deadbeef00000000000000000000000000000000", deployer, 20);
+    assert(web3c_create2_address(deployer, salt, code_hash, addr) == 0);
+    hex_to_bytes("b928f69bb1d91cd65274e3c79d8986362984fda3", expected, 20);
+    assert(memcmp(addr, expected, 20) == 0);
+
+    hex_to_bytes("00000000000000000000000000000000deadbeef", deployer, 20);
+    hex_to_bytes("00000000000000000000000000000000"
+                 "000000000000000000000000cafebabe", salt, 32);
+    hex_to_bytes("deadbeef", code, 4);
+    assert(web3c_keccak256(code, 4, code_hash) == 0);
+    assert(web3c_create2_address(deployer, salt, code_hash, addr) == 0);
+    hex_to_bytes("60f3f640a8508fc6a86d45df051962668e1e8ac7", expected, 20);
+    assert(memcmp(addr, expected, 20) == 0);
+}
+
+static void test_pattern(void) {
+    web3c_address_pattern p;
+    uint8_t addr[20];
+
+    hex_to_bytes("abc0000000000000000000000000000000000def", addr, 20);
+
+    assert(web3c_address_pattern_set(&p, "0xABc", "def") == 0);
+    assert(web3c_address_pattern_match(&p, addr) == 1);
+
+    assert(web3c_address_pattern_set(&p, "abd", NULL) == 0);
+    assert(web3c_address_pattern_match(&p, addr) == 0);
+
+    assert(web3c_address_pattern_set(&p, NULL, "ef") == 0);
+    assert(web3c_address_pattern_match(&p, addr) == 1);
+
+    /* Empty pattern matches anything. */
+    assert(web3c_address_pattern_set(&p, "", "") == 0);
+    assert(web3c_address_pattern_match(&p, addr) == 1);
+
+    assert(web3c_address_pattern_set(&p, "xyz", NULL) != 0);
+}
+
+static void test_search(void) {
+    web3c_create2_search s;
+    uint8_t addr[20];
+
+    web3c_create2_search_init(&s);
+    memset(s.deployer, 0x11, sizeof(s.deployer));
+    memset(s.init_code_hash, 0x22, sizeof(s.init_code_hash));
+    memset(s.salt_base, 0x33, sizeof(s.salt_base));
+    s.first   = 0;
+    s.count   = 1u << 20;
+    s.threads = 4;
+    s.chunk   = 256;
+
+    /* Two leading nibbles: about 1 in 256 salts match. */
+    assert(web3c_address_pattern_set(&s.pattern, "0x00", NULL) == 0);
+    assert(web3c_create2_search_run(&s) == 0);
+    assert(s.found == 1 && s.stopped == 0);
+    assert(s.address[0] == 0x00);
+
+    /* The reported salt reproduces the reported address. */
+    assert(web3c_create2_address(s.deployer, s.salt, s.init_code_hash, addr) == 0);
+    assert(memcmp(addr, s.address, 20) == 0);
+    assert(memcmp(s.salt, s.salt_base, 24) == 0);
+
+    uint64_t hashes = 0;
+    double   rate   = 0.0;
+    web3c_create2_search_progress(&s, &hashes, &rate);
+    assert(hashes > 0);
+
+    /* A second run after a match finds it again: nothing stale is left. */
+    assert(web3c_create2_search_run(&s) == 0);
+    assert(s.found == 1 && s.stopped == 0);
+    assert(web3c_create2_address(s.deployer, s.salt, s.init_code_hash, addr) == 0);
+    assert(addr[0] == 0x00);
+
+    /* Exhausted range without a match. */
+    s.count = 16;
+    assert(web3c_address_pattern_set(&s.pattern, "0123456789abcdef", NULL) == 0);
+    assert(web3c_create2_search_run(&s) == 0);
+    assert(s.found == 0 && s.stopped == 0);
+    web3c_create2_search_progress(&s, &hashes, NULL);
+    assert(hashes == 16);
+
+    /* A stop issued before run is honoured and reported as such. */
+    web3c_create2_search_stop(&s);
+    assert(web3c_create2_search_run(&s) == 0);
+    assert(s.found == 0 && s.stopped == 1);
+    web3c_create2_search_progress(&s, &hashes, NULL);
+    assert(hashes == 0);
+
+    /* It stays pending until reset. */
+    assert(web3c_create2_search_run(&s) == 0);
+    assert(s.stopped == 1);
+    web3c_create2_search_reset(&s);
+    assert(web3c_create2_search_run(&s) == 0);
+    assert(s.found == 0 && s.stopped == 0);
+}
+
+static void test_precompute(void) {
+    enum { N = 5000 };
+    static uint8_t salts[N][32];
+    static web3c_create2_entry table[N];
+    uint8_t deployer[20];
+    uint8_t code_hash[32];
+    uint8_t addr[20];
+
+    memset(deployer, 0x44, sizeof(deployer));
+    memset(code_hash, 0x55, sizeof(code_hash));
+    for (size_t i = 0; i < N; ++i) {
+        memset(salts[i], 0, 32);
+        salts[i][30] = (uint8_t)(i >> 8);
+        salts[i][31] = (uint8_t)i;
+    }
+
+    web3c_create2_progress progress;
+    uint64_t hashes = 0;
+    double   rate   = -1.0;
+
+    assert(web3c_create2_precompute(deployer, code_hash,
+                                    (const uint8_t (*)[32])salts, N, table, 3,
+                                    &progress) == 0);
+    web3c_create2_progress_read(&progress, &hashes, &rate);
+    assert(hashes == N);
+    assert(rate >= 0.0);
+
+    for (size_t i = 1; i < N; ++i) {
+        assert(memcmp(table[i - 1].address, table[i].address, 20) <= 0);
+    }
+
+    for (size_t i = 0; i < N; i += 97) {
+        assert(web3c_create2_address(deployer, salts[i], code_hash, addr) == 0);
+        const web3c_create2_entry *e = web3c_create2_lookup(table, N, addr);
+        assert(e != NULL);
+        assert(e->index == i);
+    }
+
+    memset(addr, 0xEE, sizeof(addr));
+    assert(web3c_create2_lookup(table, N, addr) == NULL);
+}
+
+int main(void) {
+    printf("Running Web3C CREATE/CREATE2 tests...\n");
+
+    test_create_address();
+    test_create2_address();
+    test_pattern();
+    test_search();
+    test_precompute();
+
+    printf("All CREATE/CREATE2 tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "web3c/web3c.h"
+
+/* Reference encoder: one byte at a time. */
+static void ref_encode(const uint8_t *in, size_t len, char *out) {
+    static const char digits[] = "0123456789abcdef";
+
+    for (size_t i = 0; i < len; ++i) {
+        out[2 * i]     = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0F];
+    }
+}
+
+static void test_encode_basic(void) {
+    const uint8_t in[] = { 0x00, 0x01, 0x7f, 0x80, 0xab, 0xff };
+    char out[16];
+
+    assert(web3c_hex_encode(in, sizeof(in), out, sizeof(out)) == 0);
+    assert(strcmp(out, "00017f80abff") == 0);
+
+    /* Needs room for the terminator. */
+    assert(web3c_hex_encode(in, sizeof(in), out, 12) != 0);
+    assert(web3c_hex_encode(NULL, 0, out, sizeof(out)) != 0);
+}
+
+static void test_encode_lengths(void) {
+    /* Every length up to 300 covers the vector bodies and scalar tails. */
+    enum { MAX = 300 };
+    static uint8_t in[MAX + 1];
+    static char    out[2 * MAX + 8];
+    static char    expected[2 * MAX + 8];
+
+    for (size_t i = 0; i <= MAX; ++i) {
+        in[i] = (uint8_t)(i * 73 + 11);
+    }
+
+    for (size_t off = 0; off < 2; ++off) {
+        for (size_t len = 0; len + off <= MAX; ++len) {
+            ref_encode(in + off, len, expected);
+
+            memset(out, 'X', sizeof(out));
+            assert(web3c_hex_encode(in + off, len, out + off, 2 * len + 1) == 0);
+            assert(memcmp(out + off, expected, 2 * len) == 0);
+            assert(out[off + 2 * len] == '\0');
+
+            /* Raw variant: same characters, nothing written past them. */
+            memset(out, 'X', sizeof(out));
+            assert(web3c_hex_encode_raw(in + off, len, out + off, 2 * len) == 0);
+            assert(memcmp(out + off, expected, 2 * len) == 0);
+            assert(out[off + 2 * len] == 'X');
+        }
+    }
+
+    assert(web3c_hex_encode_raw(in, 4, out, 7) != 0);
+    assert(web3c_hex_encode_raw(NULL, 0, out, 0) == 0);
+}
+
+static void test_decode_roundtrip(void) {
+    uint8_t in[64];
+    uint8_t back[64];
+    char    hex[129];
+
+    for (size_t i = 0; i < sizeof(in); ++i) {
+        in[i] = (uint8_t)(255 - i * 3);
+    }
+
+    assert(web3c_hex_encode(in, sizeof(in), hex, sizeof(hex)) == 0);
+    assert(web3c_hex_decode(hex, back, sizeof(back)) == (int)sizeof(back));
+    assert(memcmp(in, back, sizeof(in)) == 0);
+
+    assert(web3c_hex_decode("ABcd", back, sizeof(back)) == 2);
+    assert(back[0] == 0xab && back[1] == 0xcd);
+    assert(web3c_hex_decode("abc", back, sizeof(back)) == -1);
+    assert(web3c_hex_decode("zz", back, sizeof(back)) == -1);
+}
+
+static int ref_nibble(unsigned char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static void test_decode_n(void) {
+    enum { MAX = 160 };
+    static uint8_t in[MAX];
+    static char    hex[2 * MAX + 2];
+    static uint8_t out[MAX];
+    size_t err = 0;
+
+    for (size_t i = 0; i < MAX; ++i) {
+        in[i] = (uint8_t)(i * 151 + 29);
+    }
+
+    /* Optional prefix, mixed case, no terminator needed. */
+    assert(web3c_hex_decode_n("0xABcd01", 8, out, sizeof(out), &err) == 3);
+    assert(out[0] == 0xab && out[1] == 0xcd && out[2] == 0x01);
+    assert(web3c_hex_decode_n("0Xff", 4, out, sizeof(out), NULL) == 1);
+    assert(out[0] == 0xff);
+    assert(web3c_hex_decode_n("ffee", 2, out, sizeof(out), NULL) == 1);
+    assert(out[0] == 0xff);
+    assert(web3c_hex_decode_n("0x", 2, out, sizeof(out), NULL) == 0);
+    assert(web3c_hex_decode_n("", 0, NULL, 0, NULL) == 0);
+
+    /* Odd digit count: offset is the end of the input. */
+    assert(web3c_hex_decode_n("0xabc", 5, out, sizeof(out), &err) == -1);
+    assert(err == 5);
+
+    /* Output too small: offset of the first byte that does not fit. */
+    assert(web3c_hex_decode_n("0xaabbcc", 8, out, 2, &err) == -1);
+    assert(err == 6);
+
+    /* Invalid characters take precedence over length errors. */
+    assert(web3c_hex_decode_n("0xzz1", 5, out, sizeof(out), &err) == -1);
+    assert(err == 2);
+    assert(web3c_hex_decode_n("0xaabbcg", 8, out, 2, &err) == -1);
+    assert(err == 7);
+
+    /* Every length, with and without prefix, against the encoder. */
+    for (size_t len = 0; len <= MAX; ++len) {
+        for (size_t prefix = 0; prefix <= 2; prefix += 2) {
+            memcpy(hex, "0x", 2);
+            ref_encode(in, len, hex + prefix);
+            assert(web3c_hex_decode_n(hex, prefix + 2 * len, out, len, &err) == (int)len);
+            assert(memcmp(out, in, len) == 0);
+        }
+    }
+
+    /*
+     * Every byte value at every position of a long string: valid digits
+     * must decode, anything else must fail at exactly that offset.
+     */
+    for (size_t pos = 0; pos < 2 * MAX; pos += 7) {
+        for (int c = 1; c < 256; ++c) {
+            memcpy(hex, "0x", 2);
+            ref_encode(in, MAX, hex + 2);
+            hex[2 + pos] = (char)c;
+
+            int rc = web3c_hex_decode_n(hex, 2 + 2 * MAX, out, sizeof(out), &err);
+            if (ref_nibble((unsigned char)c) < 0) {
+                assert(rc == -1);
+                assert(err == 2 + pos);
+            } else {
+                assert(rc == MAX);
+                assert(((pos % 2 ? out[pos / 2] & 0x0F : out[pos / 2] >> 4))
+                       == ref_nibble((unsigned char)c));
+            }
+        }
+    }
+}
+
+typedef struct {
+    uint8_t *buf;
+    size_t   len;
+    size_t   cap;
+    size_t   calls;
+} sink_state;
+
+static int collect(void *user, const uint8_t *bytes, size_t len) {
+    sink_state *st = user;
+
+    assert(st->len + len <= st->cap);
+    memcpy(st->buf + st->len, bytes, len);
+    st->len += len;
+    st->calls++;
+    return 0;
+}
+
+static int refuse(void *user, const uint8_t *bytes, size_t len) {
+    (void)user;
+    (void)bytes;
+    (void)len;
+    return 1;
+}
+
+static void test_decode_stream(void) {
+    enum { MAX = 5000 };
+    static uint8_t in[MAX];
+    static char    hex[2 * MAX + 2];
+    static uint8_t out[MAX];
+    web3c_hex_decode_ctx ctx;
+
+    for (size_t i = 0; i < MAX; ++i) {
+        in[i] = (uint8_t)(i * 151 + 29);
+    }
+    memcpy(hex, "0X", 2);
+    ref_encode(in, MAX, hex + 2);
+
+    /* Every chunk size, including splits inside a byte and the prefix. */
+    for (size_t chunk = 1; chunk <= 67; ++chunk) {
+        for (size_t prefix = 0; prefix <= 2; prefix += 2) {
+            const char *p   = prefix ? hex : hex + 2;
+            size_t      len = prefix + 2 * 200;
+            size_t      o   = 0;
+
+            web3c_hex_decode_init(&ctx, WEB3C_HEX_DECODE_PREFIX);
+            for (size_t i = 0; i < len; i += chunk) {
+                size_t n    = len - i < chunk ? len - i : chunk;
+                size_t used = 0;
+                int    rc   = web3c_hex_decode_update(&ctx, p + i, n, out + o,
+                                                      sizeof(out) - o, &used);
+                assert(rc >= 0);
+                assert(used == n);
+                o += (size_t)rc;
+            }
+            assert(web3c_hex_decode_final(&ctx) == 0);
+            assert(o == 200);
+            assert(memcmp(out, in, 200) == 0);
+        }
+    }
+
+    /* Without the flag, "0x" is an invalid character. */
+    web3c_hex_decode_init(&ctx, 0);
+    assert(web3c_hex_decode_update(&ctx, "0", 1, out, sizeof(out), NULL) == 0);
+    assert(web3c_hex_decode_update(&ctx, "xab", 3, out, sizeof(out), NULL) == -1);
+    assert(ctx.err_offset == 1);
+    /* Errors are sticky. */
+    assert(web3c_hex_decode_update(&ctx, "ab", 2, out, sizeof(out), NULL) == -1);
+    assert(web3c_hex_decode_final(&ctx) == -1);
+
+    /* A leading "00" is data, not a prefix. */
+    web3c_hex_decode_init(&ctx, WEB3C_HEX_DECODE_PREFIX);
+    assert(web3c_hex_decode_update(&ctx, "00", 2, out, sizeof(out), NULL) == 1);
+    assert(out[0] == 0x00);
+    assert(web3c_hex_decode_final(&ctx) == 0);
+
+    /* Odd digit count: offset is the end of the input. */
+    web3c_hex_decode_init(&ctx, WEB3C_HEX_DECODE_PREFIX);
+    assert(web3c_hex_decode_update(&ctx, "0xab", 4, out, sizeof(out), NULL) == 1);
+    assert(web3c_hex_decode_update(&ctx, "c", 1, out, sizeof(out), NULL) == 0);
+    assert(web3c_hex_decode_final(&ctx) == -1);
+    assert(ctx.err_offset == 5);
+
+    /* Invalid character deep in a later chunk: stream offset. */
+    hex[2 + 1001] = 'g';
+    web3c_hex_decode_init(&ctx, WEB3C_HEX_DECODE_PREFIX);
+    assert(web3c_hex_decode_update(&ctx, hex, 501, out, sizeof(out), NULL) == 249);
+    assert(web3c_hex_decode_update(&ctx, hex + 501, 2 * MAX + 2 - 501,
+                                   out, sizeof(out), NULL) == -1);
+    assert(ctx.err_offset == 2 + 1001);
+    ref_encode(in, MAX, hex + 2);
+
+    /* Small output buffer: resume from *consumed. */
+    {
+        const char *p   = hex;
+        size_t      len = 2 * MAX + 2;
+        size_t      o   = 0;
+
+        web3c_hex_decode_init(&ctx, WEB3C_HEX_DECODE_PREFIX);
+        while (len > 0) {
+            size_t used = 0;
+            int    rc   = web3c_hex_decode_update(&ctx, p, len, out + o, 7, &used);
+            assert(rc >= 0 && rc <= 7);
+            assert(used > 0);
+            o   += (size_t)rc;
+            p   += used;
+            len -= used;
+        }
+        assert(web3c_hex_decode_final(&ctx) == 0);
+        assert(o == MAX);
+        assert(memcmp(out, in, MAX) == 0);
+    }
+
+    /* Sink: blocks in order, whole stream. */
+    {
+        static uint8_t got[MAX];
+        sink_state st = { got, 0, sizeof(got), 0 };
+
+        web3c_hex_decode_init(&ctx, WEB3C_HEX_DECODE_PREFIX);
+        assert(web3c_hex_decode_update_sink(&ctx, hex, 3, collect, &st) == 0);
+        assert(web3c_hex_decode_update_sink(&ctx, hex + 3, 2 * MAX - 1,
+                                            collect, &st) == 0);
+        assert(web3c_hex_decode_final(&ctx) == 0);
+        assert(st.len == MAX);
+        assert(st.calls >= 2);
+        assert(memcmp(got, in, MAX) == 0);
+
+        web3c_hex_decode_init(&ctx, 0);
+        assert(web3c_hex_decode_update_sink(&ctx, "abcd", 4, refuse, NULL) == -1);
+        assert(web3c_hex_decode_final(&ctx) == -1);
+    }
+}
+
+int main(void) {
+    printf("Running Web3C hex tests...\n");
+
+    test_encode_basic();
+    test_encode_lengths();
+    test_decode_roundtrip();
+    test_decode_n();
+    test_decode_stream();
+
+    printf("All hex tests passed.\n");
+    return 0;
+}
@@ -16,10 +16,33 @@ static void web3c_bytes_to_hex(const uint8_t *in, size_t len, char *out)
     out[2 * len] = '\0';
 }
 
-int main(void)
+/* Deterministic test message: byte i = i * 7 + 1. */
+static void fill_pattern(uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) {
+        buf[i] = (uint8_t)(i * 7 + 1);
+    }
+}
+
+static int check_digest(const char *what, const uint8_t digest[32],
+                        const char *expected)
+{
+    char hex[65];
+
+    web3c_bytes_to_hex(digest, 32, hex);
+
+    if (strcmp(hex, expected) != 0) {
+        fprintf(stderr,
+                "Keccak-256(%s) mismatch:\n  got:      %s\n  expected: %s\n",
+                what, hex, expected);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_empty(void)
 {
     uint8_t digest[32];
-    char    hex[65];
 
     /* Ethereum keccak256("") test vector:
      * c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470
@@ -32,15 +55,245 @@ int main(void)
         return 1;
     }
 
-    web3c_bytes_to_hex(digest, sizeof(digest), hex);
+    return check_digest("\"\"", digest, expected_empty);
+}
 
-    if (strcmp(hex, expected_empty) != 0) {
-        fprintf(stderr,
-                "Keccak-256(\"\") mismatch:\n  got:      %s\n  expected: %s\n",
-                hex, expected_empty);
+static int test_block_boundaries(void)
+{
+    static const struct {
+        size_t      len;
+        const char *expected;
+    } vectors[] = {
+        { 135,  "34bd7bed52ea092f88bc887256e7f06500ee814afa9a5566e22030af2ef1c5c0" },
+        { 136,  "2b31811a93dfc4bdc41b6aa7790e784b987c25a2c8a0e101cfa694552dc8ae39" },
+        { 137,  "a6103b089a404974c2b460048bfddd45108748fbdd9bad451f54d1fe95f8f284" },
+        { 272,  "415fd325cae3a2f957fea2770d710027317ced7e7266a59905102c14fdb9959a" },
+        { 1000, "5f6640d51e97fd85a8fab8981a24c2fcdd022cab5e529f6879475f1f048b6254" },
+    };
+    uint8_t msg[1000];
+    uint8_t digest[32];
+
+    fill_pattern(msg, sizeof(msg));
+
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); ++v) {
+        if (web3c_keccak256(msg, vectors[v].len, digest) != 0 ||
+            check_digest("pattern", digest, vectors[v].expected) != 0) {
+            fprintf(stderr, "  (one-shot, len = %zu)\n", vectors[v].len);
+            return 1;
+        }
+
+        /*
+         * Streaming must give the same digest for any chunking: byte by
+         * byte, odd sizes, and chunks larger than the 136-byte rate.
+         */
+        static const size_t chunks[] = { 1, 13, 150 };
+        for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); ++c) {
+            web3c_keccak_ctx ctx;
+            web3c_keccak256_init(&ctx);
+            for (size_t off = 0; off < vectors[v].len; off += chunks[c]) {
+                size_t left  = vectors[v].len - off;
+                size_t chunk = left < chunks[c] ? left : chunks[c];
+                web3c_keccak_update(&ctx, msg + off, chunk);
+            }
+            web3c_keccak_final(&ctx, digest);
+
+            if (check_digest("pattern", digest, vectors[v].expected) != 0) {
+                fprintf(stderr, "  (streaming, len = %zu, chunk = %zu)\n",
+                        vectors[v].len, chunks[c]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_batch(void)
+{
+    enum { N = 67 };
+    static uint8_t msg[1000];
+    const uint8_t *inputs[N];
+    size_t         lens[N];
+    uint8_t        outs[N][32];
+    uint8_t        expected[32];
+
+    fill_pattern(msg, sizeof(msg));
+
+    /* Mixed lengths so lanes finish and get refilled at different times. */
+    for (size_t i = 0; i < N; ++i) {
+        lens[i]   = (i * 97) % 700;
+        inputs[i] = lens[i] ? msg + (i % 31) : NULL;
+    }
+
+    if (web3c_keccak256_batch(inputs, lens, outs, N) != 0) {
+        fprintf(stderr, "web3c_keccak256_batch() returned error\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < N; ++i) {
+        web3c_keccak256(inputs[i], lens[i], expected);
+        if (memcmp(outs[i], expected, 32) != 0) {
+            fprintf(stderr, "batch digest %zu (len %zu) mismatch\n", i, lens[i]);
+            return 1;
+        }
+    }
+
+    /* Single-message and empty batches. */
+    if (web3c_keccak256_batch(inputs, lens, outs, 1) != 0 ||
+        web3c_keccak256_batch(NULL, NULL, NULL, 0) != 0) {
+        fprintf(stderr, "web3c_keccak256_batch() small batch failed\n");
+        return 1;
+    }
+
+    /* NULL input with a non-zero length is rejected. */
+    inputs[3] = NULL;
+    lens[3]   = 5;
+    if (web3c_keccak256_batch(inputs, lens, outs, N) == 0) {
+        fprintf(stderr, "web3c_keccak256_batch() accepted NULL input\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_clone_midstate(void)
+{
+    static const char prefix[] = "\x19" "Ethereum Signed Message:\n32";
+    uint8_t msg[200 + 32];
+    uint8_t expected[32];
+    uint8_t digest[32];
+    uint8_t midstate[WEB3C_KECCAK_MIDSTATE_SIZE];
+
+    fill_pattern(msg, sizeof(msg));
+
+    /* Short prefix (partial block) and long prefix (one full block + tail). */
+    static const size_t prefix_lens[] = { sizeof(prefix) - 1, 200 };
+    for (size_t p = 0; p < 2; ++p) {
+        size_t plen = prefix_lens[p];
+        web3c_keccak_ctx base;
+
+        if (p == 0) {
+            memcpy(msg, prefix, plen);
+        }
+
+        web3c_keccak256_init(&base);
+        web3c_keccak_update(&base, msg, plen);
+
+        if (web3c_keccak_export(&base, midstate) != 0) {
+            fprintf(stderr, "web3c_keccak_export() returned error\n");
+            return 1;
+        }
+
+        for (uint8_t k = 0; k < 3; ++k) {
+            web3c_keccak_ctx ctx;
+            uint8_t suffix[32];
+
+            memset(suffix, k, sizeof(suffix));
+            memcpy(msg + plen, suffix, sizeof(suffix));
+            web3c_keccak256(msg, plen + sizeof(suffix), expected);
+
+            web3c_keccak_clone(&ctx, &base);
+            web3c_keccak_update(&ctx, suffix, sizeof(suffix));
+            web3c_keccak_final(&ctx, digest);
+            if (memcmp(digest, expected, 32) != 0) {
+                fprintf(stderr, "clone digest mismatch (prefix %zu)\n", plen);
+                return 1;
+            }
+
+            if (web3c_keccak_import(&ctx, midstate) != 0) {
+                fprintf(stderr, "web3c_keccak_import() returned error\n");
+                return 1;
+            }
+            web3c_keccak_update(&ctx, suffix, sizeof(suffix));
+            web3c_keccak_final(&ctx, digest);
+            if (memcmp(digest, expected, 32) != 0) {
+                fprintf(stderr, "midstate digest mismatch (prefix %zu)\n", plen);
+                return 1;
+            }
+        }
+
+        /* A finalized context cannot be exported. */
+        web3c_keccak_final(&base, digest);
+        if (web3c_keccak_export(&base, midstate) == 0) {
+            fprintf(stderr, "web3c_keccak_export() accepted finalized ctx\n");
+            return 1;
+        }
+    }
+
+    /* Out-of-range block position is rejected. */
+    web3c_keccak_ctx ctx;
+    memset(midstate, 0, sizeof(midstate));
+    midstate[200] = 136;
+    if (web3c_keccak_import(&ctx, midstate) == 0) {
+        fprintf(stderr, "web3c_keccak_import() accepted bad position\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Contexts need only 8-byte alignment: place them 16 bytes off a cache
+ * line (all malloc guarantees) and copy them by value.
+ */
+static int test_ctx_alignment(void)
+{
+    static const char prefix[] = "shared prefix";
+    static unsigned char buf[64 * 8];
+    web3c_keccak_ctx *src = (web3c_keccak_ctx *)(void *)
+        (buf + ((64 - (uintptr_t)buf % 64) % 64) + 16);
+    web3c_keccak_ctx *dst = src + 1;
+    uint8_t expected[32], digest[32];
+    uint8_t msg[sizeof(prefix) - 1 + 3];
+
+    if (sizeof(web3c_keccak_ctx) != 208) {
+        fprintf(stderr, "web3c_keccak_ctx is %zu bytes\n", sizeof(web3c_keccak_ctx));
+        return 1;
+    }
+
+    memcpy(msg, prefix, sizeof(prefix) - 1);
+    memcpy(msg + sizeof(prefix) - 1, "abc", 3);
+    web3c_keccak256(msg, sizeof(msg), expected);
+
+    web3c_keccak256_init(src);
+    web3c_keccak_update(src, (const uint8_t *)prefix, sizeof(prefix) - 1);
+    *dst = *src;
+    web3c_keccak_update(dst, (const uint8_t *)"abc", 3);
+    web3c_keccak_final(dst, digest);
+    if (memcmp(digest, expected, 32) != 0) {
+        fprintf(stderr, "copied context digest mismatch\n");
+        return 1;
+    }
+
+    web3c_keccak_clone(dst, src);
+    web3c_keccak_update(dst, (const uint8_t *)"abc", 3);
+    web3c_keccak_final(dst, digest);
+    if (memcmp(digest, expected, 32) != 0) {
+        fprintf(stderr, "cloned context digest mismatch\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    if (test_empty() != 0) {
+        return 1;
+    }
+    if (test_block_boundaries() != 0) {
+        return 1;
+    }
+    if (test_batch() != 0) {
+        return 1;
+    }
+    if (test_clone_midstate() != 0) {
+        return 1;
+    }
+    if (test_ctx_alignment() != 0) {
         return 1;
     }
 
     printf("Keccak-256 test passed.\n");
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "web3c/web3c.h"
+
+/* Check that the cursor holds exactly `expected`. */
+static void expect(const web3c_rpc_buf *b, const char *expected) {
+    assert(b->len == strlen(expected));
+    assert(b->len <= b->size);
+    assert(memcmp(b->buf, expected, b->len) == 0);
+}
+
+static void test_quantity_u64(void) {
+    char buf[64];
+    web3c_rpc_buf b;
+
+    static const struct {
+        uint64_t    value;
+        const char *text;
+    } cases[] = {
+        { 0,                     "\"0x0\"" },
+        { 1,                     "\"0x1\"" },
+        { 0x0f,                  "\"0xf\"" },
+        { 0x10,                  "\"0x10\"" },
+        { 0x400,                 "\"0x400\"" },
+        { 21000,                 "\"0x5208\"" },
+        { 0x8000000000000000ull, "\"0x8000000000000000\"" },
+        { UINT64_MAX,            "\"0xffffffffffffffff\"" },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        web3c_rpc_buf_init(&b, buf, sizeof(buf));
+        assert(web3c_rpc_put_quantity_u64(&b, cases[i].value) == 0);
+        expect(&b, cases[i].text);
+        assert(web3c_rpc_quantity_u64_len(cases[i].value) == strlen(cases[i].text) - 2);
+    }
+}
+
+static void test_quantity_u256(void) {
+    char buf[80];
+    uint8_t word[32];
+    web3c_rpc_buf b;
+
+    memset(word, 0, sizeof(word));
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_quantity_u256(&b, word) == 0);
+    expect(&b, "\"0x0\"");
+
+    /* 1 ether = 0xde0b6b3a7640000 wei. */
+    assert(web3c_abi_encode_uint256(1000000000000000000ull, word) == 0);
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_quantity_u256(&b, word) == 0);
+    expect(&b, "\"0xde0b6b3a7640000\"");
+
+    /* High words: 0x1 followed by 24 zero bytes, and all ones. */
+    memset(word, 0, sizeof(word));
+    word[7] = 0x01;
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_quantity_u256(&b, word) == 0);
+    expect(&b, "\"0x1000000000000000000000000000000000000000000000000\"");
+    assert(web3c_rpc_quantity_u256_len(word) == 2 + 49);
+
+    memset(word, 0xff, sizeof(word));
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_quantity_u256(&b, word) == 0);
+    assert(b.len == 2 + 2 + 64);
+    assert(memcmp(buf + 3, "ffff", 4) == 0);
+
+    /* Every bit length agrees with the u64 formatter in the low word. */
+    for (unsigned bit = 0; bit < 64; ++bit) {
+        char ref[32];
+        web3c_rpc_buf r;
+        uint64_t v = (1ull << bit) | 1;
+
+        memset(word, 0, sizeof(word));
+        for (int k = 0; k < 8; ++k) {
+            word[31 - k] = (uint8_t)(v >> (8 * k));
+        }
+        web3c_rpc_buf_init(&b, buf, sizeof(buf));
+        web3c_rpc_buf_init(&r, ref, sizeof(ref));
+        assert(web3c_rpc_put_quantity_u256(&b, word) == 0);
+        assert(web3c_rpc_put_quantity_u64(&r, v) == 0);
+        assert(b.len == r.len);
+        assert(memcmp(buf, ref, b.len) == 0);
+    }
+}
+
+static void test_data(void) {
+    const uint8_t sel[] = { 0xa9, 0x05, 0x9c, 0xbb };
+    char buf[32];
+    web3c_rpc_buf b;
+
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_data(&b, sel, sizeof(sel)) == 0);
+    expect(&b, "\"0xa9059cbb\"");
+
+    /* Leading zero bytes are kept. */
+    const uint8_t zeros[] = { 0x00, 0x00, 0x01 };
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_data(&b, zeros, sizeof(zeros)) == 0);
+    expect(&b, "\"0x000001\"");
+
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_data(&b, NULL, 0) == 0);
+    expect(&b, "\"0x\"");
+    assert(web3c_rpc_put_data(&b, NULL, 1) != 0);
+}
+
+static void test_arrays(void) {
+    char buf[256];
+    web3c_rpc_buf b;
+
+    const uint64_t values[] = { 0, 255, 4096 };
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_quantity_u64_array(&b, values, 3) == 0);
+    expect(&b, "[\"0x0\",\"0xff\",\"0x1000\"]");
+
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_quantity_u64_array(&b, NULL, 0) == 0);
+    expect(&b, "[]");
+
+    uint8_t words[2][32];
+    memset(words, 0, sizeof(words));
+    words[1][31] = 0x2a;
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_quantity_u256_array(&b, (const uint8_t (*)[32])words, 2) == 0);
+    expect(&b, "[\"0x0\",\"0x2a\"]");
+
+    const uint8_t a[] = { 0x12, 0x34 };
+    const uint8_t *items[] = { a, NULL, a };
+    const size_t   lens[]  = { 2, 0, 1 };
+    web3c_rpc_buf_init(&b, buf, sizeof(buf));
+    assert(web3c_rpc_put_data_array(&b, items, lens, 3) == 0);
+    expect(&b, "[\"0x1234\",\"0x\",\"0x12\"]");
+}
+
+static void test_request_body(void) {
+    static const char expected[] =
+        "{\"jsonrpc\":\"2.0\",\"id\":7,\"method\":\"eth_getBalance\","
+        "\"params\":[\"0x00000000000000000000000000000000deadbeef\",\"0x10d4f\"]}";
+    uint8_t addr[20];
+    char buf[sizeof(expected)];
+    web3c_rpc_buf b;
+
+    memset(addr, 0, sizeof(addr));
+    addr[16] = 0xde;
+    addr[17] = 0xad;
+    addr[18] = 0xbe;
+    addr[19] = 0xef;
+
+    /* Sizing pass, then the real one into an exactly sized buffer. */
+    for (int pass = 0; pass < 2; ++pass) {
+        web3c_rpc_buf_init(&b, pass ? buf : NULL, pass ? sizeof(expected) - 1 : 0);
+        web3c_rpc_put_raw(&b, "{\"jsonrpc\":\"2.0\",\"id\":7,\"method\":\"eth_getBalance\","
+                              "\"params\":[", 60);
+        web3c_rpc_put_data(&b, addr, sizeof(addr));
+        web3c_rpc_put_raw(&b, ",", 1);
+        web3c_rpc_put_quantity_u64(&b, 68943);
+        web3c_rpc_put_raw(&b, "]}", 2);
+        assert(b.len == sizeof(expected) - 1);
+    }
+    assert(memcmp(buf, expected, b.len) == 0);
+
+    /* Too small: writes fail, len still reports the size needed. */
+    memset(buf, 'z', sizeof(buf));
+    web3c_rpc_buf_init(&b, buf, 5);
+    assert(web3c_rpc_put_quantity_u64(&b, 0x1234) != 0);
+    assert(b.len == 8);
+    assert(web3c_rpc_put_raw(&b, "]", 1) != 0);
+    assert(b.len == 9);
+    assert(buf[0] == 'z');
+}
+
+int main(void) {
+    printf("Running Web3C rpc tests...\n");
+
+    test_quantity_u64();
+    test_quantity_u256();
+    test_data();
+    test_arrays();
+    test_request_body();
+
+    printf("All rpc tests passed.\n");
+    return 0;
+}
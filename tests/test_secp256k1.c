@@ -0,0 +1,402 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "web3c/web3c.h"
+
+/* About 64 KiB: static rather than on the stack. */
+static web3c_secp256k1_ctx ctx;
+
+static void unhex(const char *hex, uint8_t *out, size_t out_size) {
+    size_t len = strlen(hex);
+
+    assert(len == 2 * out_size);
+    assert(web3c_hex_decode_n(hex, len, out, out_size, NULL) == (int)out_size);
+}
+
+static void test_secp256k1_seckey_verify(void) {
+    uint8_t key[32];
+
+    memset(key, 0, sizeof(key));
+    assert(web3c_secp256k1_seckey_verify(key) != 0);
+    key[31] = 1;
+    assert(web3c_secp256k1_seckey_verify(key) == 0);
+
+    /* n - 1 is valid, n is not. */
+    unhex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140", key, 32);
+    assert(web3c_secp256k1_seckey_verify(key) == 0);
+    key[31] = 0x41;
+    assert(web3c_secp256k1_seckey_verify(key) != 0);
+    memset(key, 0xff, sizeof(key));
+    assert(web3c_secp256k1_seckey_verify(key) != 0);
+    assert(web3c_secp256k1_seckey_verify(NULL) != 0);
+}
+
+static void test_secp256k1_pubkey(void) {
+    static const struct {
+        const char *key;
+        const char *pub;
+    } vectors[] = {
+        { "0000000000000000000000000000000000000000000000000000000000000001",
+          "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+          "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8" },
+        { "0000000000000000000000000000000000000000000000000000000000000002",
+          "c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5"
+          "1ae168fea63dc339a3c58419466ceaeef7f632653266d0e1236431a950cfe52a" },
+        /* n - 1: -G, every window digit non-zero except a few. */
+        { "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+          "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+          "b7c52588d95c3b9aa25b0403f1eef75702e84bb7597aabe663b82f6f04ef2777" },
+    };
+    uint8_t key[32], pub[64], expected[64], addr[20], want[20];
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i) {
+        unhex(vectors[i].key, key, 32);
+        unhex(vectors[i].pub, expected, 64);
+        assert(web3c_secp256k1_pubkey(&ctx, key, pub) == 0);
+        assert(memcmp(pub, expected, 64) == 0);
+    }
+
+    /* The EIP-155 example key. */
+    memset(key, 0x46, sizeof(key));
+    unhex("9d8a62f656a8d1615c1294fd71e9cfb3e4855a4f", want, 20);
+    assert(web3c_secp256k1_address(&ctx, key, addr) == 0);
+    assert(memcmp(addr, want, 20) == 0);
+
+    memset(key, 0, sizeof(key));
+    assert(web3c_secp256k1_pubkey(&ctx, key, pub) != 0);
+    assert(web3c_secp256k1_address(&ctx, key, addr) != 0);
+}
+
+/* Vectors from an independent Python implementation (RFC 6979, low s). */
+static void test_secp256k1_sign(void) {
+    static const struct {
+        const char *key;
+        const char *hash;
+        const char *r;
+        const char *s;
+        unsigned    recid;
+    } vectors[] = {
+        { "0000000000000000000000000000000000000000000000000000000000000001",
+          "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+          "7cb38cc5712e9e11a767615f6080dbc111c9cdd613eb98999fd92a86bafd4540",
+          "7923ca1f4d03471d2866f776ef8a6d3cac099b427331aeb245aa9dafeddcf115", 0 },
+        { "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+          "0000000000000000000000000000000000000000000000000000000000000000",
+          "919026f3e239ea52cf530eb6d345dc2b56ef0928f1e9ad20d8f360284dc65048",
+          "14395e7137e2204f15b69239010f3c34fbb3c858a29b0d106b1fa65bc0047263", 0 },
+        { "4646464646464646464646464646464646464646464646464646464646464646",
+          "9e30691c238642ea126a1e48cc11d357c30d8b7628dbd25e63b229f1c4069545",
+          "2ef5dc2c28b08f7bc9572abae6772a36c47dcd8e2308bc9e37637fefa304fcf8",
+          "345a6570c5c7d12167123e6b7aaf9a0aebcbc2710ade44916145482c387de90b", 0 },
+        { "d76d4330f1446beab0c11fdecb91ce375bc8fbbcbde5c0994164d8399f767c45",
+          "015c33b2df1461aaf8eb18b90074513021da8978206f5c6671e0c07e9e115e4b",
+          "fada3cbc711b4b70c4f29b072340677d15b48174746af6762c55668da901a848",
+          "482252953832e4db20ecc65653025261550f68a50d08daf57a936e6ea5128fcb", 1 },
+        { "c6a5387777330bdbd7210dff076ce2ef87b0b125ec1d7da0a6eb8c9ebd69fe29",
+          "2a9eba0cdf561d802a759159fb7ff337f5cae3bf3729c619c60a3cab359eeefb",
+          "0e4d77d33c5a1f472045c5db45d348375cc1a0fbaad14b46e9641f5cdde22394",
+          "7c0d7420028001c1ac051583b4d0ece6b8289e9ac07cd2cedb5e4c40425f533c", 0 },
+        { "5f2dd97f1cfb10f62827688de6a16a3b0d464138a62332553fc1ea36f17fd374",
+          "a02fdaa1ad864c44e049548e8a0a8c9632ea6928f6236bf2504b74ba4a0fe75d",
+          "f653f76776d68230147b2dc0941c54a8d2e665e7b87a728b825e81ce5fbefc84",
+          "2c55b943c368e8ebe5ca73f0921f88eafa74151956b953c70834b3e3defb1e87", 1 },
+        { "3fd4235992edcf451a1afe878b33e968617959ce3f1f65a8de5271007814e8a2",
+          "f7108e96f770c2263266aa3bb0cde917f7f35634f0e3cd972e81d66d346c6e2b",
+          "999de325a71d11668cd46b228ebbf1c47f42782ac67d0ba56d803d5fab67379c",
+          "6da4ae30b2c5bb931f9f2919f881d48fb5a3d6d153863c403d1217f9c2ccb2b6", 1 },
+        { "de11cc9dea959c212e9c82b1478c281d687c966c377b9aa2bb2edb20035b7399",
+          "ef901b932a7c18806a3753915c76f18a0585a01c4c7d6df0621aef57e4cc4132",
+          "04a558a6720653f92bada8f07bb8f0a4ec0bee0c0cfc2fa81ea481e8866397f6",
+          "0c8ba0e77c39b3510efad5dda205f44e07f7437803b2cc2c61fbad8a2dbb19fa", 1 },
+    };
+    uint8_t key[32], hash[32], r[32], s[32], want_r[32], want_s[32];
+    unsigned recid = 9;
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i) {
+        unhex(vectors[i].key, key, 32);
+        unhex(vectors[i].hash, hash, 32);
+        unhex(vectors[i].r, want_r, 32);
+        unhex(vectors[i].s, want_s, 32);
+
+        assert(web3c_secp256k1_sign(&ctx, hash, key, r, s, &recid) == 0);
+        assert(memcmp(r, want_r, 32) == 0);
+        assert(memcmp(s, want_s, 32) == 0);
+        assert(recid == vectors[i].recid);
+        /* Low s: top bit clear. */
+        assert((s[0] & 0x80) == 0);
+    }
+
+    memset(key, 0, sizeof(key));
+    assert(web3c_secp256k1_sign(&ctx, hash, key, r, s, &recid) != 0);
+    assert(web3c_secp256k1_sign(NULL, hash, key, r, s, &recid) != 0);
+}
+
+/* The signed example transaction from EIP-155. */
+static void test_secp256k1_tx_legacy(void) {
+    static const char signed_hex[] =
+        "f86c098504a817c800825208943535353535353535353535353535353535353535880d"
+        "e0b6b3a76400008025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1"
+        "590620aa636276a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1"
+        "966a3b6d83";
+    uint8_t expected[110], buf[256], hash[32], want[32], key[32], to[20];
+    size_t size = 0, len = 0;
+    web3c_tx_legacy tx;
+
+    memset(key, 0x46, sizeof(key));
+    memset(to, 0x35, sizeof(to));
+    web3c_tx_legacy_init(&tx);
+    tx.nonce     = 9;
+    tx.gas_price = 20000000000ull;
+    tx.gas_limit = 21000;
+    tx.value     = 1000000000000000000ull;
+    tx.chain_id  = 1;
+    assert(web3c_tx_legacy_set_to(&tx, to) == 0);
+
+    unhex("daf5a779ae972f972197303d7b574746c7ef83eadac0f2791ad23db92e4c8e53", want, 32);
+    assert(web3c_tx_legacy_signing_hash(&tx, hash) == 0);
+    assert(memcmp(hash, want, 32) == 0);
+
+    unhex(signed_hex, expected, sizeof(expected));
+    assert(web3c_tx_legacy_sign(&ctx, &tx, key, buf, sizeof(buf), &len) == 0);
+    assert(len == sizeof(expected));
+    assert(memcmp(buf, expected, len) == 0);
+
+    /* v = 37, r and s as in the EIP. */
+    web3c_rlp_item list, field;
+    uint64_t v = 0;
+    assert(web3c_rlp_decode(buf, len, &list) == 0);
+    assert(web3c_rlp_list_get(&list, 6, &field) == 0);
+    assert(web3c_rlp_item_uint64(&field, &v) == 0 && v == 37);
+    assert(web3c_rlp_list_get(&list, 7, &field) == 0);
+    assert(web3c_tx_legacy_signed_rlp_size(&tx, 37, field.data, expected + len - 32,
+                                           &size) == 0);
+    assert(size == len);
+
+    assert(web3c_tx_legacy_sign(&ctx, &tx, key, buf, len - 1, &len) != 0);
+    tx.chain_id = UINT64_MAX / 2;
+    assert(web3c_tx_legacy_sign(&ctx, &tx, key, buf, sizeof(buf), &len) != 0);
+}
+
+/* Type-2 signing reproduces the independently computed signed envelope. */
+static void test_secp256k1_tx_1559(void) {
+    static const char signed_hex[] =
+        "02f8730107847735940085174876e8008252089435353535353535353535353535353535"
+        "353535358814d1120d7b16000080c001a0ea70b93b2f912190a1ee3a09ddff79f401ee5c"
+        "2e44fbd42d9211df59e96dca4ba041ef5605132c1cf0155a06e515d03ba6f3cfccaeed39"
+        "112d51a39f66a9986665";
+    uint8_t expected[118], buf[256], key[32], to[20];
+    size_t len = 0;
+    web3c_tx_1559 tx;
+
+    memset(key, 0x46, sizeof(key));
+    memset(to, 0x35, sizeof(to));
+    web3c_tx_1559_init(&tx);
+    tx.chain_id                 = 1;
+    tx.nonce                    = 7;
+    tx.max_priority_fee_per_gas = 2000000000ull;
+    tx.max_fee_per_gas          = 100000000000ull;
+    tx.gas_limit                = 21000;
+    assert(web3c_tx_1559_set_to(&tx, to) == 0);
+    unhex("14d1120d7b160000", tx.value + 24, 8);
+
+    unhex(signed_hex, expected, sizeof(expected));
+    assert(web3c_tx_1559_sign(&ctx, &tx, key, buf, sizeof(buf), &len) == 0);
+    assert(len == sizeof(expected));
+    assert(memcmp(buf, expected, len) == 0);
+}
+
+/* Recovery returns the signer's key for every signing vector. */
+static void test_secp256k1_recover(void) {
+    uint8_t key[32], hash[32], r[32], s[32], pub[64], want[64];
+    unsigned recid = 0;
+
+    for (int i = 1; i <= 8; ++i) {
+        memset(key, 0x11 * i, sizeof(key));
+        memset(hash, 0x5a ^ i, sizeof(hash));
+        assert(web3c_secp256k1_sign(&ctx, hash, key, r, s, &recid) == 0);
+        assert(web3c_secp256k1_pubkey(&ctx, key, want) == 0);
+        assert(web3c_secp256k1_recover(&ctx, hash, r, s, recid, pub) == 0);
+        assert(memcmp(pub, want, 64) == 0);
+
+        /* The other parity gives a different key. */
+        assert(web3c_secp256k1_recover(&ctx, hash, r, s, recid ^ 1, pub) == 0);
+        assert(memcmp(pub, want, 64) != 0);
+    }
+
+    /* Out-of-range recid; recid 2 needs r + n < p. */
+    assert(web3c_secp256k1_recover(&ctx, hash, r, s, 4, pub) != 0);
+    assert(web3c_secp256k1_recover(&ctx, hash, r, s, 2, pub) != 0);
+
+    /* r = 5: x^3 + 7 has no square root, so there is no R. */
+    memset(r, 0, sizeof(r));
+    r[31] = 5;
+    assert(web3c_secp256k1_recover(&ctx, hash, r, s, 0, pub) != 0);
+
+    /* r = 0, s = 0, s = n. */
+    r[31] = 0;
+    assert(web3c_secp256k1_recover(&ctx, hash, r, s, 0, pub) != 0);
+    r[31] = 1;
+    memset(s, 0, sizeof(s));
+    assert(web3c_secp256k1_recover(&ctx, hash, r, s, 0, pub) != 0);
+    unhex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", s, 32);
+    assert(web3c_secp256k1_recover(&ctx, hash, r, s, 0, pub) != 0);
+    assert(web3c_secp256k1_recover(NULL, hash, r, s, 0, pub) != 0);
+}
+
+/* Batches span several internal blocks and tolerate bad entries. */
+static void test_secp256k1_recover_batch(void) {
+    enum { N = 40 };
+    static uint8_t hashes[N][32], sigs[N][64], addrs[N][20], want[N][20];
+    unsigned recids[N];
+    int      status[N];
+    uint8_t  key[32];
+
+    for (int i = 0; i < N; ++i) {
+        memset(key, 0, sizeof(key));
+        key[0]  = (uint8_t)(i + 1);
+        key[31] = (uint8_t)(3 * i + 7);
+        memset(hashes[i], i, 32);
+        assert(web3c_secp256k1_sign(&ctx, hashes[i], key, sigs[i], sigs[i] + 32,
+                                    &recids[i]) == 0);
+        assert(web3c_secp256k1_address(&ctx, key, want[i]) == 0);
+    }
+
+    assert(web3c_secp256k1_recover_batch(&ctx, (const uint8_t (*)[32])hashes,
+                                         (const uint8_t (*)[64])sigs, recids, N,
+                                         addrs, status) == 0);
+    for (int i = 0; i < N; ++i) {
+        assert(status[i] == 0);
+        assert(memcmp(addrs[i], want[i], 20) == 0);
+    }
+
+    /* Invalid entries in two blocks: the rest are unaffected. */
+    memset(sigs[7], 0, 32);
+    recids[23] = 5;
+    assert(web3c_secp256k1_recover_batch(&ctx, (const uint8_t (*)[32])hashes,
+                                         (const uint8_t (*)[64])sigs, recids, N,
+                                         addrs, status) != 0);
+    for (int i = 0; i < N; ++i) {
+        static const uint8_t zero[20];
+
+        if (i == 7 || i == 23) {
+            assert(status[i] != 0);
+            assert(memcmp(addrs[i], zero, 20) == 0);
+        } else {
+            assert(status[i] == 0);
+            assert(memcmp(addrs[i], want[i], 20) == 0);
+        }
+    }
+
+    /* A single entry, and no status array. */
+    assert(web3c_secp256k1_recover_batch(&ctx, (const uint8_t (*)[32])hashes,
+                                         (const uint8_t (*)[64])sigs, recids, 1,
+                                         addrs, NULL) == 0);
+    assert(memcmp(addrs[0], want[0], 20) == 0);
+    assert(web3c_secp256k1_recover_batch(&ctx, NULL, (const uint8_t (*)[64])sigs,
+                                         recids, 1, addrs, NULL) != 0);
+}
+
+static void test_recover_senders(void) {
+    static const struct {
+        const char *raw;
+        const char *sender;
+    } vectors[] = {
+        /* Mainnet 0x5c504ed4...2060, the first transfer (v = 28). */
+        { "f86780862d79883d2000825208945df9b87991262f6ba471f09758cde1c0fc1de734"
+          "827a69801ca088ff6cf0fefd94db46111149ae4bfc179e9b94721fffd821d38d16464b"
+          "3f71d0a045e0aff800961cfce805daef7016b9b675c137a6a41a548f7b60a3484c06a33a",
+          "a1e4380a3b1f749673e270229993ee55f35663b4" },
+        /* EIP-155 example, chainId 1 (v = 37). */
+        { "f86c098504a817c800825208943535353535353535353535353535353535353535880d"
+          "e0b6b3a76400008025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1"
+          "590620aa636276a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1"
+          "966a3b6d83",
+          "9d8a62f656a8d1615c1294fd71e9cfb3e4855a4f" },
+        /* EIP-2930 with an access list, signed independently. */
+        { "01f8a501038506fc23ac0082c35094353535353535353535353535353535353535353582"
+          "303984a9059cbbf838f7941111111111111111111111111111111111111111e1a00000"
+          "00000000000000000000000000000000000000000000000000000000000780a0bb50e2"
+          "d89a4ed70663d080659fe0ad4b9bc3e06c17a227433966cb59ceee020da052d4ca9b4d"
+          "4b9912eddcd96b9f2856563d0d43e2d00b69d8b47415f656efde62",
+          "9d8a62f656a8d1615c1294fd71e9cfb3e4855a4f" },
+        /* EIP-1559, from test_secp256k1_tx_1559. */
+        { "02f8730107847735940085174876e8008252089435353535353535353535353535353535"
+          "353535358814d1120d7b16000080c001a0ea70b93b2f912190a1ee3a09ddff79f401ee5c"
+          "2e44fbd42d9211df59e96dca4ba041ef5605132c1cf0155a06e515d03ba6f3cfccaeed39"
+          "112d51a39f66a9986665",
+          "9d8a62f656a8d1615c1294fd71e9cfb3e4855a4f" },
+    };
+    enum { V = sizeof(vectors) / sizeof(vectors[0]), N = V + 3 };
+    static uint8_t bufs[N][256];
+    const uint8_t *raw[N];
+    size_t         lens[N];
+    uint8_t        senders[N][20], want[20];
+    int            status[N];
+
+    for (size_t i = 0; i < V; ++i) {
+        lens[i] = strlen(vectors[i].raw) / 2;
+        unhex(vectors[i].raw, bufs[i], lens[i]);
+        raw[i] = bufs[i];
+    }
+
+    assert(web3c_recover_senders(&ctx, raw, lens, V, senders, status) == 0);
+    for (size_t i = 0; i < V; ++i) {
+        unhex(vectors[i].sender, want, 20);
+        assert(status[i] == 0);
+        assert(memcmp(senders[i], want, 20) == 0);
+    }
+
+    /* Trailing byte, truncation, and s replaced by n - s (EIP-2). */
+    memcpy(bufs[V], bufs[1], lens[1]);
+    bufs[V][lens[1]] = 0x00;
+    lens[V] = lens[1] + 1;
+    raw[V]  = bufs[V];
+
+    memcpy(bufs[V + 1], bufs[3], lens[3]);
+    lens[V + 1] = lens[3] - 1;
+    raw[V + 1]  = bufs[V + 1];
+
+    {
+        uint8_t n[32], *s = bufs[V + 2] + lens[1] - 32;
+        unsigned borrow = 0;
+
+        unhex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", n, 32);
+        memcpy(bufs[V + 2], bufs[1], lens[1]);
+        for (int i = 31; i >= 0; --i) {
+            unsigned d = (unsigned)n[i] - s[i] - borrow;
+
+            borrow = d >> 8 & 1;
+            s[i]   = (uint8_t)d;
+        }
+        lens[V + 2] = lens[1];
+        raw[V + 2]  = bufs[V + 2];
+    }
+
+    assert(web3c_recover_senders(&ctx, raw, lens, N, senders, status) != 0);
+    for (size_t i = 0; i < N; ++i) {
+        assert((status[i] == 0) == (i < V));
+    }
+
+    assert(web3c_recover_senders(&ctx, raw, lens, 0, senders, status) == 0);
+    assert(web3c_recover_senders(NULL, raw, lens, V, senders, status) != 0);
+}
+
+int main(void) {
+    printf("Running Web3C secp256k1 tests...\n");
+
+    web3c_secp256k1_ctx_init(&ctx);
+
+    test_secp256k1_seckey_verify();
+    test_secp256k1_pubkey();
+    test_secp256k1_sign();
+    test_secp256k1_tx_legacy();
+    test_secp256k1_tx_1559();
+    test_secp256k1_recover();
+    test_secp256k1_recover_batch();
+    test_recover_senders();
+
+    printf("All secp256k1 tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "web3c/web3c.h"
+
+static void expect_hex(const uint8_t got[32], const char *hex) {
+    uint8_t expected[32];
+
+    assert(web3c_hex_decode(hex, expected, 32) == 32);
+    assert(memcmp(got, expected, 32) == 0);
+}
+
+static void test_single(void) {
+    uint8_t addr[20];
+    uint8_t spender[20];
+    uint8_t slot[32];
+    uint8_t key[32];
+    uint8_t out[32];
+    uint8_t chain[2][32];
+
+    assert(web3c_hex_decode("d8da6bf26964af9d7eed9e03e53415d37aa96045", addr, 20) == 20);
+    assert(web3c_hex_decode("7a250d5630b4cf539739df2c5dac4b659f2488d0", spender, 20) == 20);
+
+    /* balances[addr] with balances at slot 0. */
+    assert(web3c_abi_encode_uint256(0, slot) == 0);
+    assert(web3c_storage_mapping_slot_address(addr, slot, out) == 0);
+    expect_hex(out, "fca351f4d96129454cfc8ef7930b638ac71fea35eb69ee3b8d959496beb04a33");
+
+    /* Same slot through the generic word form. */
+    assert(web3c_abi_encode_address(addr, key) == 0);
+    assert(web3c_storage_mapping_slot(key, slot, out) == 0);
+    expect_hex(out, "fca351f4d96129454cfc8ef7930b638ac71fea35eb69ee3b8d959496beb04a33");
+
+    /* mapping(uint256 => ...) at slot 3, key 7. */
+    assert(web3c_abi_encode_uint256(7, key) == 0);
+    assert(web3c_abi_encode_uint256(3, slot) == 0);
+    assert(web3c_storage_mapping_slot(key, slot, out) == 0);
+    expect_hex(out, "f2c49132ed1cee2a7e75bde50d332a2f81f1d01e5456d8a19d1df09bd561dbd2");
+
+    /* allowances[addr][spender] with allowances at slot 1. */
+    assert(web3c_abi_encode_address(addr, chain[0]) == 0);
+    assert(web3c_abi_encode_address(spender, chain[1]) == 0);
+    assert(web3c_abi_encode_uint256(1, slot) == 0);
+    assert(web3c_storage_nested_slot((const uint8_t (*)[32])chain, 2, slot, out) == 0);
+    expect_hex(out, "ef3a7da0bea6aaea44bacdbab2fe4244a318978b540138bfe597a64fb1536ad8");
+
+    /* Dynamic array at slot 2: keccak256(2) + i, including a carry. */
+    assert(web3c_abi_encode_uint256(2, slot) == 0);
+    assert(web3c_storage_array_slot(slot, 0, out) == 0);
+    expect_hex(out, "405787fa12a823e0f2b7631cc41b3ba8828b3321ca811111fa75cd3aa3bb5ace");
+    assert(web3c_storage_array_slot(slot, 5, out) == 0);
+    expect_hex(out, "405787fa12a823e0f2b7631cc41b3ba8828b3321ca811111fa75cd3aa3bb5ad3");
+    assert(web3c_storage_array_slot(slot, 0x32, out) == 0);
+    expect_hex(out, "405787fa12a823e0f2b7631cc41b3ba8828b3321ca811111fa75cd3aa3bb5b00");
+
+    assert(web3c_storage_mapping_slot(NULL, slot, out) != 0);
+    assert(web3c_storage_nested_slot((const uint8_t (*)[32])chain, 0, slot, out) != 0);
+}
+
+static void test_batch(void) {
+    enum { N = 150, DEPTH = 3 };
+    static uint8_t addrs[N][20];
+    static uint8_t keys[N][32];
+    static uint8_t chains[N * DEPTH][32];
+    static uint8_t outs[N][32];
+    uint8_t slot[32];
+    uint8_t one[32];
+
+    assert(web3c_abi_encode_uint256(9, slot) == 0);
+
+    for (size_t i = 0; i < N; ++i) {
+        memset(addrs[i], (int)(i + 1), 20);
+        assert(web3c_abi_encode_uint256(i * 1000003u, keys[i]) == 0);
+        for (size_t d = 0; d < DEPTH; ++d) {
+            assert(web3c_abi_encode_uint256(i * DEPTH + d, chains[i * DEPTH + d]) == 0);
+        }
+    }
+
+    assert(web3c_storage_mapping_slots_address((const uint8_t (*)[20])addrs, N,
+                                               slot, outs) == 0);
+    for (size_t i = 0; i < N; ++i) {
+        assert(web3c_storage_mapping_slot_address(addrs[i], slot, one) == 0);
+        assert(memcmp(outs[i], one, 32) == 0);
+    }
+
+    assert(web3c_storage_mapping_slots((const uint8_t (*)[32])keys, N, slot, outs) == 0);
+    for (size_t i = 0; i < N; ++i) {
+        assert(web3c_storage_mapping_slot(keys[i], slot, one) == 0);
+        assert(memcmp(outs[i], one, 32) == 0);
+    }
+
+    assert(web3c_storage_nested_slots((const uint8_t (*)[32])chains, DEPTH, N,
+                                      slot, outs) == 0);
+    for (size_t i = 0; i < N; ++i) {
+        /* Reference: apply the mapping rule key by key. */
+        memcpy(one, slot, 32);
+        for (size_t d = 0; d < DEPTH; ++d) {
+            assert(web3c_storage_mapping_slot(chains[i * DEPTH + d], one, one) == 0);
+        }
+        assert(memcmp(outs[i], one, 32) == 0);
+    }
+
+    assert(web3c_storage_array_slots(slot, 250, N, outs) == 0);
+    for (size_t i = 0; i < N; ++i) {
+        assert(web3c_storage_array_slot(slot, 250 + i, one) == 0);
+        assert(memcmp(outs[i], one, 32) == 0);
+    }
+
+    assert(web3c_storage_mapping_slots(NULL, 0, slot, NULL) == 0);
+    assert(web3c_storage_mapping_slots(NULL, 1, slot, outs) != 0);
+}
+
+int main(void) {
+    printf("Running Web3C storage tests...\n");
+
+    test_single();
+    test_batch();
+
+    printf("All storage tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "web3c/web3c.h"
+
+#define MAX_ITEMS 300
+
+static uint8_t        item_buf[MAX_ITEMS][300];
+static uint8_t        big_item[20000];
+static const uint8_t *items[MAX_ITEMS];
+static size_t         lens[MAX_ITEMS];
+
+/*
+ * Deterministic items:
+ *   std   - item i is (i * 37) % 300 bytes of (k * 7 + i)
+ *   small - single bytes and empty items, so leaves get embedded
+ *   big   - std, but item 1 is too large for the builder's arena
+ */
+static void make_items(size_t n, const char *mode) {
+    for (size_t i = 0; i < n; ++i) {
+        items[i] = item_buf[i];
+        if (strcmp(mode, "small") == 0) {
+            item_buf[i][0] = (uint8_t)(i % 0x80);
+            lens[i] = (i % 3) ? 1 : 0;
+            continue;
+        }
+        lens[i] = (i * 37) % 300;
+        for (size_t k = 0; k < lens[i]; ++k) {
+            item_buf[i][k] = (uint8_t)(k * 7 + i);
+        }
+    }
+
+    if (strcmp(mode, "big") == 0) {
+        for (size_t k = 0; k < sizeof(big_item); ++k) {
+            big_item[k] = (uint8_t)(k * 13 + 5);
+        }
+        items[1] = big_item;
+        lens[1]  = sizeof(big_item);
+    }
+}
+
+static void test_vectors(void) {
+    /* Roots computed with an independent naive MPT implementation. */
+    static const struct {
+        size_t      n;
+        const char *mode;
+        const char *root;
+    } vectors[] = {
+        { 1,   "std",   "1e03594df303045ca22e7d8f7ff4504ea2a9e1168864bf7b16ec37b79d9e2671" },
+        { 2,   "std",   "1e846fe0dfe0ffe14b304e2244077a57a6bd66f10861415206e8ff9331bd76cc" },
+        { 3,   "std",   "9957b741105d746e41fc456b76cdb3d671ff586d4f6f0343a1229d16129be3db" },
+        { 16,  "std",   "a90f9041ceb7b5598e95524a25ef0f0ae2754fa6a5cee6d1bc5379385116f694" },
+        { 17,  "small", "f6d1d5b70d8942c24405c2a6649c2069cbb9853ed0c79e82cc97da6b4157874a" },
+        { 127, "std",   "27af4483047c9f80dc7225f4aee9598a814ef013af63981faa1b1b508ef1fa0e" },
+        { 128, "std",   "eca4d5aff7dc0cb66d65e58b6cb1baf7961ab1fc4ef67131889f05cbfbff846b" },
+        { 129, "std",   "238ae95f4eb888e1bf8a1ebf9ffba597b5c7e6585efe46b83e021dc8e1b99d0e" },
+        { 300, "std",   "2717215f5f45916d0ae6117a8906c56b30bda2e7b4b55edbd14eda9a2490a549" },
+        { 5,   "big",   "9336ddca60b544ade350fefddce3be1b4fd32a48e69b617d81775910d929cb48" },
+    };
+    uint8_t root[32];
+    uint8_t expected[32];
+
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); ++v) {
+        make_items(vectors[v].n, vectors[v].mode);
+        assert(web3c_hex_decode(vectors[v].root, expected, 32) == 32);
+        assert(web3c_trie_ordered_root(items, lens, vectors[v].n, root) == 0);
+        if (memcmp(root, expected, 32) != 0) {
+            fprintf(stderr, "ordered root mismatch (n = %zu, %s)\n",
+                    vectors[v].n, vectors[v].mode);
+            assert(0);
+        }
+    }
+}
+
+static void test_empty_and_errors(void) {
+    uint8_t root[32];
+    uint8_t expected[32];
+
+    assert(web3c_hex_decode("56e81f171bcc55a6ff8345e692c0f86e"
+                            "5b48e01b996cadc001622fb5e363b421", expected, 32) == 32);
+    assert(memcmp(web3c_trie_empty_root, expected, 32) == 0);
+
+    assert(web3c_trie_ordered_root(NULL, NULL, 0, root) == 0);
+    assert(memcmp(root, expected, 32) == 0);
+
+    assert(web3c_trie_ordered_root(NULL, lens, 1, root) != 0);
+    assert(web3c_trie_ordered_root(items, lens, 1, NULL) != 0);
+
+    make_items(4, "std");
+    items[2] = NULL;
+    assert(web3c_trie_ordered_root(items, lens, 4, root) != 0);
+}
+
+int main(void) {
+    printf("Running Web3C trie tests...\n");
+
+    test_vectors();
+    test_empty_and_errors();
+
+    printf("All trie tests passed.\n");
+    return 0;
+}
@@ -81,6 +81,437 @@ static void test_tx_validate(void) {
     assert(web3c_tx_legacy_validate(&tx) != 0);
 }
 
+/* Reference: encode each field with the generic RLP encoders. */
+static size_t ref_legacy_encode(const web3c_tx_legacy *tx, uint8_t *out) {
+    static uint8_t payload[1 << 17];
+    size_t off = 0, n = 0, hdr = 0;
+
+    assert(web3c_rlp_encode_uint64(tx->nonce, payload + off, sizeof(payload) - off, &n) == 0);
+    off += n;
+    assert(web3c_rlp_encode_uint64(tx->gas_price, payload + off, sizeof(payload) - off, &n) == 0);
+    off += n;
+    assert(web3c_rlp_encode_uint64(tx->gas_limit, payload + off, sizeof(payload) - off, &n) == 0);
+    off += n;
+    assert(web3c_rlp_encode_bytes(tx->has_to ? tx->to : NULL, tx->has_to ? 20 : 0,
+                                  payload + off, sizeof(payload) - off, &n) == 0);
+    off += n;
+    assert(web3c_rlp_encode_uint64(tx->value, payload + off, sizeof(payload) - off, &n) == 0);
+    off += n;
+    assert(web3c_rlp_encode_bytes(tx->data, tx->data_len,
+                                  payload + off, sizeof(payload) - off, &n) == 0);
+    off += n;
+    assert(web3c_rlp_encode_uint64(tx->chain_id, payload + off, sizeof(payload) - off, &n) == 0);
+    off += n;
+    payload[off++] = 0x80;
+    payload[off++] = 0x80;
+
+    assert(web3c_rlp_encode_list_header(off, out, 16, &hdr) == 0);
+    memcpy(out + hdr, payload, off);
+    return hdr + off;
+}
+
+static void test_tx_rlp_eip155_vector(void) {
+    /* Signing preimage of the EIP-155 example transaction. */
+    static const uint8_t expected[] = {
+        0xec, 0x09, 0x85, 0x04, 0xa8, 0x17, 0xc8, 0x00, 0x82, 0x52, 0x08, 0x94,
+        0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35,
+        0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x88, 0x0d, 0xe0, 0xb6,
+        0xb3, 0xa7, 0x64, 0x00, 0x00, 0x80, 0x01, 0x80, 0x80
+    };
+    web3c_tx_legacy tx;
+    uint8_t to[20];
+    uint8_t buf[64];
+    size_t size = 0, len = 0;
+
+    memset(to, 0x35, sizeof(to));
+    web3c_tx_legacy_init(&tx);
+    tx.nonce     = 9;
+    tx.gas_price = 20000000000ull;
+    tx.gas_limit = 21000;
+    tx.value     = 1000000000000000000ull;
+    tx.chain_id  = 1;
+    assert(web3c_tx_legacy_set_to(&tx, to) == 0);
+
+    assert(web3c_tx_legacy_rlp_size(&tx, &size) == 0);
+    assert(size == sizeof(expected));
+    assert(web3c_tx_legacy_rlp_encode(&tx, buf, sizeof(buf), &len) == 0);
+    assert(len == sizeof(expected));
+    assert(memcmp(buf, expected, len) == 0);
+
+    /* Exact-size buffer works, one byte less does not. */
+    assert(web3c_tx_legacy_rlp_encode(&tx, buf, size, &len) == 0);
+    assert(web3c_tx_legacy_rlp_encode(&tx, buf, size - 1, &len) != 0);
+}
+
+/* The scatter/gather encoding concatenates and hashes to the flat one. */
+static void check_iov(const web3c_tx_legacy *tx, const uint8_t *flat, size_t flat_len) {
+    uint8_t scratch[WEB3C_TX_IOV_SCRATCH];
+    web3c_rlp_iovec iov[WEB3C_TX_IOV_MAX];
+    size_t count = 0, total = 0, off = 0;
+    uint8_t h1[32], h2[32];
+    web3c_keccak_ctx ctx;
+
+    assert(web3c_tx_legacy_rlp_encode_iov(tx, scratch, iov, &count, &total) == 0);
+    assert(total == flat_len);
+    assert(count == (tx->data_len > WEB3C_TX_IOV_INLINE ? 3u : 1u));
+
+    web3c_keccak256_init(&ctx);
+    for (size_t i = 0; i < count; ++i) {
+        assert(off + iov[i].len <= flat_len);
+        assert(memcmp(iov[i].base, flat + off, iov[i].len) == 0);
+        web3c_keccak_update(&ctx, iov[i].base, iov[i].len);
+        off += iov[i].len;
+    }
+    assert(off == flat_len);
+
+    /* Large calldata is referenced, not copied. */
+    if (count == 3) {
+        assert(iov[1].base == tx->data);
+    }
+
+    web3c_keccak_final(&ctx, h1);
+    assert(web3c_keccak256(flat, flat_len, h2) == 0);
+    assert(memcmp(h1, h2, 32) == 0);
+}
+
+static void test_tx_rlp_matches_reference(void) {
+    static uint8_t data[70000];
+    static uint8_t buf[sizeof(data) + 256];
+    static uint8_t ref[sizeof(data) + 256];
+    static const size_t data_lens[] = { 0, 1, 2, 32, 33, 55, 56, 200, 255, 256, 65535, 65536, 70000 };
+    static const uint64_t values[] = {
+        0, 1, 0x7f, 0x80, 0xff, 0x100, 0xffff, 0x10000, 0xffffffffull, UINT64_MAX
+    };
+    web3c_tx_legacy tx;
+    uint8_t to[20];
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+    memset(to, 0xaa, sizeof(to));
+
+    for (size_t d = 0; d < sizeof(data_lens) / sizeof(data_lens[0]); ++d) {
+        for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); ++v) {
+            for (int has_to = 0; has_to <= 1; ++has_to) {
+                size_t size = 0, len = 0;
+
+                web3c_tx_legacy_init(&tx);
+                tx.nonce     = values[v];
+                tx.gas_price = values[(v + 3) % 10];
+                tx.gas_limit = values[(v + 5) % 10] | 1;
+                tx.value     = values[(v + 7) % 10];
+                tx.chain_id  = values[(v + 1) % 10] | 1;
+                if (has_to) {
+                    assert(web3c_tx_legacy_set_to(&tx, to) == 0);
+                }
+                assert(web3c_tx_legacy_set_data(&tx, data, data_lens[d]) == 0);
+                /* One-byte data below 0x80 is its own encoding. */
+                if (data_lens[d] == 1) {
+                    data[0] = (uint8_t)(v * 29);
+                }
+
+                size_t ref_len = ref_legacy_encode(&tx, ref);
+                assert(web3c_tx_legacy_rlp_size(&tx, &size) == 0);
+                assert(size == ref_len);
+                assert(web3c_tx_legacy_rlp_encode(&tx, buf, sizeof(buf), &len) == 0);
+                assert(len == ref_len);
+                assert(memcmp(buf, ref, len) == 0);
+
+                check_iov(&tx, ref, ref_len);
+            }
+        }
+    }
+
+    /* Invalid tx: no chain id. */
+    web3c_tx_legacy_init(&tx);
+    tx.gas_limit = 21000;
+    assert(web3c_tx_legacy_rlp_encode(&tx, buf, sizeof(buf), NULL) != 0);
+}
+
+static size_t unhex(const char *hex, uint8_t *out, size_t out_size) {
+    int n = web3c_hex_decode_n(hex, strlen(hex), out, out_size, NULL);
+    assert(n >= 0);
+    return (size_t)n;
+}
+
+/* Vectors from an independent Python implementation (RLP, Keccak, RFC 6979). */
+static void test_tx_1559_vectors(void) {
+    uint8_t expected[512], buf[512], hash[32], want[32], r[32], s[32];
+    uint8_t to[20], data[100], al[128];
+    size_t n, size = 0, len = 0;
+    web3c_tx_1559 tx;
+
+    /* Plain transfer of 1.5 ETH, empty access list. */
+    web3c_tx_1559_init(&tx);
+    tx.chain_id                 = 1;
+    tx.nonce                    = 7;
+    tx.max_priority_fee_per_gas = 2000000000ull;
+    tx.max_fee_per_gas          = 100000000000ull;
+    tx.gas_limit                = 21000;
+    memset(to, 0x35, sizeof(to));
+    assert(web3c_tx_1559_set_to(&tx, to) == 0);
+    unhex("14d1120d7b160000", tx.value + 24, 8);
+
+    n = unhex("02f00107847735940085174876e800825208943535353535353535353535353535"
+              "3535353535358814d1120d7b16000080c0", expected, sizeof(expected));
+    assert(web3c_tx_1559_rlp_size(&tx, &size) == 0 && size == n);
+    assert(web3c_tx_1559_rlp_encode(&tx, buf, sizeof(buf), &len) == 0);
+    assert(len == n && memcmp(buf, expected, n) == 0);
+    assert(web3c_tx_1559_rlp_encode(&tx, buf, n - 1, &len) != 0);
+
+    unhex("384e23dde1b844b93dcf3f6df77cbc80a04f503df84c032a3f8b8c053b9b6ff7", want, 32);
+    assert(web3c_tx_1559_signing_hash(&tx, hash) == 0);
+    assert(memcmp(hash, want, 32) == 0);
+
+    unhex("ea70b93b2f912190a1ee3a09ddff79f401ee5c2e44fbd42d9211df59e96dca4b", r, 32);
+    unhex("41ef5605132c1cf0155a06e515d03ba6f3cfccaeed39112d51a39f66a9986665", s, 32);
+    n = unhex("02f8730107847735940085174876e8008252089435353535353535353535353535"
+              "353535353535358814d1120d7b16000080c001a0ea70b93b2f912190a1ee3a09dd"
+              "ff79f401ee5c2e44fbd42d9211df59e96dca4ba041ef5605132c1cf0155a06e515"
+              "d03ba6f3cfccaeed39112d51a39f66a9986665", expected, sizeof(expected));
+    assert(web3c_tx_1559_signed_rlp_size(&tx, r, s, &size) == 0 && size == n);
+    assert(web3c_tx_1559_signed_rlp_encode(&tx, 1, r, s, buf, sizeof(buf), &len) == 0);
+    assert(len == n && memcmp(buf, expected, n) == 0);
+    assert(web3c_tx_1559_signed_rlp_encode(&tx, 1, r, s, buf, n - 1, &len) != 0);
+    assert(web3c_tx_1559_signed_rlp_encode(&tx, 2, r, s, buf, sizeof(buf), &len) != 0);
+
+    /* Contract call: 100 bytes of data, 100 ETH, one access list entry. */
+    web3c_tx_1559_init(&tx);
+    tx.chain_id                 = 5;
+    tx.max_priority_fee_per_gas = 1000000000ull;
+    tx.max_fee_per_gas          = 30000000000ull;
+    tx.gas_limit                = 200000;
+    memset(to, 0xaa, sizeof(to));
+    assert(web3c_tx_1559_set_to(&tx, to) == 0);
+    unhex("056bc75e2d63100000", tx.value + 23, 9);
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)i;
+    }
+    assert(web3c_tx_1559_set_data(&tx, data, sizeof(data)) == 0);
+    n = unhex("f85bf859941111111111111111111111111111111111111111f842a000000000000000"
+              "00000000000000000000000000000000000000000000000000a02222222222222222"
+              "222222222222222222222222222222222222222222222222", al, sizeof(al));
+    assert(web3c_tx_1559_set_access_list(&tx, al, n) == 0);
+
+    unhex("4ed697cad984ab364ca2c72fbe55fae11a4597292d10887db1a232524394840d", want, 32);
+    assert(web3c_tx_1559_signing_hash(&tx, hash) == 0);
+    assert(memcmp(hash, want, 32) == 0);
+    assert(web3c_tx_1559_rlp_encode(&tx, buf, sizeof(buf), &len) == 0);
+    assert(len == 1 + 2 + 0xf3);
+    assert(web3c_keccak256(buf, len, hash) == 0);
+    assert(memcmp(hash, want, 32) == 0);
+
+    unhex("898eb2ef549f895e13bc66a0502689d79e00e225fb9ff97f86a0666b2ae32c98", r, 32);
+    unhex("7bc4ae2534eb0366102c31fa915dbc3b2d845844a2c948273c75fc2a3fdf675d", s, 32);
+    assert(web3c_tx_1559_signed_rlp_encode(&tx, 1, r, s, buf, sizeof(buf), &len) == 0);
+    assert(len == 1 + 3 + 0x136);
+    assert(memcmp(buf, "\x02\xf9\x01\x36", 4) == 0);
+    assert(memcmp(buf + len - 67, "\x01\xa0", 2) == 0);
+    assert(memcmp(buf + len - 65, r, 32) == 0 && buf[len - 33] == 0xa0);
+    assert(memcmp(buf + len - 32, s, 32) == 0);
+}
+
+/* The streamed signing hash equals keccak256 of the encoded envelope. */
+static void test_tx_1559_hash_matches_encode(void) {
+    static uint8_t data[70000];
+    static uint8_t buf[sizeof(data) + 512];
+    static const size_t data_lens[] = { 0, 1, 31, 32, 33, 55, 56, 1000, 70000 };
+    static const uint8_t al[] = { 0xc1, 0xc0 };
+    web3c_tx_1559 tx;
+    uint8_t to[20], h1[32], h2[32];
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 13 + 1);
+    }
+    memset(to, 0x42, sizeof(to));
+
+    for (size_t d = 0; d < sizeof(data_lens) / sizeof(data_lens[0]); ++d) {
+        for (int variant = 0; variant < 4; ++variant) {
+            size_t len = 0;
+
+            web3c_tx_1559_init(&tx);
+            tx.chain_id                 = 137;
+            tx.nonce                    = (uint64_t)d << (variant * 16);
+            tx.max_priority_fee_per_gas = variant;
+            tx.max_fee_per_gas          = UINT64_MAX >> variant;
+            tx.gas_limit                = 1000000;
+            tx.value[31 - variant * 8]  = 0x80;
+            if (variant & 1) {
+                assert(web3c_tx_1559_set_to(&tx, to) == 0);
+            }
+            if (variant & 2) {
+                assert(web3c_tx_1559_set_access_list(&tx, al, sizeof(al)) == 0);
+            }
+            assert(web3c_tx_1559_set_data(&tx, data, data_lens[d]) == 0);
+
+            assert(web3c_tx_1559_rlp_encode(&tx, buf, sizeof(buf), &len) == 0);
+            assert(web3c_rlp_validate(buf + 1, len - 1, 4, NULL) == 0);
+            assert(web3c_keccak256(buf, len, h1) == 0);
+            assert(web3c_tx_1559_signing_hash(&tx, h2) == 0);
+            assert(memcmp(h1, h2, 32) == 0);
+        }
+    }
+}
+
+static void test_tx_1559_invalid(void) {
+    static const uint8_t not_list[] = { 0x80 };
+    static const uint8_t trailing[] = { 0xc0, 0xc0 };
+    static const uint8_t short_list[] = { 0xc2, 0xc0 };
+    uint8_t buf[256], hash[32];
+    web3c_tx_1559 tx;
+
+    web3c_tx_1559_init(&tx);
+    tx.gas_limit = 21000;
+    assert(web3c_tx_1559_validate(&tx) != 0);           /* no chain id */
+    tx.chain_id = 1;
+    assert(web3c_tx_1559_validate(&tx) == 0);
+    tx.max_priority_fee_per_gas = 2;
+    tx.max_fee_per_gas          = 1;
+    assert(web3c_tx_1559_validate(&tx) != 0);           /* tip above cap */
+    assert(web3c_tx_1559_signing_hash(&tx, hash) != 0);
+    assert(web3c_tx_1559_rlp_encode(&tx, buf, sizeof(buf), NULL) != 0);
+    tx.max_fee_per_gas = 2;
+
+    assert(web3c_tx_1559_set_data(&tx, NULL, 1) != 0);
+    assert(web3c_tx_1559_set_access_list(&tx, not_list, sizeof(not_list)) != 0);
+    assert(web3c_tx_1559_set_access_list(&tx, trailing, sizeof(trailing)) != 0);
+    assert(web3c_tx_1559_set_access_list(&tx, short_list, sizeof(short_list)) != 0);
+    assert(web3c_tx_1559_set_access_list(&tx, NULL, 0) == 0);
+    assert(web3c_tx_1559_signing_hash(&tx, hash) == 0);
+    assert(web3c_tx_1559_signing_hash(NULL, hash) != 0);
+}
+
+/* Reference: the same list through the generic RLP builder. */
+static size_t ref_access_list(const web3c_access_list *al, uint8_t *out, size_t size) {
+    web3c_rlp_builder b;
+    size_t len = 0, next = 0;
+
+    web3c_rlp_builder_init(&b, out, size);
+    web3c_rlp_builder_begin_list(&b);
+    for (size_t i = 0; i < al->n_addresses; ++i) {
+        size_t first = al->key_offsets ? al->key_offsets[i] : next;
+
+        web3c_rlp_builder_begin_list(&b);
+        web3c_rlp_builder_append_bytes(&b, al->addresses[i], 20);
+        web3c_rlp_builder_begin_list(&b);
+        for (size_t k = 0; k < al->key_counts[i]; ++k) {
+            web3c_rlp_builder_append_bytes(&b, al->keys[first + k], 32);
+        }
+        web3c_rlp_builder_end_list(&b);
+        web3c_rlp_builder_end_list(&b);
+        next = first + al->key_counts[i];
+    }
+    web3c_rlp_builder_end_list(&b);
+    assert(web3c_rlp_builder_finish(&b, &len) == 0);
+    return len;
+}
+
+static void test_access_list(void) {
+    static uint8_t addrs[40][20];
+    static uint8_t keys[600][32];
+    static uint8_t buf[32768], ref[65536];
+    size_t counts[40], offsets[40];
+    size_t size = 0, len = 0;
+    web3c_access_list al;
+
+    for (size_t i = 0; i < 40; ++i) {
+        memset(addrs[i], (int)(i + 1), 20);
+    }
+    for (size_t k = 0; k < 600; ++k) {
+        memset(keys[k], (int)(k * 7), 32);
+        keys[k][31] = (uint8_t)k;
+    }
+
+    /* The vector used by test_tx_1559_vectors(). */
+    {
+        uint8_t expected[128];
+        size_t  n = unhex("f85bf859941111111111111111111111111111111111111111f842a0000000"
+                          "0000000000000000000000000000000000000000000000000000000000a022"
+                          "22222222222222222222222222222222222222222222222222222222222222",
+                          expected, sizeof(expected));
+        uint8_t one_addr[1][20], two_keys[2][32];
+        size_t  two = 2;
+
+        memset(one_addr, 0x11, sizeof(one_addr));
+        memset(two_keys[0], 0x00, 32);
+        memset(two_keys[1], 0x22, 32);
+        memset(&al, 0, sizeof(al));
+        al.addresses   = (const uint8_t (*)[20])one_addr;
+        al.key_counts  = &two;
+        al.n_addresses = 1;
+        al.keys        = (const uint8_t (*)[32])two_keys;
+        al.n_keys      = 2;
+
+        assert(web3c_access_list_rlp_size(&al, &size) == 0 && size == n);
+        assert(web3c_access_list_rlp_encode(&al, buf, sizeof(buf), &len) == 0);
+        assert(len == n && memcmp(buf, expected, n) == 0);
+        assert(web3c_access_list_rlp_encode(&al, buf, n - 1, &len) != 0);
+    }
+
+    /* Empty list, and addresses without keys. */
+    memset(&al, 0, sizeof(al));
+    assert(web3c_access_list_rlp_encode(&al, buf, sizeof(buf), &len) == 0);
+    assert(len == 1 && buf[0] == 0xc0);
+
+    /* Consecutive keys (no offsets), counts crossing the 55-byte and
+     * 256-byte list header boundaries. */
+    al.addresses   = (const uint8_t (*)[20])addrs;
+    al.key_counts  = counts;
+    al.keys        = (const uint8_t (*)[32])keys;
+    al.n_keys      = 600;
+    for (size_t n = 0; n <= 40; n += 8) {
+        size_t used = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            counts[i] = (i * 5) % 11;
+            used += counts[i];
+        }
+        counts[n > 0 ? n - 1 : 0] = n > 0 ? 600 - (used - counts[n - 1]) : 0;
+        al.n_addresses = n;
+
+        size_t ref_len = ref_access_list(&al, ref, sizeof(ref));
+        assert(web3c_access_list_rlp_size(&al, &size) == 0 && size == ref_len);
+        assert(web3c_access_list_rlp_encode(&al, buf, sizeof(buf), &len) == 0);
+        assert(len == ref_len && memcmp(buf, ref, len) == 0);
+    }
+
+    /* Explicit offsets, in any order and sharing keys. */
+    for (size_t i = 0; i < 40; ++i) {
+        offsets[i] = (i * 97) % 590;
+        counts[i]  = i % 11;
+    }
+    al.key_offsets = offsets;
+    al.n_addresses = 40;
+    {
+        size_t ref_len = ref_access_list(&al, ref, sizeof(ref));
+        assert(web3c_access_list_rlp_encode(&al, buf, sizeof(buf), &len) == 0);
+        assert(len == ref_len && memcmp(buf, ref, len) == 0);
+
+        /* Feeds web3c_tx_1559_set_access_list(). */
+        web3c_tx_1559 tx;
+        web3c_tx_1559_init(&tx);
+        assert(web3c_tx_1559_set_access_list(&tx, buf, len) == 0);
+    }
+
+    /* Key ranges outside keys[]. */
+    offsets[3] = 595;
+    counts[3]  = 6;
+    assert(web3c_access_list_rlp_size(&al, &size) != 0);
+    counts[3]  = 5;
+    assert(web3c_access_list_rlp_size(&al, &size) == 0);
+    offsets[3] = 601;
+    counts[3]  = 0;
+    assert(web3c_access_list_rlp_size(&al, &size) != 0);
+    offsets[3] = 0;
+    al.key_offsets = NULL;
+    counts[0] = 601;
+    assert(web3c_access_list_rlp_encode(&al, buf, sizeof(buf), &len) != 0);
+    al.keys = NULL;
+    counts[0] = 0;
+    assert(web3c_access_list_rlp_size(&al, &size) != 0);
+    assert(web3c_access_list_rlp_size(NULL, &size) != 0);
+}
+
 int main(void) {
     printf("Running Web3C tx tests...\n");
 
@@ -88,6 +519,12 @@ int main(void) {
     test_tx_set_to();
     test_tx_set_data();
     test_tx_validate();
+    test_tx_rlp_eip155_vector();
+    test_tx_rlp_matches_reference();
+    test_tx_1559_vectors();
+    test_tx_1559_hash_matches_encode();
+    test_tx_1559_invalid();
+    test_access_list();
 
     printf("All tx tests passed.\n");
     return 0;